@@ -0,0 +1,129 @@
+#include "BenchmarkInput.hpp"
+
+#include <cassert>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace safec
+{
+
+namespace
+{
+
+// single function touching all constructs the walkers care about:
+// defers in nested scopes, loops, switch-case and early return
+// clang-format off
+constexpr const char *kFunctionTemplate =
+    "typedef int handle_@_t;\n"
+    "\n"
+    "int process_@(int *buf, int len)\n"
+    "{\n"
+    "    handle_@_t h = open_handle(@);\n"
+    "    int table[] = {1, 2, 3, 4, 5, 6, 7, 8};\n"
+    "    int sum = 0;\n"
+    "    int i;\n"
+    "    defer close_handle(h);\n"
+    "\n"
+    "    for (i = 0; i < len; i++)\n"
+    "    {\n"
+    "        defer trace(i);\n"
+    "        sum += buf[i] * table[i % 8];\n"
+    "    }\n"
+    "\n"
+    "    while (sum > 1000)\n"
+    "    {\n"
+    "        sum = sum / 2;\n"
+    "    }\n"
+    "\n"
+    "    switch (sum)\n"
+    "    {\n"
+    "        case 0:\n"
+    "            sum = 1;\n"
+    "            break;\n"
+    "        default:\n"
+    "            break;\n"
+    "    }\n"
+    "\n"
+    "    if (sum < 0)\n"
+    "    {\n"
+    "        return -1;\n"
+    "    }\n"
+    "\n"
+    "    return sum;\n"
+    "}\n"
+    "\n";
+// clang-format on
+
+std::string instantiate(const uint32_t index)
+{
+    const std::string indexStr = std::to_string(index);
+
+    std::string function;
+    for (const char *it = kFunctionTemplate; *it != '\0'; ++it)
+    {
+        if (*it == '@')
+        {
+            function += indexStr;
+        }
+        else
+        {
+            function += *it;
+        }
+    }
+
+    return function;
+}
+
+} // namespace
+
+const BenchmarkInput &BenchmarkInput::get(const uint32_t lines)
+{
+    static std::map<uint32_t, std::unique_ptr<BenchmarkInput>> inputs;
+
+    auto &input = inputs[lines];
+    if (!input)
+    {
+        input.reset(new BenchmarkInput{lines});
+    }
+
+    return *input;
+}
+
+BenchmarkInput::BenchmarkInput(const uint32_t lines)
+    : mPath{}
+    , mLineCount{0}
+    , mByteCount{0}
+{
+    const fs::path dir = fs::temp_directory_path() / "safec_benchmarks";
+    fs::create_directories(dir);
+
+    mPath = dir / ("input_" + std::to_string(lines) + ".sc");
+
+    std::ostringstream content;
+    content << "#include <stdio.h>\n\n";
+    mLineCount = 2;
+
+    // whole functions only, so the input may be slightly above the target
+    for (uint32_t index = 0; mLineCount < lines; index++)
+    {
+        const std::string function = instantiate(index);
+        for (const char c : function)
+        {
+            mLineCount += (c == '\n') ? 1 : 0;
+        }
+
+        content << function;
+    }
+
+    const std::string contentStr = content.str();
+    mByteCount = contentStr.size();
+
+    std::ofstream file{mPath, std::ios::binary | std::ios::trunc};
+    file << contentStr;
+    assert(file.good());
+}
+
+} // namespace safec
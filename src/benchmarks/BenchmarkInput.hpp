@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace safec
+{
+
+namespace fs = ::std::filesystem;
+
+// Synthetic SafeC input of a requested size. The content depends only
+// on the line count, so results stay comparable between runs. Inputs
+// are written once to the temp directory, since both the lexer and the
+// source generator read the source from a file.
+class BenchmarkInput
+{
+public:
+    static const BenchmarkInput &get(const uint32_t lines);
+
+    const fs::path &getPath() const
+    {
+        return mPath;
+    }
+
+    uint32_t getLineCount() const
+    {
+        return mLineCount;
+    }
+
+    size_t getByteCount() const
+    {
+        return mByteCount;
+    }
+
+private:
+    BenchmarkInput(const uint32_t lines);
+
+    fs::path mPath;
+    uint32_t mLineCount;
+    size_t mByteCount;
+};
+
+} // namespace safec
@@ -0,0 +1,322 @@
+#include "BenchmarkInput.hpp"
+#include "generator/Generator.hpp"
+#include "parser/Parser.hpp"
+#include "semantic_nodes/SemNodeFlat.hpp"
+#include "walkers/DeferAnalysis.hpp"
+#include "walkers/SemNodeWalker.hpp"
+#include "walkers/WalkerDeferExecute.hpp"
+#include "walkers/WalkerSourceGen.hpp"
+#include "walkers/WalkerStrategy.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+
+extern "C"
+{
+#include "SafecParser.yacc.hpp"
+}
+
+extern "C"
+{
+    extern FILE *yyin;
+    extern int yylineno;
+    extern int column;
+    extern int lex_current_char;
+
+    int yylex(void);
+    void yyrestart(FILE *inputFile);
+}
+
+using namespace safec;
+
+namespace
+{
+
+// Input sizes in lines, shared by all phases so the results can be
+// put next to each other.
+void inputSizes(benchmark::internal::Benchmark *bench)
+{
+    bench->RangeMultiplier(10)->Range(100, 100000)->Unit(benchmark::kMillisecond);
+}
+
+void setInputCounters(benchmark::State &state, const BenchmarkInput &input)
+{
+    state.SetBytesProcessed(state.iterations() * input.getByteCount());
+    state.counters["lines"] = input.getLineCount();
+    state.counters["lines/s"] = benchmark::Counter( //
+        static_cast<double>(state.iterations()) * input.getLineCount(),
+        benchmark::Counter::kIsRate);
+}
+
+// Drops everything written to std::cout while alive, the transpiler
+// logs are not what is measured. Benchmark reports are printed outside.
+class QuietLog
+{
+public:
+    QuietLog()
+        : mNullBuffer{}
+        , mPrevBuffer{std::cout.rdbuf(&mNullBuffer)}
+    {
+    }
+
+    ~QuietLog()
+    {
+        std::cout.rdbuf(mPrevBuffer);
+    }
+
+private:
+    struct NullBuffer : std::streambuf
+    {
+        int overflow(int c) override
+        {
+            return c;
+        }
+    };
+
+    NullBuffer mNullBuffer;
+    std::streambuf *mPrevBuffer;
+};
+
+class WalkerNoop final : public WalkerStrategy
+{
+public:
+    void peek(SemNode &node, const uint32_t astLevel) override
+    {
+        mNodesVisited++;
+    }
+
+    uint64_t mNodesVisited = 0;
+};
+
+std::unique_ptr<Parser> parseInput(const BenchmarkInput &input)
+{
+    auto parser = std::make_unique<Parser>();
+    parser->parse(input.getPath());
+    return parser;
+}
+
+void BM_Lex(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+
+    for (auto _ : state)
+    {
+        yyin = fopen(input.getPath().c_str(), "r");
+        yyrestart(yyin);
+        yylineno = 1;
+        column = 0;
+        lex_current_char = 0;
+
+        uint32_t tokens = 0;
+        for (int token = yylex(); token != 0; token = yylex())
+        {
+            // the parser takes ownership of these
+            if ((token == IDENTIFIER) || (token == TYPE_NAME) || //
+                (token == CONSTANT) || (token == STRING_LITERAL))
+            {
+                free(yylval.tokenStrValue);
+            }
+
+            tokens++;
+        }
+
+        fclose(yyin);
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    setInputCounters(state, input);
+}
+
+void BM_Parse(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+    QuietLog quiet;
+
+    for (auto _ : state)
+    {
+        auto parser = parseInput(input);
+
+        // AST teardown is not a part of parsing
+        state.PauseTiming();
+        parser.reset();
+        state.ResumeTiming();
+    }
+
+    setInputCounters(state, input);
+}
+
+void BM_WalkNoop(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+    QuietLog quiet;
+
+    auto parser = parseInput(input);
+    auto ast = parser->getAst();
+
+    SemNodeWalker walker;
+    WalkerNoop noop;
+
+    for (auto _ : state)
+    {
+        walker.walk(*ast, noop);
+    }
+
+    setInputCounters(state, input);
+    state.counters["nodes"] = static_cast<double>(noop.mNodesVisited) / state.iterations();
+}
+
+void BM_FlatBuild(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+    QuietLog quiet;
+
+    auto parser = parseInput(input);
+    auto ast = parser->getAst();
+
+    for (auto _ : state)
+    {
+        SemNodeFlat flat{*ast};
+        benchmark::DoNotOptimize(flat.getNodeCount());
+    }
+
+    setInputCounters(state, input);
+}
+
+// position-only pass over the flat AST, compare with BM_WalkNoop
+void BM_FlatScan(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+    QuietLog quiet;
+
+    auto parser = parseInput(input);
+    const SemNodeFlat flat{*parser->getAst()};
+
+    for (auto _ : state)
+    {
+        const auto &semStarts = flat.getSemStarts();
+        const auto &semEnds = flat.getSemEnds();
+
+        uint64_t covered = 0;
+        for (uint32_t i = 0; i < flat.getNodeCount(); i++)
+        {
+            covered += (semEnds[i] - semStarts[i]);
+        }
+        benchmark::DoNotOptimize(covered);
+    }
+
+    setInputCounters(state, input);
+    state.counters["nodes"] = flat.getNodeCount();
+}
+
+void BM_DeferAnalysis(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+    QuietLog quiet;
+
+    auto parser = parseInput(input);
+    auto ast = parser->getAst();
+
+    for (auto _ : state)
+    {
+        DeferAnalysis analysis;
+        analysis.analyze(*ast);
+        benchmark::DoNotOptimize(analysis.getFunctions().data());
+    }
+
+    setInputCounters(state, input);
+}
+
+void BM_DeferCommit(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+    QuietLog quiet;
+
+    for (auto _ : state)
+    {
+        // commit modifies the AST, each iteration needs a fresh one
+        state.PauseTiming();
+        auto parser = parseInput(input);
+        DeferAnalysis analysis;
+        analysis.analyze(*parser->getAst());
+        WalkerDeferExecute deferExec;
+        state.ResumeTiming();
+
+        deferExec.commit(*parser->getAst(), analysis);
+
+        state.PauseTiming();
+        parser.reset();
+        state.ResumeTiming();
+    }
+
+    setInputCounters(state, input);
+}
+
+void BM_SourceGenRanges(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+    const auto outputPath = fs::path{input.getPath()}.replace_extension("c");
+    QuietLog quiet;
+
+    SemNodeWalker walker;
+
+    for (auto _ : state)
+    {
+        // ranges are consumed by the squash, prepare them again from
+        // an AST with defers applied, so there is something to remove
+        state.PauseTiming();
+        auto parser = parseInput(input);
+        auto ast = parser->getAst();
+        DeferAnalysis analysis;
+        analysis.analyze(*ast);
+        WalkerDeferExecute deferExec;
+        deferExec.commit(*ast, analysis);
+
+        auto sourceGen = std::make_unique<WalkerSourceGen>(outputPath);
+        walker.walk(*ast, *sourceGen);
+        state.ResumeTiming();
+
+        sourceGen->prepareRanges();
+
+        state.PauseTiming();
+        sourceGen.reset();
+        parser.reset();
+        state.ResumeTiming();
+    }
+
+    setInputCounters(state, input);
+}
+
+void BM_Transpile(benchmark::State &state)
+{
+    const auto &input = BenchmarkInput::get(state.range(0));
+    const auto outputPath = fs::path{input.getPath()}.replace_extension("c");
+    QuietLog quiet;
+
+    for (auto _ : state)
+    {
+        auto parser = parseInput(input);
+
+        Generator generator;
+        generator.generate(parser->getAst(), outputPath);
+    }
+
+    setInputCounters(state, input);
+}
+
+} // namespace
+
+BENCHMARK(BM_Lex)->Apply(inputSizes);
+BENCHMARK(BM_Parse)->Apply(inputSizes);
+BENCHMARK(BM_WalkNoop)->Apply(inputSizes);
+BENCHMARK(BM_FlatBuild)->Apply(inputSizes);
+BENCHMARK(BM_FlatScan)->Apply(inputSizes);
+BENCHMARK(BM_DeferAnalysis)->Apply(inputSizes);
+BENCHMARK(BM_DeferCommit)->Apply(inputSizes);
+BENCHMARK(BM_SourceGenRanges)->Apply(inputSizes);
+BENCHMARK(BM_Transpile)->Apply(inputSizes);
+
+BENCHMARK_MAIN();
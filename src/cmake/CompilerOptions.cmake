@@ -1,16 +1,86 @@
 set(CMAKE_CXX_COMPILER clang++)
-set(CMAKE_BUILD_TYPE Debug)
 
 set(CMAKE_CXX_STANDARD 17)
 
 set(CMAKE_EXPORT_COMPILE_COMMANDS 1)
 
-set(SANITIZERS_FLAGS -fsanitize=address -fsanitize=undefined)
-# set(SANITIZERS_FLAGS) # use when debugging
+# Build profiles:
+#   sanitize - debug build with ASan/UBSan, used for tests
+#   release  - optimized build with LTO and optional PGO (SAFEC_PGO)
+# Defaults to release for CMAKE_BUILD_TYPE=Release, sanitize otherwise.
+if(CMAKE_BUILD_TYPE STREQUAL "Release")
+    set(SAFEC_DEFAULT_BUILD_PROFILE release)
+else()
+    set(SAFEC_DEFAULT_BUILD_PROFILE sanitize)
+endif()
 
-set(DEBUG_FLAGS -ggdb -O0 ${SANITIZERS_FLAGS})
+set(SAFEC_BUILD_PROFILE ${SAFEC_DEFAULT_BUILD_PROFILE} CACHE STRING "build profile: sanitize or release")
+set_property(CACHE SAFEC_BUILD_PROFILE PROPERTY STRINGS sanitize release)
 
-add_compile_options(-Wall -Wextra -Werror -pedantic ${DEBUG_FLAGS})
+# PGO stage of the release profile:
+#   off      - no PGO
+#   generate - instrumented build, train it with tools/RUN_PGO_TRAINING.sh
+#   use      - optimize with the merged profile from SAFEC_PGO_PROFILE
+set(SAFEC_PGO off CACHE STRING "PGO stage: off, generate or use")
+set_property(CACHE SAFEC_PGO PROPERTY STRINGS off generate use)
+set(SAFEC_PGO_PROFILE ${CMAKE_BINARY_DIR}/safec.profdata CACHE FILEPATH "merged PGO profile for SAFEC_PGO=use")
+
+set(SAFEC_RELEASE_OPT_LEVEL -O2 CACHE STRING "optimization level of the release profile")
+
+# reported with --timings, so perf results are compared only between
+# builds of the same profile
+add_compile_definitions(SAFEC_BUILD_PROFILE_NAME="${SAFEC_BUILD_PROFILE}")
+
+# children stored inline in each SemNode before spilling to the heap
+set(SAFEC_SEMNODE_INLINE_CHILDREN 3 CACHE STRING "inline capacity of the SemNode child lists")
+add_compile_definitions(SAFEC_SEMNODE_INLINE_CHILDREN=${SAFEC_SEMNODE_INLINE_CHILDREN})
+
+add_compile_options(-Wall -Wextra -Werror -pedantic)
 add_compile_options(-Wno-unused-parameter) # for now...
 
-add_link_options(${SANITIZERS_FLAGS})
+if(SAFEC_BUILD_PROFILE STREQUAL "sanitize")
+    set(CMAKE_BUILD_TYPE Debug)
+
+    set(SANITIZERS_FLAGS -fsanitize=address -fsanitize=undefined)
+    # set(SANITIZERS_FLAGS) # use when debugging
+
+    set(DEBUG_FLAGS -ggdb -O0 ${SANITIZERS_FLAGS})
+
+    add_compile_options(${DEBUG_FLAGS})
+    add_link_options(${SANITIZERS_FLAGS})
+elseif(SAFEC_BUILD_PROFILE STREQUAL "release")
+    set(CMAKE_BUILD_TYPE Release)
+
+    set(CMAKE_CXX_FLAGS_RELEASE "${SAFEC_RELEASE_OPT_LEVEL} -DNDEBUG")
+    set(CMAKE_C_FLAGS_RELEASE "${SAFEC_RELEASE_OPT_LEVEL} -DNDEBUG")
+
+    # subdirectories reset policies with cmake_minimum_required(3.8),
+    # the default keeps INTERPROCEDURAL_OPTIMIZATION enforced there too
+    cmake_policy(SET CMP0069 NEW)
+    set(CMAKE_POLICY_DEFAULT_CMP0069 NEW)
+
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT SAFEC_LTO_SUPPORTED OUTPUT SAFEC_LTO_ERROR)
+    if(SAFEC_LTO_SUPPORTED)
+        set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+    else()
+        message(WARNING "LTO not supported, building without it: ${SAFEC_LTO_ERROR}")
+    endif()
+
+    # instrumentation flags are clang specific, the generated lexer is
+    # built by the C compiler which may not be clang
+    if(SAFEC_PGO STREQUAL "generate")
+        add_compile_options($<$<COMPILE_LANGUAGE:CXX>:-fprofile-instr-generate>)
+        add_link_options(-fprofile-instr-generate)
+    elseif(SAFEC_PGO STREQUAL "use")
+        if(NOT EXISTS ${SAFEC_PGO_PROFILE})
+            message(FATAL_ERROR "PGO profile not found: ${SAFEC_PGO_PROFILE}")
+        endif()
+
+        add_compile_options($<$<COMPILE_LANGUAGE:CXX>:-fprofile-instr-use=${SAFEC_PGO_PROFILE}>)
+    elseif(NOT SAFEC_PGO STREQUAL "off")
+        message(FATAL_ERROR "invalid SAFEC_PGO: ${SAFEC_PGO}")
+    endif()
+else()
+    message(FATAL_ERROR "invalid SAFEC_BUILD_PROFILE: ${SAFEC_BUILD_PROFILE}")
+endif()
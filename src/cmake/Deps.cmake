@@ -6,6 +6,12 @@ endif()
 
 include(${CMAKE_BINARY_DIR}/conan.cmake)
 
-conan_cmake_run(REQUIRES boost/1.80.0
+set(SAFEC_CONAN_REQUIRES boost/1.80.0)
+
+if(SAFEC_BUILD_BENCHMARKS)
+    list(APPEND SAFEC_CONAN_REQUIRES benchmark/1.7.1)
+endif()
+
+conan_cmake_run(REQUIRES ${SAFEC_CONAN_REQUIRES}
                 BUILD missing
                 BASIC_SETUP CMAKE_TARGETS)
@@ -1,8 +1,17 @@
 #pragma once
 
+#include <cstdint>
+
 namespace safec
 {
 
+// how the deferred statements are placed in the generated C code
+enum class DeferLowering
+{
+    Inline, // copy of each deferred statement at every scope exit
+    Goto    // single cleanup block per scope, exits jump to it
+};
+
 class Config
 {
 public:
@@ -74,6 +83,76 @@ public:
         return mDisplayAstMod;
     }
 
+    void setDeferLowering(const DeferLowering lowering)
+    {
+        mDeferLowering = lowering;
+    }
+
+    DeferLowering getDeferLowering() const
+    {
+        return mDeferLowering;
+    }
+
+    void setBoundsChecks(const bool checks)
+    {
+        mBoundsChecks = checks;
+    }
+
+    bool getBoundsChecks() const
+    {
+        return mBoundsChecks;
+    }
+
+    void setNullChecks(const bool checks)
+    {
+        mNullChecks = checks;
+    }
+
+    bool getNullChecks() const
+    {
+        return mNullChecks;
+    }
+
+    void setFoldConstants(const bool fold)
+    {
+        mFoldConstants = fold;
+    }
+
+    bool getFoldConstants() const
+    {
+        return mFoldConstants;
+    }
+
+    void setRemoveDeadCode(const bool remove)
+    {
+        mRemoveDeadCode = remove;
+    }
+
+    bool getRemoveDeadCode() const
+    {
+        return mRemoveDeadCode;
+    }
+
+    void setSortCases(const bool sort)
+    {
+        mSortCases = sort;
+    }
+
+    bool getSortCases() const
+    {
+        return mSortCases;
+    }
+
+    void setIntWidth(const uint32_t bits)
+    {
+        mIntWidth = bits;
+    }
+
+    uint32_t getIntWidth() const
+    {
+        return mIntWidth;
+    }
+
 private:
     Config()
         : mDisplayAst{false}
@@ -82,6 +161,13 @@ private:
         , mDisplayCoverage{false}
         , mGenerate{true}
         , mDisplayAstMod{false}
+        , mDeferLowering{DeferLowering::Inline}
+        , mBoundsChecks{false}
+        , mNullChecks{false}
+        , mFoldConstants{false}
+        , mRemoveDeadCode{false}
+        , mSortCases{false}
+        , mIntWidth{32}
     {
     }
 
@@ -91,6 +177,13 @@ private:
     bool mDisplayCoverage;
     bool mGenerate;
     bool mDisplayAstMod;
+    DeferLowering mDeferLowering;
+    bool mBoundsChecks;
+    bool mNullChecks;
+    bool mFoldConstants;
+    bool mRemoveDeadCode;
+    bool mSortCases;
+    uint32_t mIntWidth; // bits of int on the target, for the constant expressions
 };
 
 } // namespace safec
@@ -3,22 +3,186 @@
 #include "config/Config.hpp"
 #include "logger/Logger.hpp"
 #include "parser/Parser.hpp"
+#include "semantic_nodes/SemNodeFlat.hpp"
+#include "utils/Timings.hpp"
+#include "utils/Utils.hpp"
+#include "walkers/DeferAnalysis.hpp"
+#include "walkers/GenericExpansion.hpp"
 #include "walkers/SemNodeWalker.hpp"
+#include "walkers/WalkerBoundsCheck.hpp"
+#include "walkers/WalkerConstantFold.hpp"
+#include "walkers/WalkerDeadCode.hpp"
 #include "walkers/WalkerDeferExecute.hpp"
+#include "walkers/WalkerNullCheck.hpp"
 #include "walkers/WalkerPrint.hpp"
 #include "walkers/WalkerSourceGen.hpp"
+#include "walkers/WalkerStaticAssert.hpp"
+#include "walkers/WalkerSwitchSort.hpp"
+
+#include <fstream>
 
 namespace safec
 {
 
-void Generator::generate( //
+bool Generator::generate( //
     std::shared_ptr<SemNodeTranslationUnit> ast,
     const fs::path &outputFile)
 {
+    // the rest works on the source with the generics expanded, the
+    // parser keeps its AST alive until the file is generated
+    Parser expandedParser;
+    const bool hasGenerics = GenericExpansion::hasGenerics(*ast);
+
+    // the expanded source is removed on the errors as well
+    const auto expandedFile = fs::path{outputFile}.replace_extension("generic.sc");
+    utils::DeferredCall removeExpanded{[hasGenerics, &expandedFile] {
+        if (hasGenerics)
+        {
+            std::error_code error;
+            fs::remove(expandedFile, error);
+        }
+    }};
+
+    if (hasGenerics)
+    {
+        ast = expandGenerics(*ast, outputFile, expandedParser);
+        if (ast == nullptr)
+        {
+            return false;
+        }
+    }
+
+    // before the other passes, a failed assertion stops the generation
+    WalkerStaticAssert staticAssert;
+    {
+        utils::ScopedTiming timing{"static_assert"};
+        if (staticAssert.commit(*ast) == false)
+        {
+            return false;
+        }
+    }
+
+    const auto &staticAssertReport = staticAssert.getReport();
+    if ((staticAssertReport.mProven + staticAssertReport.mUnproven) > 0)
+    {
+        log("Static assertions: % proven, % left to the compiler",
+            staticAssertReport.mProven,
+            staticAssertReport.mUnproven);
+    }
+
+    // before the defer walk, the exits removed here get no cleanup code
+    if (Config::getInstance().getRemoveDeadCode())
+    {
+        WalkerDeadCode deadCode;
+        {
+            utils::ScopedTiming timing{"dead_code"};
+            deadCode.commit(*ast);
+        }
+
+        const auto &report = deadCode.getReport();
+        log("Dead code: % statements removed, % kept after an exit (labels, preprocessor lines)",
+            report.mRemoved,
+            report.mKept);
+
+        for (const auto &it : report.mTails)
+        {
+            log("    line %: % unreachable statements", it.mLine, it.mStatements);
+        }
+    }
+
     // run modifiying walkers here...
-    WalkerDeferExecute deferExec;
-    mWalker.walk(*ast, deferExec);
-    deferExec.commit();
+    DeferAnalysis deferAnalysis;
+    {
+        utils::ScopedTiming timing{"defer_walk"};
+        if (deferAnalysis.analyze(*ast) == false)
+        {
+            return false;
+        }
+    }
+
+    WalkerDeferExecute deferExec{Config::getInstance().getDeferLowering()};
+    {
+        utils::ScopedTiming timing{"defer_commit"};
+        if (deferExec.commit(*ast, deferAnalysis) == false)
+        {
+            return false;
+        }
+    }
+
+    // the checks below see the folded expressions
+    if (Config::getInstance().getFoldConstants())
+    {
+        WalkerConstantFold constantFold;
+        {
+            utils::ScopedTiming timing{"constant_fold"};
+            constantFold.commit(*ast);
+        }
+
+        const auto &report = constantFold.getReport();
+        log("Constant folding: % expressions folded (% operators), % left to the compiler",
+            report.mFolded,
+            report.mOperators,
+            report.mUnfolded);
+    }
+
+    // before the other checks, their code is opaque to the dataflow
+    if (Config::getInstance().getNullChecks())
+    {
+        WalkerNullCheck nullCheck;
+        {
+            utils::ScopedTiming timing{"null_check"};
+            nullCheck.commit(*ast);
+        }
+
+        const auto &report = nullCheck.getReport();
+        log("NULL checks: % checked, % elided, % not checked", report.mChecked, report.mElided, report.mUnchecked);
+    }
+
+    if (Config::getInstance().getBoundsChecks())
+    {
+        WalkerBoundsCheck boundsCheck;
+        {
+            utils::ScopedTiming timing{"bounds_check"};
+            if (boundsCheck.commit(*ast) == false)
+            {
+                return false;
+            }
+        }
+
+        const auto &report = boundsCheck.getReport();
+        log("Bounds checks: % at the access, % hoisted out of loops (% checks), % proven, % not checked",
+            report.mChecked,
+            report.mHoisted,
+            report.mLoopChecks,
+            report.mProven,
+            report.mUnchecked);
+    }
+
+    // the last one, only the switches not changed by the passes above are sorted
+    if (Config::getInstance().getSortCases())
+    {
+        WalkerSwitchSort switchSort;
+        {
+            utils::ScopedTiming timing{"switch_sort"};
+            switchSort.commit(*ast);
+        }
+
+        const auto &report = switchSort.getReport();
+        log("Switch cases: % switches sorted, % already sorted, % skipped (fallthrough, labels not known)",
+            report.mSorted,
+            report.mInOrder,
+            report.mSkipped);
+
+        for (const auto &it : report.mSwitches)
+        {
+            log("    line %: % cases in % .. %, %",
+                it.mLine,
+                it.mCases,
+                it.mMin,
+                it.mMax,
+                WalkerSwitchSort::isDense(it) ? "dense" : "sparse");
+        }
+    }
 
     if (Config::getInstance().getDisplayAstMod())
     {
@@ -30,6 +194,55 @@ void Generator::generate( //
     generateFinalSource(ast, outputFile);
 
     log("Generated file %", outputFile.c_str());
+
+    return true;
+}
+
+std::shared_ptr<SemNodeTranslationUnit> Generator::expandGenerics( //
+    const SemNodeTranslationUnit &ast,
+    const fs::path &outputFile,
+    Parser &parser)
+{
+    GenericExpansion expansion{outputFile, mGenericOwners};
+
+    std::string expanded;
+    {
+        utils::ScopedTiming timing{"generic_expansion"};
+        if (expansion.expand(ast, expanded) == false)
+        {
+            return nullptr;
+        }
+    }
+
+    const auto &report = expansion.getReport();
+    log("Generics: % instances, % defined by other files", report.mInstances, report.mDeclared);
+
+    const auto expandedFile = fs::path{outputFile}.replace_extension("generic.sc");
+    {
+        std::ofstream file{expandedFile, std::ios::trunc};
+        file << expanded;
+
+        if (file.good() == false)
+        {
+            log("ERROR: can not write %", Color::Red, expandedFile.c_str());
+            return nullptr;
+        }
+    }
+
+    if (parser.parse(expandedFile.string()).has_value() == false)
+    {
+        log("ERROR: can not parse %", Color::Red, expandedFile.c_str());
+        return nullptr;
+    }
+
+    auto expandedAst = parser.getAst();
+    if (GenericExpansion::hasGenerics(*expandedAst))
+    {
+        log("ERROR: generics left in %", Color::Red, expandedFile.c_str());
+        return nullptr;
+    }
+
+    return expandedAst;
 }
 
 void Generator::generateFinalSource( //
@@ -37,7 +250,12 @@ void Generator::generateFinalSource( //
     const std::filesystem::path &outputFile)
 {
     WalkerSourceGen sourceGen{outputFile};
-    mWalker.walk(*ast, sourceGen);
+    {
+        // only positions are needed from here on, read them from a flat copy
+        utils::ScopedTiming timing{"sourcegen_walk"};
+        const SemNodeFlat flatAst{*ast};
+        sourceGen.collect(flatAst);
+    }
 
     sourceGen.generate();
 }
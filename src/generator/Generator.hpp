@@ -1,6 +1,7 @@
 #pragma once
 
 #include "semantic_nodes/SemNode.hpp"
+#include "walkers/GenericExpansion.hpp"
 #include "walkers/SemNodeWalker.hpp"
 
 #include <filesystem>
@@ -13,19 +14,30 @@ namespace safec
 
 class Parser;
 
+// one generator for all the files of an invocation, the first file
+// using a generic function instance defines it
 class Generator
 {
 public:
-    void generate( //
+    // false if the file can not be generated
+    bool generate( //
         std::shared_ptr<SemNodeTranslationUnit> ast,
         const fs::path &outputFile);
 
 private:
+    // writes the source with the generics expanded next to the output file and
+    // parses it with the parser, returns its AST (nullptr on errors)
+    std::shared_ptr<SemNodeTranslationUnit> expandGenerics( //
+        const SemNodeTranslationUnit &ast,
+        const fs::path &outputFile,
+        Parser &parser);
+
     void generateFinalSource( //
         std::shared_ptr<SemNodeTranslationUnit> ast,
         const fs::path &outputFile);
 
     SemNodeWalker mWalker;
+    GenericExpansion::Owners mGenericOwners;
 };
 
 } // namespace safec
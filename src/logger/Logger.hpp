@@ -131,7 +131,7 @@ void log(const char *const fmt, //
             }
             else
             {
-                const bool argsInRange = (argsUsed < argsStr.size());
+                [[maybe_unused]] const bool argsInRange = (argsUsed < argsStr.size());
                 assert(argsInRange);
 
                 output += argsStr[argsUsed];
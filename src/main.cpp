@@ -2,12 +2,15 @@
 #include "generator/Generator.hpp"
 #include "logger/Logger.hpp"
 #include "parser/Parser.hpp"
-#include "semantics/SemanticsFactory.hpp"
+#include "serialization/AstBinaryReader.hpp"
+#include "serialization/AstBinaryWriter.hpp"
+#include "utils/Timings.hpp"
 
 #include <boost/program_options.hpp>
 #include <filesystem>
 #include <iostream>
 #include <string>
+#include <sys/resource.h>
 #include <vector>
 
 namespace po = boost::program_options;
@@ -15,6 +18,28 @@ namespace fs = std::filesystem;
 
 // TODO: some proper functional/unit tests
 
+#ifndef SAFEC_BUILD_PROFILE_NAME
+#define SAFEC_BUILD_PROFILE_NAME "unknown"
+#endif
+
+static void displayTimings()
+{
+    auto &timings = safec::utils::Timings::getInstance();
+
+    safec::log("Timings (% build):", SAFEC_BUILD_PROFILE_NAME);
+    for (const auto &it : timings.getPhases())
+    {
+        safec::log("\t% %", it.first, it.second.count());
+    }
+
+    // ru_maxrss is in kilobytes
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    safec::log("\tpeak_memory_kb %", usage.ru_maxrss);
+
+    timings.clear();
+}
+
 int main(int argc, char **argv)
 {
     po::options_description desc("All SafeC transpiler options:");
@@ -29,6 +54,17 @@ int main(int argc, char **argv)
         ("coverage,c", "display coverage info")                                                      //
         ("generate", "generate the output C file - now for debug purposes")                          //
         ("astdump-mod", "dump AST after all modifications (must be used with --generate)")           //
+        ("timings,t", "display time spent in each phase (us) and peak memory")                       //
+        ("ast-binary", "write the binary AST (.scast) to the output directory")                      //
+        ("ast-binary-dump", po::value<std::string>(), "print the AST from a binary AST file")        //
+        ("ast-json", "stream the AST as JSON (.json) to the output directory")                       //
+        ("defer-lowering", po::value<std::string>(), "defer lowering mode { inline, goto }")         //
+        ("bounds-checks", "check the indexes of the arrays with a known size")                       //
+        ("null-checks", "check the pointers for NULL before they are dereferenced")                  //
+        ("fold-constants", "fold the integer constant expressions into constants")                   //
+        ("remove-dead-code", "remove the statements after return, break and continue")               //
+        ("sort-cases", "sort the switch cases by their labels, for a jump table")                    //
+        ("int-width", po::value<uint32_t>(), "bits of int on the target { 16, 32 }, 32 by default")  //
         ("debug", "debug mode - display all possible info");
 
     po::variables_map vm;
@@ -41,14 +77,31 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    auto &cfg = safec::Config::getInstance();
+
+    if (vm.count("nocolor") != 0)
+    {
+        cfg.setNoColor(true);
+    }
+
+    if (vm.count("ast-binary-dump") != 0)
+    {
+        safec::AstBinaryReader reader;
+        if (reader.open(vm["ast-binary-dump"].as<std::string>()) == false)
+        {
+            return -1;
+        }
+
+        reader.print();
+        return 0;
+    }
+
     if (vm.count("output") == 0)
     {
         safec::log("missing output file(s) directory");
         return -1;
     }
 
-    auto &cfg = safec::Config::getInstance();
-
     if (vm.count("astdump") != 0)
     {
         cfg.setDisplayAst(true);
@@ -59,11 +112,6 @@ int main(int argc, char **argv)
         cfg.setDisplayParserInfo(true);
     }
 
-    if (vm.count("nocolor") != 0)
-    {
-        cfg.setNoColor(true);
-    }
-
     if (vm.count("coverage") != 0)
     {
         cfg.setDisplayCoverage(true);
@@ -90,6 +138,66 @@ int main(int argc, char **argv)
         cfg.setDisplayAstMod(true);
     }
 
+    if (vm.count("defer-lowering") != 0)
+    {
+        const auto &lowering = vm["defer-lowering"].as<std::string>();
+        if (lowering == "inline")
+        {
+            cfg.setDeferLowering(safec::DeferLowering::Inline);
+        }
+        else if (lowering == "goto")
+        {
+            cfg.setDeferLowering(safec::DeferLowering::Goto);
+        }
+        else
+        {
+            safec::log("ERROR: unknown defer lowering mode '%'", lowering);
+            return -1;
+        }
+    }
+
+    if (vm.count("bounds-checks") != 0)
+    {
+        cfg.setBoundsChecks(true);
+    }
+
+    if (vm.count("null-checks") != 0)
+    {
+        cfg.setNullChecks(true);
+    }
+
+    if (vm.count("fold-constants") != 0)
+    {
+        cfg.setFoldConstants(true);
+    }
+
+    if (vm.count("remove-dead-code") != 0)
+    {
+        cfg.setRemoveDeadCode(true);
+    }
+
+    if (vm.count("sort-cases") != 0)
+    {
+        cfg.setSortCases(true);
+    }
+
+    if (vm.count("int-width") != 0)
+    {
+        const auto bits = vm["int-width"].as<uint32_t>();
+        if ((bits != 16) && (bits != 32))
+        {
+            safec::log("ERROR: unsupported int width %", bits);
+            return -1;
+        }
+
+        cfg.setIntWidth(bits);
+    }
+
+    if (vm.count("timings") != 0)
+    {
+        safec::utils::Timings::getInstance().setEnabled(true);
+    }
+
     if (vm.count("debug") != 0)
     {
         cfg.setDisplayAst(true);
@@ -118,14 +226,21 @@ int main(int argc, char **argv)
 
     if (vm.count("file") > 0)
     {
-        safec::Parser parser{safec::SemanticsFactory::get()};
+        safec::Parser parser;
+        safec::Generator generator;
 
         auto &filesToParse = vm["file"].as<std::vector<std::string>>();
         for (const auto &it : filesToParse)
         {
             safec::log("Parsing file: '%'...", it);
-            const size_t charCount = parser.parse(it);
-            safec::log("\n\nParsing done, characters count %\n", charCount);
+            const auto charCount = parser.parse(it);
+            if (charCount.has_value() == false)
+            {
+                safec::log("ERROR: can not parse '%'", it);
+                return -1;
+            }
+
+            safec::log("\n\nParsing done, characters count %\n", *charCount);
 
             if (cfg.getDisplayAst() == true)
             {
@@ -137,14 +252,41 @@ int main(int argc, char **argv)
                 parser.displayCoverage();
             }
 
+            if (vm.count("ast-binary") != 0)
+            {
+                const auto binaryFileName = fs::path{it}.filename().replace_extension("scast");
+                const auto binaryFileFullPath = std::filesystem::weakly_canonical(outputDirectory / binaryFileName);
+
+                safec::AstBinaryWriter writer;
+                if (writer.write(*parser.getAst(), binaryFileFullPath) == false)
+                {
+                    return -1;
+                }
+            }
+
+            if (vm.count("ast-json") != 0)
+            {
+                const auto jsonFileName = fs::path{it}.filename().replace_extension("json");
+                const auto jsonFileFullPath = std::filesystem::weakly_canonical(outputDirectory / jsonFileName);
+
+                parser.exportAstJson(jsonFileFullPath);
+            }
+
             if (cfg.getGenerate())
             {
                 const auto outputFileName = fs::path{it}.filename().replace_extension("c");
                 const auto outputFileFullPath = std::filesystem::weakly_canonical(outputDirectory / outputFileName);
 
                 safec::log("Generating C file: '%'", outputFileFullPath.c_str());
-                safec::Generator generator;
-                generator.generate(parser.getAst(), outputFileFullPath);
+                if (generator.generate(parser.getAst(), outputFileFullPath) == false)
+                {
+                    return -1;
+                }
+            }
+
+            if (safec::utils::Timings::getInstance().getEnabled())
+            {
+                displayTimings();
             }
         }
     }
@@ -1,9 +1,12 @@
 #include "Parser.hpp"
 
 #include "logger/Logger.hpp"
+#include "semantic_nodes/SemNodeFlat.hpp"
 #include "semantics/Semantics.hpp"
+#include "utils/Timings.hpp"
 #include "utils/Utils.hpp"
 #include "walkers/SemNodeWalker.hpp"
+#include "walkers/WalkerJsonExport.hpp"
 #include "walkers/WalkerPrint.hpp"
 #include "walkers/WalkerSourceCoverage.hpp"
 
@@ -19,23 +22,32 @@ extern "C"
 extern "C"
 {
     extern FILE *yyin;
+    extern int yylineno;
+    extern int column;
     extern int lex_current_char;
+
+    void yyrestart(FILE *inputFile);
 }
 
+// defined in the generated parser
+void yysetsemantics(safec::Semantics *semantics);
+
 namespace fs = std::filesystem;
 
 namespace safec
 {
 
-Parser::Parser(Semantics &sem) //
-    : mSemantics{sem}
+Parser::Parser() //
+    : mSemantics{}
     , mCurrentlyParsedFile{}
 {
 }
 
-size_t Parser::parse(const std::string &path)
+Parser::~Parser() = default;
+
+std::optional<size_t> Parser::parse(const std::string &path)
 {
-    size_t charCount = 0;
+    std::optional<size_t> charCount;
 
     const fs::path filePath{path};
     if (fs::exists(filePath) == false)
@@ -66,27 +78,41 @@ void Parser::displayAst() const
     SemNodeWalker walker;
     WalkerPrint printer;
 
-    mSemantics.walk(walker, printer);
+    assert(mSemantics);
+    mSemantics->walk(walker, printer);
 
     log("\n\n", NewLine::No);
 }
 
 void Parser::displayCoverage() const
 {
-    SemNodeWalker walker;
-    WalkerSourceCoverage covChecker;
+    assert(mSemantics);
+    const SemNodeFlat ast{*mSemantics->getAst()};
 
-    mSemantics.walk(walker, covChecker);
+    WalkerSourceCoverage covChecker;
+    covChecker.collect(ast);
 
     covChecker.printReport();
 }
 
+void Parser::exportAstJson(const std::filesystem::path &outputFile) const
+{
+    SemNodeWalker walker;
+    WalkerJsonExport jsonExport{outputFile};
+
+    assert(mSemantics);
+    mSemantics->walk(walker, jsonExport);
+
+    jsonExport.finish();
+}
+
 std::shared_ptr<SemNodeTranslationUnit> Parser::getAst() const
 {
-    return mSemantics.getAst();
+    assert(mSemantics);
+    return mSemantics->getAst();
 }
 
-size_t Parser::parseFile(const fs::path &path)
+std::optional<size_t> Parser::parseFile(const fs::path &path)
 {
     assert(fs::is_regular_file(path) == true);
 
@@ -106,14 +132,33 @@ size_t Parser::parseFile(const fs::path &path)
 
     {
         yyin = fopen(path.c_str(), "r");
-        assert(yyin != nullptr);
+        if (yyin == nullptr)
+        {
+            log("ERROR: can not open %", Color::Red, path.c_str());
+            return std::nullopt;
+        }
 
         utils::DeferredCall defer{[] { fclose(yyin); }};
 
-        mSemantics.newTranslationUnit(path);
+        // each file gets a fresh lexer & semantics state, previously
+        // returned ASTs stay valid
+        yyrestart(yyin);
+        yylineno = 1;
+        column = 0;
+        lex_current_char = 0;
+
+        mSemantics = std::make_unique<Semantics>(path);
+
+        yysetsemantics(mSemantics.get());
+        utils::DeferredCall unbind{[] { yysetsemantics(nullptr); }};
 
+        utils::ScopedTiming timing{"parse"};
+        // not an assert, the release builds would go on with a partial AST
         const int32_t parseRes = yyparse();
-        assert(parseRes == 0);
+        if (parseRes != 0)
+        {
+            return std::nullopt;
+        }
     }
 
     const size_t parsedCharsCount = lex_current_char;
@@ -3,6 +3,7 @@
 #include <any>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -15,24 +16,29 @@ class SemNodeTranslationUnit;
 class Parser final
 {
 public:
-    Parser(Semantics &sem);
-    ~Parser() = default;
+    Parser();
+    ~Parser();
 
     Parser(const Parser &) = delete;
     Parser(Parser &&) = delete;
     Parser &operator=(const Parser &) = delete;
     Parser &operator=(Parser &&) = delete;
 
-    size_t parse(const std::string &path);
+    // parsed characters count, nothing if the file has a syntax error
+    std::optional<size_t> parse(const std::string &path);
     void displayAst() const;
     void displayCoverage() const;
 
+    // streams the AST as JSON to outputFile
+    void exportAstJson(const std::filesystem::path &outputFile) const;
+
     std::shared_ptr<SemNodeTranslationUnit> getAst() const;
 
 private:
-    size_t parseFile(const std::filesystem::path &path);
+    std::optional<size_t> parseFile(const std::filesystem::path &path);
 
-    Semantics &mSemantics;
+    // semantics of the last parsed file, recreated for each parse
+    std::unique_ptr<Semantics> mSemantics;
     std::filesystem::path mCurrentlyParsedFile;
 };
 
@@ -0,0 +1,11 @@
+#define BUFFER_SIZE 64
+#define HEADER_SIZE 8
+
+static_assert(BUFFER_SIZE > HEADER_SIZE, "the buffer does not fit the header");
+static_assert(BUFFER_SIZE < HEADER_SIZE, "the header does not fit the buffer");
+
+int main(void)
+{
+    static_assert(HEADER_SIZE * 16 <= BUFFER_SIZE);
+    return 0;
+}
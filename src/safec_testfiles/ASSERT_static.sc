@@ -0,0 +1,64 @@
+#include <stdio.h>
+
+#define BUFFER_SIZE 64
+#define HEADER_SIZE 8
+
+#ifndef RECORD_COUNT
+#define RECORD_COUNT 4
+#endif
+
+typedef struct
+{
+    int id;
+    char name[16];
+} record_t;
+
+static_assert(BUFFER_SIZE > HEADER_SIZE, "the buffer does not fit the header");
+static_assert((BUFFER_SIZE & (BUFFER_SIZE - 1)) == 0, "the buffer size is not a power of two");
+static_assert(sizeof(record_t) >= 20, "the record is too small");
+
+enum color
+{
+    COLOR_RED,
+    COLOR_GREEN,
+    COLOR_COUNT
+};
+
+static_assert(COLOR_COUNT == 2);
+static_assert(RECORD_COUNT <= BUFFER_SIZE / HEADER_SIZE, "too many records");
+
+/* the blocks may not be compiled, left to the compiler */
+#if 0
+static_assert(BUFFER_SIZE < HEADER_SIZE, "never compiled");
+#endif
+
+#ifndef RECORD_BUFFER
+static_assert(HEADER_SIZE > 0);
+#else
+static_assert(HEADER_SIZE == 0, "compiled only with RECORD_BUFFER");
+#endif
+
+int sum(int *values, int count)
+{
+    int result = 0;
+    int i;
+    static_assert(0xFFu + 1u == 256u, "unsigned arithmetic");
+    static_assert(sizeof(result) == sizeof(int), "the result is not an int");
+    static_assert(-1 < 0 && (1 << 4) == 16);
+
+    for (i = 0; i < count; i++)
+    {
+        result += values[i];
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int values[HEADER_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8};
+    static_assert(HEADER_SIZE * 2 < BUFFER_SIZE, "the header is too big, \"see\" the buffer");
+
+    printf("%d\n", sum(values, HEADER_SIZE));
+    return 0;
+}
@@ -0,0 +1,28 @@
+// test typedef names recognized as types, following the scopes
+
+typedef int myint_t;
+typedef unsigned long *ulongptr_t;
+
+myint_t globalTypedefVar = 5;
+
+myint_t FUNCTION_WITH_TYPEDEF_PARAMS(myint_t a, ulongptr_t b)
+{
+    myint_t sum = a + 1;
+    ulongptr_t ptrCopy = b;
+    myint_t *ptrToTypedef = &sum;
+
+    return sum;
+}
+
+void FUNCTION_WITH_SCOPED_TYPEDEF(void)
+{
+    {
+        typedef char scoped_t;
+        scoped_t scopedVar = 'c';
+    }
+}
+
+int FUNCTION_REUSING_TYPEDEF_NAME(int scoped_t)
+{
+    return scoped_t;
+}
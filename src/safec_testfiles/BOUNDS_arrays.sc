@@ -0,0 +1,146 @@
+#define N 8
+
+int g[4];
+int count;
+
+int Next(void);
+
+void Loops(int n)
+{
+    int a[10];
+    int b[N];
+    int c[] = { 1, 2, 3 };
+    int i = 0;
+
+    /* in range, nothing to check */
+    for (i = 0; i < 10; i++)
+    {
+        a[i] = i;
+    }
+
+    /* one check per array before the loop */
+    for (i = 0; i < n; ++i)
+    {
+        a[i] = c[i + 1];
+        b[i] = a[i];
+    }
+
+    for (i = 1; i <= N; i++)
+    {
+        b[i - 1] = i;
+    }
+
+    /* the index changes in the loop, checked at the access */
+    for (i = 0; i < n; i++)
+    {
+        a[i] = 0;
+        i = i + 1;
+    }
+
+    /* the global bound can change in the call */
+    for (i = 0; i < count; i++)
+    {
+        g[i] = Next();
+    }
+
+    /* not on every iteration */
+    for (i = 0; i < n; i++)
+    {
+        if (i == 3)
+        {
+            break;
+        }
+
+        a[i] = 0;
+    }
+
+    while (i < 3)
+    {
+        c[i] = 0;
+        i++;
+    }
+}
+
+void Aliased(int n)
+{
+    int a[10];
+    int i = 0;
+    int *p = &i;
+
+    /* the index can change through the pointer, checked at the access */
+    for (i = 0; i < n; i++)
+    {
+        a[i] = 0;
+        *p = *p + 1;
+    }
+}
+
+int Find(int n, int key)
+{
+    int a[10];
+    int i;
+
+    /* the search stops at the key, the range to n is not checked */
+    for (i = 0; i < n; i++)
+    {
+        if (a[i] == key)
+        {
+            return i;
+        }
+    }
+
+    /* a break of a nested loop does not leave the loop */
+    for (i = 0; i < n; i++)
+    {
+        a[i] = key;
+        while (Next())
+        {
+            break;
+        }
+    }
+
+    return -1;
+}
+
+void Unchecked(int n)
+{
+    int a[10];
+    int m[2][3];
+
+    defer a[n] = 0;
+
+    /* only counted: the deferred access above and the second index */
+    m[n][n + 1] = 1;
+}
+
+int Accesses(int n, int p[])
+{
+    int a[10];
+    int m[2][3];
+    int k = a[n];
+
+    a[3] = a[9];
+    k = a[n - 1] + g[n];
+    m[1][2] = p[n];
+    a[a[n]] = 0;
+    a[n++] = 0;
+
+    if (a[n] == 0)
+    {
+        return (n > 0) && (a[n - 1] == 0);
+    }
+
+    switch (a[k])
+    {
+        case 1:
+            k = a[k + 1];
+            break;
+        default:
+            break;
+    }
+
+    {
+        int a = 0;
+        return a + n;
+    }
+}
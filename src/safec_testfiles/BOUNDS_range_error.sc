@@ -0,0 +1,18 @@
+#define N 4
+
+int g[N];
+
+int OutOfRange(int n)
+{
+    int a[10];
+
+    /* the indexes known here have to be in the range */
+    a[n] = g[N - 1];
+
+    if (n > 0)
+    {
+        return a[10 + 2];
+    }
+
+    return a[-1];
+}
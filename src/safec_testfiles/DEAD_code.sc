@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond) if (!(cond)) goto fail
+
+int parse(const char *text)
+{
+    int value = 0;
+
+    switch (text[0])
+    {
+        case 'a':
+            value = 1;
+            break;
+            value = 2;
+            printf("never: %d\n", value);
+        case 'b':
+        {
+            value = 3;
+            return value;
+        }
+            value = 4;
+        default:
+            break;
+    }
+
+    return value;
+    printf("unreachable\n");
+    value++;
+}
+
+int sum(int *values, int count)
+{
+    int i;
+    int result = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        if (values[i] < 0)
+        {
+            continue;
+            result -= values[i];
+        }
+
+        result += values[i];
+    }
+
+    return result;
+}
+
+int load(const char *path)
+{
+    char *buffer = malloc(64);
+    defer free(buffer);
+
+    CHECK(path != NULL);
+    CHECK(buffer != NULL);
+
+    printf("loading %s\n", path);
+    return 0;
+    printf("done: %s\n", path);
+
+fail:
+    printf("failed\n");
+    return -1;
+}
+
+int trace(int level)
+{
+    if (level > 2)
+    {
+        return level;
+    }
+
+    return 0;
+#ifdef TRACE_ALL
+    printf("level %d\n", level);
+    return 1;
+#endif
+}
+
+int next(void)
+{
+    return 7;
+}
+
+/* the exits in the do-while body leave the loop, not the function */
+int retry(int x)
+{
+    int n = 0;
+    do
+    {
+        n += next();
+        if (n > x)
+        {
+            continue;
+        }
+        break;
+        n = -1;
+    } while (n < 100);
+    n = n * 2;
+    return n;
+}
+
+int main(void)
+{
+    int values[4] = {1, -2, 3, -4};
+
+    {
+        printf("%d\n", sum(values, 4));
+        return parse("a") + load("file") + trace(1) + retry(20);
+    }
+    printf("after the block\n");
+    return 0;
+}
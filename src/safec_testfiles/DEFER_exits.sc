@@ -0,0 +1,180 @@
+#include <stdio.h>
+
+// early exits out of the scopes with armed defers
+
+static const char *NAME(int param)
+{
+    defer printf("name done\n");
+
+    if (param == 1)
+    {
+        return "one";
+    }
+
+    return "other";
+}
+
+int RETURN_NESTED(int param)
+{
+    printf("start\n");
+    defer printf("end\n");
+
+    if (param < 100)
+    {
+        defer printf("inner\n");
+        if (param > 50)
+        {
+            return param;
+        }
+
+        {
+            defer printf("innermost\n");
+            if (param == 7)
+            {
+                return 7 * 2;
+            }
+        }
+    }
+
+    return 123;
+}
+
+void RETURN_VOID(int param)
+{
+    defer printf("void end\n");
+    if (param)
+    {
+        defer printf("void inner\n");
+        return;
+    }
+    printf("void fallthrough\n");
+}
+
+void LOOP_EXITS(int param)
+{
+    int i = 0;
+    int j = 0;
+    defer printf("loops done\n");
+
+    for (i = 0; i < 4; i++)
+    {
+        defer printf("outer %d\n", i);
+        if (i == param)
+        {
+            continue;
+        }
+
+        for (j = 0; j < 3; j++)
+        {
+            defer printf("inner %d\n", j);
+            if (j == 1)
+            {
+                break;
+            }
+        }
+
+        if (i == 2)
+        {
+            break;
+        }
+    }
+}
+
+void DO_EXITS(int param)
+{
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < 2; i++)
+    {
+        defer printf("for %d\n", i);
+
+        j = 0;
+        do
+        {
+            defer printf("do %d\n", j);
+            j++;
+            if (j == param)
+            {
+                continue;
+            }
+
+            break;
+        } while (j < 3);
+    }
+}
+
+int SWITCH_EXITS(int param)
+{
+    int result = 0;
+    switch (param)
+    {
+        case 0:
+        {
+            defer printf("case 0 done\n");
+            result = 10;
+            break;
+        }
+
+        default:
+            result = -1;
+            break;
+    }
+
+    return result;
+}
+
+int SHADOWED(int param)
+{
+    int x = 1;
+    defer printf("shadowed %d\n", x);
+
+    if (param)
+    {
+        int x = 2;
+        printf("inner %d\n", x);
+        return 1;
+    }
+
+    return 0;
+}
+
+int EARLY(int param)
+{
+    if (param == 0)
+    {
+        return 0;
+    }
+
+    defer printf("armed late\n");
+    return param;
+}
+
+int GOTO_EXITS(int param)
+{
+    int result = 0;
+    defer printf("goto done\n");
+
+    {
+        defer printf("goto inner\n");
+        if (param == 1)
+        {
+            goto out;
+        }
+
+        result = 1;
+    }
+
+retry:
+    {
+        defer printf("goto retry %d\n", result);
+        result++;
+        if (result < 3)
+        {
+            goto retry;
+        }
+    }
+
+out:
+    return result;
+}
@@ -0,0 +1,61 @@
+#define UART_BASE 0x40001000
+#define REG(offset) (*(volatile unsigned *)(UART_BASE + (offset)))
+
+extern void Use(int value);
+extern void UseUnsigned(unsigned value);
+
+/* a static initializer, folded by every compiler anyway */
+int table[4] = { 1 << 2, 3 * 4, -(2 - 7), 0x10 | 0x01 };
+
+void Registers(void)
+{
+    unsigned control = REG(0x10 * 4);
+    unsigned status = UART_BASE + 0x04 * 8 + 2;
+
+    UseUnsigned(control + status);
+    UseUnsigned(0xFFFFFFFFu + 2);
+    UseUnsigned(1u << 31);
+    UseUnsigned(~0u);
+}
+
+int Arithmetic(int x)
+{
+    int a = 60 * 60 * 24;
+    int b = (1 + 2) * x;
+    int c = x - (1 - 3);
+    int d = x + -(4 * 2);
+
+    /* not a constant subexpression, (x - 1) + 2 */
+    Use(x - 1 + 2);
+
+    /* grouping parentheses around the whole expression go too */
+    Use((7 % 4));
+    Use(sizeof (int) * (2 + 2));
+    Use((int)(5 - 1));
+
+    if (a > 1000 * 60)
+    {
+        return (2 > 1) ? 10 / 3 : 0;
+    }
+
+    while (x < 10 - 1)
+    {
+        x = x + (!0 && 3 != 4) + (-1 < 0u);
+    }
+
+    defer Use(1 + 1);
+
+    return a + b + c + d;
+}
+
+int LeftToTheCompiler(void)
+{
+    int overflow = 2147483647 + 1;
+    int byZero = 1 / 0;
+    int negative = -7 / 2;
+    int shift = 1 << 32;
+    long wide = 3000000000 + 1;
+    int character = 'a' + 1;
+
+    return overflow + byZero + negative + shift + (int)wide + character + (2 * 3);
+}
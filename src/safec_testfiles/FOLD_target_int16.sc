@@ -0,0 +1,21 @@
+/* generated with --int-width=16, the values of a 16 bit int */
+
+extern void Use(int value);
+extern void UseUnsigned(unsigned value);
+
+static_assert(0x8000 > 0, "unsigned on this target");
+static_assert(~0u == 65535u);
+
+void Target(void)
+{
+    UseUnsigned(0x8000 - 0x8001);
+    UseUnsigned(1u << 15);
+    UseUnsigned(~0u);
+    Use(0x7FFF - 1);
+    Use(-32767 - 1);
+
+    /* left to the compiler */
+    Use(32767 + 1);
+    Use(40000 - 1);
+    Use(1 << 16);
+}
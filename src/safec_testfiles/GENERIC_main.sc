@@ -0,0 +1,76 @@
+#include <stdio.h>
+
+/* generic functions and structs, the instances of the non-static functions
+   used by both GENERIC_ files are defined only once for the program */
+
+extern int Clamp(int value, int low, int high);
+
+generic <T>
+T Max(T a, T b)
+{
+    if (a > b)
+    {
+        return a;
+    }
+    return b;
+}
+
+generic <T>
+struct Pair
+{
+    T first;
+    T second;
+};
+
+generic <T>
+T PairMax(struct Pair::<T> *pair)
+{
+    return Max::<T>(pair->first, pair->second);
+}
+
+generic <T>
+struct Node
+{
+    T value;
+    struct Node::<T> *next;
+};
+
+generic <T>
+static int Count(struct Node::<T> *node)
+{
+    int count = 0;
+    defer printf("counted %d\n", count);
+
+    while (node != 0)
+    {
+        count++;
+        node = node->next;
+    }
+
+    return count;
+}
+
+int main(void)
+{
+    struct Pair::<int> ints;
+    struct Pair::<double> doubles;
+    struct Node::<char *> second;
+    struct Node::<char *> first;
+
+    ints.first = 3;
+    ints.second = 7;
+    doubles.first = 2.5;
+    doubles.second = 1.5;
+
+    second.value = "second";
+    second.next = 0;
+    first.value = "first";
+    first.next = &second;
+
+    printf("%d %.1f\n", PairMax::<int>(&ints), PairMax::<double>(&doubles));
+    printf("%d\n", Count::<char *>(&first));
+    printf("%lu\n", Max::<unsigned long>(1, 2));
+    printf("%d\n", Clamp(Max::<int>(-5, 20), 0, 10));
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+/* second file of the program in GENERIC_main.sc, each file has its own
+   copy of the generics it uses - Max_int is defined by GENERIC_main.c */
+
+generic <T>
+T Max(T a, T b)
+{
+    if (a > b)
+    {
+        return a;
+    }
+    return b;
+}
+
+generic <T>
+T Min(T a, T b)
+{
+    if (a < b)
+    {
+        return a;
+    }
+    return b;
+}
+
+int Clamp(int value, int low, int high)
+{
+    return Min::<int>(Max::<int>(value, low), high);
+}
@@ -0,0 +1,146 @@
+#define NULL 0
+
+struct Node
+{
+    int value;
+    struct Node *next;
+};
+
+struct Node *head;
+
+extern void Use(int value);
+
+int Sum(struct Node *node)
+{
+    int sum = 0;
+
+    /* the condition covers the body */
+    while (node != NULL)
+    {
+        sum = sum + node->value;
+        node = node->next;
+    }
+
+    return sum;
+}
+
+void Assign(int *p, int *q, struct Node *n)
+{
+    int x = 0;
+    int arr[4];
+    int *r = &x;
+
+    /* one check for all the dereferences after it */
+    *p = 1;
+    *p = *p + 1;
+    Use(*p);
+
+    /* known from the assignment or the array */
+    *r = 2;
+    r = arr;
+    *r = 3;
+
+    /* checked again after a change */
+    p = q;
+    *p = 4;
+
+    /* the pointer changes in the statement */
+    q = n->next == NULL ? &x : q;
+    n = n->next;
+    n->value = 5;
+}
+
+int Guards(struct Node *n, int *p)
+{
+    if (n == NULL)
+    {
+        return 0;
+    }
+
+    n->value = 1;
+
+    if (p && (*p > 0))
+    {
+        Use(*p);
+    }
+
+    /* not known after the branch */
+    *p = 0;
+
+    if (!head)
+    {
+        return n->value;
+    }
+
+    Use(head->value);
+    Use(0);
+    return head->value;
+}
+
+void Loops(struct Node *n, int *p)
+{
+    int i;
+
+    *p = 0;
+
+    /* p does not change in the loop */
+    for (i = 0; i < 3; i++)
+    {
+        *p = *p + i;
+    }
+
+    for (; n; n = n->next)
+    {
+        n->value = *p;
+    }
+
+    switch (*p)
+    {
+        case 1:
+            n->value = 1;
+            break;
+        default:
+            *p = 0;
+            break;
+    }
+
+    *p = 1;
+}
+
+struct Holder
+{
+    int *p;
+    struct Node *node;
+};
+
+/* the members are not tracked, only the plain pointers are checked */
+void Members(struct Holder h, struct Holder *ph)
+{
+    *h.p = 1;
+    h.node->value = 2;
+    ph->node->value = h.p[0];
+    ph->p = h.p;
+}
+
+/* the condition runs after the body, nothing is kept
+   between the statements */
+void Hidden(int *p, int *q)
+{
+    *p = 0;
+
+    do
+    {
+        *p = *p + *q;
+        q = p;
+    } while (*p < 10);
+}
+
+/* the deferred dereference is only counted, a "goto" or "do" in a
+   comment does not stop the tracking */
+void Deferred(int *p)
+{
+    defer *p = 5;
+
+    *p = 0; /* do not goto here */
+    *p = 1;
+}
@@ -22,10 +22,74 @@ then
     do
         ${SAFEC_PATH} -f $i -o . -a -n > ./testfiles_generated_asts/${i##*/}.AST
         ${SAFEC_PATH} -f $i -o . -c -n > ./testfiles_generated_coverage/${i##*/}.COV
+        ${SAFEC_PATH} -f $i -o /tmp -n --ast-binary > /dev/null
+        ${SAFEC_PATH} --ast-binary-dump /tmp/${i%.*}.scast -n > ./testfiles_generated_ast_binary/${i##*/}.BIN
+        ${SAFEC_PATH} -f $i -o /tmp -n --ast-json > /dev/null
+        cp /tmp/${i%.*}.json ./testfiles_generated_ast_json/${i##*/}.JSON
     done
 
     ${SAFEC_PATH} -f AST_defer.sc -o /tmp -n --astdump-mod --generate > testfiles_generated_defer_ast/AST_defer.sc.AST
 
+    for i in `ls DEFER_*`;
+    do
+        ${SAFEC_PATH} -f $i -o ./testfiles_generated_defer_inline -n --generate > /dev/null
+        ${SAFEC_PATH} -f $i -o ./testfiles_generated_defer_goto -n --generate --defer-lowering=goto > /dev/null
+    done
+
+    for i in `ls BOUNDS_*`;
+    do
+        if [[ "$i" == *"_error.sc" ]];
+        then
+            ${SAFEC_PATH} -f $i -o /tmp -n --generate --bounds-checks | grep "ERROR" | tr -d '\r' > ./testfiles_generated_bounds_checks/${i%.*}.err
+        else
+            ${SAFEC_PATH} -f $i -o ./testfiles_generated_bounds_checks -n --generate --bounds-checks > /dev/null
+        fi
+    done
+
+    for i in `ls NULLS_*`;
+    do
+        ${SAFEC_PATH} -f $i -o ./testfiles_generated_null_checks -n --generate --null-checks > /dev/null
+    done
+
+    for i in `ls FOLD_*`;
+    do
+        INT_WIDTH=32
+        if [[ "$i" == *"_int16.sc" ]];
+        then
+            INT_WIDTH=16
+        fi
+
+        ${SAFEC_PATH} -f $i -o ./testfiles_generated_fold_constants -n --generate --fold-constants --int-width=$INT_WIDTH > /dev/null
+    done
+
+    for i in `ls ASSERT_*`;
+    do
+        if [[ "$i" == *"_error.sc" ]];
+        then
+            ${SAFEC_PATH} -f $i -o /tmp -n --generate | grep "ERROR" | tr -d '\r' > ./testfiles_generated_static_asserts/${i%.*}.err
+        else
+            ${SAFEC_PATH} -f $i -o ./testfiles_generated_static_asserts -n --generate > /dev/null
+        fi
+    done
+
+    for i in `ls DEAD_*`;
+    do
+        ${SAFEC_PATH} -f $i -o ./testfiles_generated_dead_code -n --generate --remove-dead-code > /dev/null
+    done
+
+    for i in `ls SWITCH_*`;
+    do
+        ${SAFEC_PATH} -f $i -o ./testfiles_generated_switch_sort -n --generate --sort-cases > /dev/null
+    done
+
+    # all at once, the generic function instances are shared by the files
+    generics_files=""
+    for i in `ls GENERIC_*`;
+    do
+        generics_files="$generics_files -f $i"
+    done
+    ${SAFEC_PATH} $generics_files -o ./testfiles_generated_generics -n --generate > /dev/null
+
     echo -e "${COLOR_GREEN}REGENERATING ALL TEST CASES DONE${COLOR_NC}"
 
     exit 0
@@ -0,0 +1,73 @@
+#!/bin/bash
+
+# very quick & dirty test for now...
+# writes the binary AST of each test file, maps it back and compares the dump
+
+SCRIPT_NAME=$(basename "$0")
+TMP_FILE_PREFIX=/tmp/safec_ast_binary_test_file_
+GENERATED_DIR=testfiles_generated_ast_binary
+GENERATED_FILE_EXT=BIN
+GENERATED_BINARY_DIR=/tmp/safec_ast_binary
+
+if [ -z "$SAFEC_PATH" ];
+then
+    SAFEC_PATH=../../build/bin/SafeCTranspiler
+fi
+
+if [ ! -d "$GENERATED_BINARY_DIR" ];
+then
+    echo "Creating binary AST dir: $GENERATED_BINARY_DIR..."
+    mkdir $GENERATED_BINARY_DIR
+fi
+
+AST_FILE_PREFIX="AST_"
+
+COLOR_RED="\033[31m"
+COLOR_GREEN="\033[32m"
+COLOR_NC="\033[0m"
+
+tests_passed=0
+tests_failed=0
+
+for file in `ls`;
+do
+    if [ "$file" != "$SCRIPT_NAME" ];
+    then
+        if [[ "$file" == "$AST_FILE_PREFIX"* ]];
+        then
+            FILE_GENERATED="$GENERATED_DIR/$file.$GENERATED_FILE_EXT"
+            if [ -e "$FILE_GENERATED" ];
+            then
+                echo "[+] Binary AST check for $file..."
+                FILE_BINARY="$GENERATED_BINARY_DIR/${file%.*}.scast"
+                $($SAFEC_PATH -f $file -o $GENERATED_BINARY_DIR -n --ast-binary > /dev/null)
+                $($SAFEC_PATH --ast-binary-dump $FILE_BINARY -n > $TMP_FILE_PREFIX$file)
+                diff_output=`diff -q $FILE_GENERATED $TMP_FILE_PREFIX$file`
+                if [ "$diff_output" = "" ];
+                then
+                    echo -e "[+] ${COLOR_GREEN}passed${COLOR_NC}"
+                    ((tests_passed++))
+                else
+                    echo -e "[-] ${COLOR_RED}FAILED${COLOR_NC}"
+                    echo "[-]    run to see differences:"
+                    echo "[-]     - diff $FILE_GENERATED $TMP_FILE_PREFIX$file"
+                    echo "[-]     - kdiff3 $FILE_GENERATED $TMP_FILE_PREFIX$file"
+                    echo "[-]    run to regenerate:"
+                    echo "[-]     - $SAFEC_PATH -f $file -o $GENERATED_BINARY_DIR -n --ast-binary"
+                    echo "[-]     - $SAFEC_PATH --ast-binary-dump $FILE_BINARY -n > $FILE_GENERATED"
+                    ((tests_failed++))
+                fi
+            fi
+        fi
+    fi
+done
+
+echo ""
+if [ "$tests_failed" -eq 0 ];
+then
+    echo -e "[+] SUMMARY: ${COLOR_GREEN}passed: $tests_passed, failed: $tests_failed${COLOR_NC}"
+    exit 0
+else
+    echo -e "[-] SUMMARY: ${COLOR_RED}passed: $tests_passed, failed: $tests_failed${COLOR_NC}"
+    exit 1
+fi
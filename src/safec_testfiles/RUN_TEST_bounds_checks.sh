@@ -0,0 +1,92 @@
+#!/bin/bash
+
+# very quick & dirty test for now...
+# generates the C code with the array bounds checks and compares it,
+# the *_error files must fail with the errors listed in their .err file
+
+SCRIPT_NAME=$(basename "$0")
+TMP_FILE_PREFIX=/tmp/safec_bounds_checks_test_file_
+GENERATED_DIR=testfiles_generated_bounds_checks
+GENERATED_C_SOURCE_DIR=/tmp/safec_bounds_checks
+
+if [ -z "$SAFEC_PATH" ];
+then
+    SAFEC_PATH=../../build/bin/SafeCTranspiler
+fi
+
+if [ ! -d "$GENERATED_C_SOURCE_DIR" ];
+then
+    echo "Creating C source generation dir: $GENERATED_C_SOURCE_DIR..."
+    mkdir $GENERATED_C_SOURCE_DIR
+fi
+
+BOUNDS_FILE_PREFIX="BOUNDS_"
+ERROR_FILE_SUFFIX="_error.sc"
+
+COLOR_RED="\033[31m"
+COLOR_GREEN="\033[32m"
+COLOR_NC="\033[0m"
+
+tests_passed=0
+tests_failed=0
+
+for file in `ls`;
+do
+    if [ "$file" != "$SCRIPT_NAME" ];
+    then
+        if [[ "$file" == "$BOUNDS_FILE_PREFIX"*"$ERROR_FILE_SUFFIX" ]];
+        then
+            FILE_ERRORS="$GENERATED_DIR/${file%.*}.err"
+            if [ -e "$FILE_ERRORS" ];
+            then
+                echo "[+] Array bounds errors for $file..."
+                $SAFEC_PATH -f $file -o $GENERATED_C_SOURCE_DIR -n --generate --bounds-checks | grep "ERROR" | tr -d '\r' > $TMP_FILE_PREFIX$file
+                exit_code=${PIPESTATUS[0]}
+                diff_output=`diff -q $FILE_ERRORS $TMP_FILE_PREFIX$file`
+                if [ "$exit_code" -ne 0 ] && [ "$diff_output" = "" ];
+                then
+                    echo -e "[+] ${COLOR_GREEN}passed${COLOR_NC}"
+                    ((tests_passed++))
+                else
+                    echo -e "[-] ${COLOR_RED}FAILED${COLOR_NC} (exit code $exit_code)"
+                    echo "[-]    run to see differences:"
+                    echo "[-]     - diff $FILE_ERRORS $TMP_FILE_PREFIX$file"
+                    ((tests_failed++))
+                fi
+            fi
+        elif [[ "$file" == "$BOUNDS_FILE_PREFIX"* ]];
+        then
+            FILE_GENERATED="$GENERATED_DIR/${file%.*}.c"
+            if [ -e "$FILE_GENERATED" ];
+            then
+                echo "[+] Array bounds checks for $file..."
+                $($SAFEC_PATH -f $file -o $GENERATED_C_SOURCE_DIR -n --generate --bounds-checks > /dev/null)
+                cp "$GENERATED_C_SOURCE_DIR/${file%.*}.c" $TMP_FILE_PREFIX$file
+                diff_output=`diff -q $FILE_GENERATED $TMP_FILE_PREFIX$file`
+                if [ "$diff_output" = "" ];
+                then
+                    echo -e "[+] ${COLOR_GREEN}passed${COLOR_NC}"
+                    ((tests_passed++))
+                else
+                    echo -e "[-] ${COLOR_RED}FAILED${COLOR_NC}"
+                    echo "[-]    run to see differences:"
+                    echo "[-]     - diff $FILE_GENERATED $TMP_FILE_PREFIX$file"
+                    echo "[-]     - kdiff3 $FILE_GENERATED $TMP_FILE_PREFIX$file"
+                    echo "[-]    run to regenerate:"
+                    echo "[-]     - $SAFEC_PATH -f $file -o $GENERATED_DIR -n --generate --bounds-checks"
+                    ((tests_failed++))
+                fi
+            fi
+        fi
+    fi
+done
+
+echo ""
+if [ "$tests_failed" -eq 0 ];
+then
+    echo -e "[+] SUMMARY: ${COLOR_GREEN}passed: $tests_passed, failed: $tests_failed${COLOR_NC}"
+    exit 0
+else
+    echo -e "[-] SUMMARY: ${COLOR_RED}passed: $tests_passed, failed: $tests_failed${COLOR_NC}"
+    exit 1
+fi
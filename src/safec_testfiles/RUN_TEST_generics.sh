@@ -0,0 +1,74 @@
+#!/bin/bash
+
+# very quick & dirty test for now...
+# generates the C code of all generic test files together (the function
+# instances are defined by the first file using them) and compares it
+
+SCRIPT_NAME=$(basename "$0")
+TMP_FILE_PREFIX=/tmp/safec_generics_test_file_
+GENERATED_DIR=testfiles_generated_generics
+GENERATED_C_SOURCE_DIR=/tmp/safec_generics
+
+if [ -z "$SAFEC_PATH" ];
+then
+    SAFEC_PATH=../../build/bin/SafeCTranspiler
+fi
+
+if [ ! -d "$GENERATED_C_SOURCE_DIR" ];
+then
+    echo "Creating C source generation dir: $GENERATED_C_SOURCE_DIR..."
+    mkdir $GENERATED_C_SOURCE_DIR
+fi
+
+GENERICS_FILE_PREFIX="GENERIC_"
+
+COLOR_RED="\033[31m"
+COLOR_GREEN="\033[32m"
+COLOR_NC="\033[0m"
+
+tests_passed=0
+tests_failed=0
+
+files_to_parse=""
+for file in `ls $GENERICS_FILE_PREFIX*`;
+do
+    files_to_parse="$files_to_parse -f $file"
+done
+
+$($SAFEC_PATH $files_to_parse -o $GENERATED_C_SOURCE_DIR -n --generate > /dev/null)
+
+for file in `ls $GENERICS_FILE_PREFIX*`;
+do
+    FILE_GENERATED_NAME="${file%.sc}.c"
+
+    FILE_GENERATED="$GENERATED_DIR/$FILE_GENERATED_NAME"
+    if [ -e "$FILE_GENERATED" ];
+    then
+        echo "[+] generics for $FILE_GENERATED_NAME..."
+        cp "$GENERATED_C_SOURCE_DIR/$FILE_GENERATED_NAME" $TMP_FILE_PREFIX$FILE_GENERATED_NAME
+        diff_output=`diff -q $FILE_GENERATED $TMP_FILE_PREFIX$FILE_GENERATED_NAME`
+        if [ "$diff_output" = "" ];
+        then
+            echo -e "[+] ${COLOR_GREEN}passed${COLOR_NC}"
+            ((tests_passed++))
+        else
+            echo -e "[-] ${COLOR_RED}FAILED${COLOR_NC}"
+            echo "[-]    run to see differences:"
+            echo "[-]     - diff $FILE_GENERATED $TMP_FILE_PREFIX$FILE_GENERATED_NAME"
+            echo "[-]     - kdiff3 $FILE_GENERATED $TMP_FILE_PREFIX$FILE_GENERATED_NAME"
+            echo "[-]    run to regenerate:"
+            echo "[-]     - $SAFEC_PATH $files_to_parse -o $GENERATED_DIR -n --generate"
+            ((tests_failed++))
+        fi
+    fi
+done
+
+echo ""
+if [ "$tests_failed" -eq 0 ];
+then
+    echo -e "[+] SUMMARY: ${COLOR_GREEN}passed: $tests_passed, failed: $tests_failed${COLOR_NC}"
+    exit 0
+else
+    echo -e "[-] SUMMARY: ${COLOR_RED}passed: $tests_passed, failed: $tests_failed${COLOR_NC}"
+    exit 1
+fi
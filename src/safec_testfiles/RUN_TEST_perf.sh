@@ -0,0 +1,155 @@
+#!/bin/bash
+
+# Performance regression check - transpiles a fixed corpus a few times,
+# takes the best time of each phase and compares the results with the
+# checked-in baseline. Only builds of the baseline profile are compared.
+#
+# regen baseline (release build on the reference machine):
+#   bash RUN_TEST_perf.sh regen
+#
+# SAFEC_PERF_THRESHOLD      - allowed slowdown of a phase in percent
+# SAFEC_PERF_MEM_THRESHOLD  - allowed peak memory growth in percent
+
+SCRIPT_NAME=$(basename "$0")
+PERF_DIR=testfiles_perf
+PERF_CORPUS=$PERF_DIR/perf_corpus.sc
+PERF_BASELINE=$PERF_DIR/perf_baseline.json
+PERF_RUNS=5
+TMP_DIR=/tmp/safec_perf_test
+
+# phases shorter than this are mostly noise, their limit is computed
+# from the floor instead of the baseline value
+PERF_FLOOR_US=2000
+
+if [ -z "$SAFEC_PATH" ];
+then
+    SAFEC_PATH=../../build/bin/SafeCTranspiler
+fi
+
+if [ -z "$SAFEC_PERF_THRESHOLD" ];
+then
+    SAFEC_PERF_THRESHOLD=100
+fi
+
+if [ -z "$SAFEC_PERF_MEM_THRESHOLD" ];
+then
+    SAFEC_PERF_MEM_THRESHOLD=20
+fi
+
+COLOR_RED="\033[31m"
+COLOR_GREEN="\033[32m"
+COLOR_NC="\033[0m"
+
+mkdir -p $TMP_DIR
+
+declare -A results
+declare -a phases
+build_profile=""
+
+for ((run = 0; run < PERF_RUNS; run++));
+do
+    $SAFEC_PATH -f $PERF_CORPUS -o $TMP_DIR -n -t --generate > $TMP_DIR/log.txt
+    if [ $? -ne 0 ];
+    then
+        echo -e "[-] ${COLOR_RED}FAILED${COLOR_NC} - transpiler failed on $PERF_CORPUS"
+        echo -e "[-] SUMMARY: ${COLOR_RED}passed: 0, failed: 1${COLOR_NC}"
+        exit 1
+    fi
+
+    build_profile=$(grep -oP "^Timings \(\K[a-z]+" $TMP_DIR/log.txt)
+
+    # timings are printed as "<tab><phase> <value>" lines
+    while read -r phase value;
+    do
+        if [ -z "${results[$phase]}" ];
+        then
+            phases+=($phase)
+            results[$phase]=$value
+        elif [ "$value" -lt "${results[$phase]}" ];
+        then
+            results[$phase]=$value
+        fi
+    done < <(grep -P "^\t" $TMP_DIR/log.txt | tr -d '\r')
+done
+
+if [ "$1" = "regen" ];
+then
+    echo -e "${COLOR_RED}REGENERATING PERF BASELINE${COLOR_NC}"
+
+    {
+        echo "{"
+        echo "    \"profile\": \"$build_profile\","
+        echo "    \"phases\": {"
+        for ((idx = 0; idx < ${#phases[@]}; idx++));
+        do
+            separator=","
+            if [ $((idx + 1)) -eq ${#phases[@]} ];
+            then
+                separator=""
+            fi
+            echo "        \"${phases[$idx]}\": ${results[${phases[$idx]}]}$separator"
+        done
+        echo "    }"
+        echo "}"
+    } > $PERF_BASELINE
+
+    echo -e "${COLOR_GREEN}REGENERATING PERF BASELINE DONE${COLOR_NC}"
+    exit 0
+fi
+
+baseline_profile=$(grep -oP '"profile": "\K[^"]+' $PERF_BASELINE)
+if [ "$baseline_profile" != "$build_profile" ];
+then
+    echo "[+] Skipped - baseline is for the '$baseline_profile' build, transpiler is '$build_profile'"
+    echo ""
+    echo -e "[+] SUMMARY: ${COLOR_GREEN}passed: 0, failed: 0${COLOR_NC}"
+    exit 0
+fi
+
+tests_passed=0
+tests_failed=0
+
+while read -r phase baseline;
+do
+    current=${results[$phase]}
+    if [ -z "$current" ];
+    then
+        echo -e "[-] ${COLOR_RED}FAILED${COLOR_NC} - phase $phase not reported"
+        ((tests_failed++))
+        continue
+    fi
+
+    if [ "$phase" = "peak_memory_kb" ];
+    then
+        limit=$((baseline * (100 + SAFEC_PERF_MEM_THRESHOLD) / 100))
+    else
+        reference=$baseline
+        if [ "$reference" -lt "$PERF_FLOOR_US" ];
+        then
+            reference=$PERF_FLOOR_US
+        fi
+        limit=$((reference * (100 + SAFEC_PERF_THRESHOLD) / 100))
+    fi
+
+    echo "[+] Perf check for $phase: $current (baseline: $baseline, limit: $limit)..."
+    if [ "$current" -le "$limit" ];
+    then
+        echo -e "[+] ${COLOR_GREEN}passed${COLOR_NC}"
+        ((tests_passed++))
+    else
+        echo -e "[-] ${COLOR_RED}FAILED${COLOR_NC}"
+        echo "[-]    if the slowdown is expected, run to regenerate:"
+        echo "[-]     - bash $SCRIPT_NAME regen"
+        ((tests_failed++))
+    fi
+done < <(sed -nE 's/^\s+"([a-z_]+)": ([0-9]+),?$/\1 \2/p' $PERF_BASELINE)
+
+echo ""
+if [ "$tests_failed" -eq 0 ];
+then
+    echo -e "[+] SUMMARY: ${COLOR_GREEN}passed: $tests_passed, failed: $tests_failed${COLOR_NC}"
+    exit 0
+else
+    echo -e "[-] SUMMARY: ${COLOR_RED}passed: $tests_passed, failed: $tests_failed${COLOR_NC}"
+    exit 1
+fi
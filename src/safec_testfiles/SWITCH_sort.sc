@@ -0,0 +1,196 @@
+#define CMD_READ 3
+#define CMD_WRITE 1
+#define CMD_ERASE 4U
+
+enum color
+{
+    RED,
+    GREEN
+};
+
+int classify(int value)
+{
+    int result = 0;
+
+    /* reordered, the stacked labels and "default" move with their blocks */
+    switch (value)
+    {
+        case 7:
+            result = 70;
+            break;
+        case 2:
+        case 1:
+            result = 10;
+            break;
+        default:
+            result = -1;
+            break;
+        case 5:
+        {
+            result = 50;
+            break;
+        }
+    }
+
+    return result;
+}
+
+int command(int cmd)
+{
+    /* the labels are macros */
+    switch (cmd)
+    {
+        case CMD_ERASE:
+            return 4;
+        case CMD_READ:
+            return 3;
+        case CMD_WRITE:
+            return 1;
+    }
+
+    return 0;
+}
+
+int fallthrough(int value)
+{
+    int result = 0;
+
+    /* not sorted - case 3 falls through to case 1 */
+    switch (value)
+    {
+        case 3:
+            result++;
+        case 1:
+            result++;
+            break;
+        case 0:
+            result = 0;
+            break;
+    }
+
+    return result;
+}
+
+int sparse(unsigned int value)
+{
+    int result = 0;
+
+    /* sorted, but no jump table for the range */
+    switch (value)
+    {
+        case 1000U:
+            result = 3;
+            break;
+        case 10U:
+            result = 2;
+            break;
+        case 1U:
+            result = 1;
+            break;
+    }
+
+    return result;
+}
+
+int in_order(int value)
+{
+    int result = 0;
+
+    /* already sorted, the last block can end the switch */
+    switch (value)
+    {
+        case -1:
+            result = 1;
+            break;
+        case 0:
+            result = 2;
+            break;
+        default:
+            result = 3;
+    }
+
+    return result;
+}
+
+int unknown(enum color value)
+{
+    int result = 0;
+
+    /* not sorted - the enumerators are not known */
+    switch (value)
+    {
+        case GREEN:
+            result = 2;
+            break;
+        case RED:
+            result = 1;
+            break;
+    }
+
+    return result;
+}
+
+int nested(int outer, int inner)
+{
+    int result = 0;
+
+    /* the inner switch is sorted, the outer one is left as it is */
+    switch (outer)
+    {
+        case 2:
+            switch (inner)
+            {
+                case 9:
+                    result = 9;
+                    break;
+                case 8:
+                    result = 8;
+                    break;
+            }
+            break;
+        case 1:
+            result = 1;
+            break;
+    }
+
+    return result;
+}
+
+int loop_exit(int x)
+{
+    int y = 0;
+
+    /* the break leaves the loop, case 3 falls through to case 1 */
+    switch (x)
+    {
+        case 3:
+            do
+            {
+                y++;
+                break;
+            } while (1);
+        case 1:
+            y += 10;
+            break;
+        default:
+            break;
+    }
+
+    return y;
+}
+
+int main(void)
+{
+    int sum = 0;
+
+    sum += classify(5);
+    sum += command(CMD_READ);
+    sum += fallthrough(3);
+    sum += sparse(10U);
+    sum += in_order(0);
+    sum += unknown(GREEN);
+    sum += nested(2, 9);
+    sum += loop_exit(3);
+
+    return sum;
+}
@@ -0,0 +1,170 @@
+#ifndef SAFEC_BOUNDS_CHECK
+#include <assert.h>
+#define SAFEC_BOUNDS_CHECK(index, size) assert(((index) >= 0) && ((index) < (size)))
+#define SAFEC_BOUNDS_CHECK_RANGE(first, end, size) \
+    assert(((first) >= (end)) || (((first) >= 0) && ((end) <= (size))))
+#endif
+
+#define N 8
+
+int g[4];
+int count;
+
+int Next(void);
+
+void Loops(int n)
+{
+    int a[10];
+    int b[N];
+    int c[] = { 1, 2, 3 };
+    int i = 0;
+
+    /* in range, nothing to check */
+    for (i = 0; i < 10; i++)
+    {
+        a[i] = i;
+    }
+
+    /* one check per array before the loop */
+    SAFEC_BOUNDS_CHECK_RANGE(0, n, 10);
+    SAFEC_BOUNDS_CHECK_RANGE(1, (n + 1), 3);
+    SAFEC_BOUNDS_CHECK_RANGE(0, n, N);
+    for (i = 0; i < n; ++i)
+    {
+        a[i] = c[i + 1];
+        b[i] = a[i];
+    }
+
+    SAFEC_BOUNDS_CHECK_RANGE(0, ((N + 1) - 1), N);
+    for (i = 1; i <= N; i++)
+    {
+        b[i - 1] = i;
+    }
+
+    /* the index changes in the loop, checked at the access */
+    for (i = 0; i < n; i++)
+    {
+        SAFEC_BOUNDS_CHECK(i, 10);
+        a[i] = 0;
+        i = i + 1;
+    }
+
+    /* the global bound can change in the call */
+    for (i = 0; i < count; i++)
+    {
+        SAFEC_BOUNDS_CHECK(i, 4);
+        g[i] = Next();
+    }
+
+    /* not on every iteration */
+    for (i = 0; i < n; i++)
+    {
+        if (i == 3)
+        {
+            break;
+        }
+
+        SAFEC_BOUNDS_CHECK(i, 10);
+        a[i] = 0;
+    }
+
+    while (i < 3)
+    {
+        SAFEC_BOUNDS_CHECK(i, 3);
+        c[i] = 0;
+        i++;
+    }
+}
+
+void Aliased(int n)
+{
+    int a[10];
+    int i = 0;
+    int *p = &i;
+
+    /* the index can change through the pointer, checked at the access */
+    for (i = 0; i < n; i++)
+    {
+        SAFEC_BOUNDS_CHECK(i, 10);
+        a[i] = 0;
+        *p = *p + 1;
+    }
+}
+
+int Find(int n, int key)
+{
+    int a[10];
+    int i;
+
+    /* the search stops at the key, the range to n is not checked */
+    for (i = 0; i < n; i++)
+    {
+        SAFEC_BOUNDS_CHECK(i, 10);
+        if (a[i] == key)
+        {
+            return i;
+        }
+    }
+
+    /* a break of a nested loop does not leave the loop */
+    SAFEC_BOUNDS_CHECK_RANGE(0, n, 10);
+    for (i = 0; i < n; i++)
+    {
+        a[i] = key;
+        while (Next())
+        {
+            break;
+        }
+    }
+
+    return -1;
+}
+
+void Unchecked(int n)
+{
+    int a[10];
+    int m[2][3];
+
+    /* only counted: the deferred access above and the second index */
+    SAFEC_BOUNDS_CHECK(n, 2);
+    m[n][n + 1] = 1;
+ a[n] = 0;;
+}
+
+int Accesses(int n, int p[])
+{
+    int a[10];
+    int m[2][3];
+    int k = a[n];
+
+    a[3] = a[9];
+    SAFEC_BOUNDS_CHECK((n - 1), 10);
+    SAFEC_BOUNDS_CHECK(n, 4);
+    k = a[n - 1] + g[n];
+    m[1][2] = p[n];
+    SAFEC_BOUNDS_CHECK(n, 10);
+    SAFEC_BOUNDS_CHECK(a[n], 10);
+    a[a[n]] = 0;
+    a[n++] = 0;
+
+    SAFEC_BOUNDS_CHECK(n, 10);
+    if (a[n] == 0)
+    {
+        return (n > 0) && (a[n - 1] == 0);
+    }
+
+    SAFEC_BOUNDS_CHECK(k, 10);
+    switch (a[k])
+    {
+        case 1:
+            k = a[k + 1];
+            break;
+        default:
+            break;
+    }
+
+    {
+        int a = 0;
+        return a + n;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(cond) if (!(cond)) goto fail
+
+int parse(const char *text)
+{
+    int value = 0;
+
+    switch (text[0])
+    {
+        case 'a':
+            value = 1;
+            break;
+        case 'b':
+        {
+            value = 3;
+            return value;
+        }
+        default:
+            break;
+    }
+
+    return value;
+}
+
+int sum(int *values, int count)
+{
+    int i;
+    int result = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        if (values[i] < 0)
+        {
+            continue;
+        }
+
+        result += values[i];
+    }
+
+    return result;
+}
+
+int load(const char *path)
+{
+    int safec_defer_ret;
+    char *buffer = malloc(64);
+
+    CHECK(path != NULL);
+    CHECK(buffer != NULL);
+
+    printf("loading %s\n", path);
+    { safec_defer_ret = 0; safec_defer_tail_130: free(buffer); return safec_defer_ret; }
+
+fail:
+    printf("failed\n");
+    { safec_defer_ret = -1; goto safec_defer_tail_130; }
+}
+
+int trace(int level)
+{
+    if (level > 2)
+    {
+        return level;
+    }
+
+    return 0;
+#ifdef TRACE_ALL
+    printf("level %d\n", level);
+    return 1;
+#endif
+}
+
+int next(void)
+{
+    return 7;
+}
+
+/* the exits in the do-while body leave the loop, not the function */
+int retry(int x)
+{
+    int n = 0;
+    do
+    {
+        n += next();
+        if (n > x)
+        {
+            continue;
+        }
+        break;
+    } while (n < 100);
+    n = n * 2;
+    return n;
+}
+
+int main(void)
+{
+    int values[4] = {1, -2, 3, -4};
+
+    {
+        printf("%d\n", sum(values, 4));
+        return parse("a") + load("file") + trace(1) + retry(20);
+    }
+}
\ No newline at end of file
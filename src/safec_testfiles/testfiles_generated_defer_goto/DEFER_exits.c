@@ -0,0 +1,216 @@
+#include <stdio.h>
+
+// early exits out of the scopes with armed defers
+
+static const char *NAME(int param)
+{
+    const char * safec_defer_ret;
+
+    if (param == 1)
+    {
+        { safec_defer_ret = "one"; goto safec_defer_6; }
+    }
+
+    { safec_defer_ret = "other"; goto safec_defer_6; }
+    safec_defer_6:
+    printf("name done\n");
+    return safec_defer_ret;
+}
+
+int RETURN_NESTED(int param)
+{
+    int safec_defer_exit = 0;
+    int safec_defer_ret;
+    printf("start\n");
+
+    if (param < 100)
+    {
+        if (param > 50)
+        {
+            { safec_defer_ret = param; safec_defer_exit = 1; goto safec_defer_41; }
+        }
+
+        {
+            if (param == 7)
+            {
+                { safec_defer_ret = 7 * 2; safec_defer_exit = 1; goto safec_defer_55; }
+            }
+            safec_defer_55:
+            printf("innermost\n");
+            if (safec_defer_exit == 1) goto safec_defer_41;
+        }
+        safec_defer_41:
+        printf("inner\n");
+        if (safec_defer_exit == 1) goto safec_defer_30;
+    }
+
+    { safec_defer_ret = 123; safec_defer_exit = 1; goto safec_defer_30; }
+    safec_defer_30:
+    printf("end\n");
+    return safec_defer_ret;
+}
+
+void RETURN_VOID(int param)
+{
+    int safec_defer_exit = 0;
+    if (param)
+    {
+        { safec_defer_exit = 1; goto safec_defer_86; }
+        safec_defer_86:
+        printf("void inner\n");
+        if (safec_defer_exit == 1) goto safec_defer_77;
+    }
+    printf("void fallthrough\n");
+    safec_defer_77:
+    printf("void end\n");
+}
+
+void LOOP_EXITS(int param)
+{
+    int safec_defer_exit = 0;
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        if (i == param)
+        {
+            { safec_defer_exit = 3; goto safec_defer_125; }
+        }
+
+        for (j = 0; j < 3; j++)
+        {
+            if (j == 1)
+            {
+                { safec_defer_exit = 2; goto safec_defer_149; }
+            }
+            safec_defer_149:
+            printf("inner %d\n", j);
+            if (safec_defer_exit == 2) { safec_defer_exit = 0; break; }
+        }
+
+        if (i == 2)
+        {
+            { safec_defer_exit = 2; goto safec_defer_125; }
+        }
+        safec_defer_125:
+        printf("outer %d\n", i);
+        if (safec_defer_exit == 2) { safec_defer_exit = 0; break; }
+        if (safec_defer_exit == 3) { safec_defer_exit = 0; continue; }
+    }
+    printf("loops done\n");
+}
+
+void DO_EXITS(int param)
+{
+    int safec_defer_exit = 0;
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < 2; i++)
+    {
+
+        j = 0;
+        do
+        {
+            j++;
+            if (j == param)
+            {
+                { safec_defer_exit = 3; goto safec_defer_205; }
+            }
+
+            { safec_defer_exit = 2; goto safec_defer_205; }
+            safec_defer_205:
+            printf("do %d\n", j);
+            if (safec_defer_exit == 2) { safec_defer_exit = 0; break; }
+            if (safec_defer_exit == 3) { safec_defer_exit = 0; continue; }
+        } while (j < 3);
+        printf("for %d\n", i);
+    }
+}
+
+int SWITCH_EXITS(int param)
+{
+    int safec_defer_exit = 0;
+    int result = 0;
+    switch (param)
+    {
+        case 0:
+        {
+            result = 10;
+            { safec_defer_exit = 2; goto safec_defer_239; }
+            safec_defer_239:
+            printf("case 0 done\n");
+            if (safec_defer_exit == 2) { safec_defer_exit = 0; break; }
+        }
+
+        default:
+            result = -1;
+            break;
+    }
+
+    return result;
+}
+
+int SHADOWED(int param)
+{
+    int safec_defer_ret;
+    int x = 1;
+
+    if (param)
+    {
+        int x = 2;
+        printf("inner %d\n", x);
+        { safec_defer_ret = 1; goto safec_defer_266; }
+    }
+
+    { safec_defer_ret = 0; goto safec_defer_266; }
+    safec_defer_266:
+    printf("shadowed %d\n", x);
+    return safec_defer_ret;
+}
+
+int EARLY(int param)
+{
+    int safec_defer_ret;
+    if (param == 0)
+    {
+        return 0;
+    }
+    { safec_defer_ret = param; goto safec_defer_302; }
+    safec_defer_302:
+    printf("armed late\n");
+    return safec_defer_ret;
+}
+
+int GOTO_EXITS(int param)
+{
+    int safec_defer_ret;
+    int result = 0;
+
+    {
+        if (param == 1)
+        {
+            { printf("goto inner\n"); goto out; }
+        }
+
+        result = 1;
+        printf("goto inner\n");
+    }
+
+retry:
+    {
+        result++;
+        if (result < 3)
+        {
+            { printf("goto retry %d\n", result); goto retry; }
+        }
+        printf("goto retry %d\n", result);
+    }
+
+out:
+    { safec_defer_ret = result; goto safec_defer_318; }
+    safec_defer_318:
+    printf("goto done\n");
+    return safec_defer_ret;
+}
\ No newline at end of file
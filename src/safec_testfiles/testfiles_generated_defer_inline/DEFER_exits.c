@@ -0,0 +1,177 @@
+#include <stdio.h>
+
+// early exits out of the scopes with armed defers
+
+static const char *NAME(int param)
+{
+    const char * safec_defer_ret;
+
+    if (param == 1)
+    {
+        { safec_defer_ret = "one"; safec_defer_tail_18: printf("name done\n"); return safec_defer_ret; }
+    }
+
+    { safec_defer_ret = "other"; goto safec_defer_tail_18; }
+}
+
+int RETURN_NESTED(int param)
+{
+    int safec_defer_ret;
+    printf("start\n");
+
+    if (param < 100)
+    {
+        if (param > 50)
+        {
+            { safec_defer_ret = param; printf("inner\n"); printf("end\n"); return safec_defer_ret; }
+        }
+
+        {
+            if (param == 7)
+            {
+                { safec_defer_ret = 7 * 2; printf("innermost\n"); printf("inner\n"); printf("end\n"); return safec_defer_ret; }
+            }
+ printf("innermost\n");
+        }
+ printf("inner\n");
+    }
+
+    { safec_defer_ret = 123; printf("end\n"); return safec_defer_ret; }
+}
+
+void RETURN_VOID(int param)
+{
+    if (param)
+    {
+        { printf("void inner\n"); printf("void end\n"); return; }
+    }
+    printf("void fallthrough\n");
+ printf("void end\n");
+}
+
+void LOOP_EXITS(int param)
+{
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        if (i == param)
+        {
+            { printf("outer %d\n", i); continue; }
+        }
+
+        for (j = 0; j < 3; j++)
+        {
+            if (j == 1)
+            {
+                { printf("inner %d\n", j); break; }
+            }
+ printf("inner %d\n", j);
+        }
+
+        if (i == 2)
+        {
+            { printf("outer %d\n", i); break; }
+        }
+ printf("outer %d\n", i);
+    }
+ printf("loops done\n");
+}
+
+void DO_EXITS(int param)
+{
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < 2; i++)
+    {
+
+        j = 0;
+        do
+        {
+            j++;
+            if (j == param)
+            {
+                { printf("do %d\n", j); continue; }
+            }
+
+            { printf("do %d\n", j); break; }
+        } while (j < 3);
+ printf("for %d\n", i);
+    }
+}
+
+int SWITCH_EXITS(int param)
+{
+    int result = 0;
+    switch (param)
+    {
+        case 0:
+        {
+            result = 10;
+            { printf("case 0 done\n"); break; }
+        }
+
+        default:
+            result = -1;
+            break;
+    }
+
+    return result;
+}
+
+int SHADOWED(int param)
+{
+    int safec_defer_ret;
+    int x = 1;
+
+    if (param)
+    {
+        int x = 2;
+        printf("inner %d\n", x);
+        { safec_defer_ret = 1; goto safec_defer_tail_286; }
+    }
+
+    { safec_defer_ret = 0; printf("shadowed %d\n", x); return safec_defer_ret; }
+    if (0) { safec_defer_tail_286: printf("shadowed %d\n", x); return safec_defer_ret; }
+}
+
+int EARLY(int param)
+{
+    int safec_defer_ret;
+    if (param == 0)
+    {
+        return 0;
+    }
+    { safec_defer_ret = param; printf("armed late\n"); return safec_defer_ret; }
+}
+
+int GOTO_EXITS(int param)
+{
+    int safec_defer_ret;
+    int result = 0;
+
+    {
+        if (param == 1)
+        {
+            { printf("goto inner\n"); goto out; }
+        }
+
+        result = 1;
+ printf("goto inner\n");
+    }
+
+retry:
+    {
+        result++;
+        if (result < 3)
+        {
+            { printf("goto retry %d\n", result); goto retry; }
+        }
+ printf("goto retry %d\n", result);
+    }
+
+out:
+    { safec_defer_ret = result; printf("goto done\n"); return safec_defer_ret; }
+}
\ No newline at end of file
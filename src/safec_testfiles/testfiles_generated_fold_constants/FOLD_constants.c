@@ -0,0 +1,60 @@
+#define UART_BASE 0x40001000
+#define REG(offset) (*(volatile unsigned *)(UART_BASE + (offset)))
+
+extern void Use(int value);
+extern void UseUnsigned(unsigned value);
+
+/* a static initializer, folded by every compiler anyway */
+int table[4] = { 4, 12, 5, 0x11 };
+
+void Registers(void)
+{
+    unsigned control = REG(0x40);
+    unsigned status = UART_BASE + 0x20 + 2;
+
+    UseUnsigned(control + status);
+    UseUnsigned(0x1U);
+    UseUnsigned(2147483648U);
+    UseUnsigned(4294967295U);
+}
+
+int Arithmetic(int x)
+{
+    int safec_defer_ret;
+    int a = 86400;
+    int b = 3 * x;
+    int c = x - (-2);
+    int d = x + (-8);
+
+    /* not a constant subexpression, (x - 1) + 2 */
+    Use(x - 1 + 2);
+
+    /* grouping parentheses around the whole expression go too */
+    Use(3);
+    Use(sizeof (int) * 4);
+    Use((int)(4));
+
+    if (a > 60000)
+    {
+        return 3;
+    }
+
+    while (x < 9)
+    {
+        x = x + 1 + 0;
+    }
+
+    { safec_defer_ret = a + b + c + d; Use(1 + 1); return safec_defer_ret; }
+}
+
+int LeftToTheCompiler(void)
+{
+    int overflow = 2147483647 + 1;
+    int byZero = 1 / 0;
+    int negative = -7 / 2;
+    int shift = 1 << 32;
+    long wide = 3000000000 + 1;
+    int character = 'a' + 1;
+
+    return overflow + byZero + negative + shift + (int)wide + character + 6;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+/* generated with --int-width=16, the values of a 16 bit int */
+
+extern void Use(int value);
+extern void UseUnsigned(unsigned value);
+
+
+void Target(void)
+{
+    UseUnsigned(0xFFFFU);
+    UseUnsigned(32768U);
+    UseUnsigned(65535U);
+    Use(0x7FFE);
+    Use((-32767 - 1));
+
+    /* left to the compiler */
+    Use(32767 + 1);
+    Use(40000 - 1);
+    Use(1 << 16);
+}
\ No newline at end of file
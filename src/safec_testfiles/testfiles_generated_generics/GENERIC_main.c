@@ -0,0 +1,107 @@
+#include <stdio.h>
+
+/* generic functions and structs, the instances of the non-static functions
+   used by both GENERIC_ files are defined only once for the program */
+
+extern int Clamp(int value, int low, int high);
+
+struct Pair_int
+{
+    int first;
+    int second;
+};
+
+struct Pair_double
+{
+    double first;
+    double second;
+};
+
+struct Node_char_ptr
+{
+    char * value;
+    struct Node_char_ptr *next;
+};
+
+extern int Max_int(int a, int b);
+extern int PairMax_int(struct Pair_int *pair);
+extern double Max_double(double a, double b);
+extern double PairMax_double(struct Pair_double *pair);
+static int Count_char_ptr(struct Node_char_ptr *node);
+extern unsigned long Max_unsigned_long(unsigned long a, unsigned long b);
+
+int Max_int(int a, int b)
+{
+    if (a > b)
+    {
+        return a;
+    }
+    return b;
+}
+
+int PairMax_int(struct Pair_int *pair)
+{
+    return Max_int(pair->first, pair->second);
+}
+
+double Max_double(double a, double b)
+{
+    if (a > b)
+    {
+        return a;
+    }
+    return b;
+}
+
+double PairMax_double(struct Pair_double *pair)
+{
+    return Max_double(pair->first, pair->second);
+}
+
+static int Count_char_ptr(struct Node_char_ptr *node)
+{
+    int safec_defer_ret;
+    int count = 0;
+
+    while (node != 0)
+    {
+        count++;
+        node = node->next;
+    }
+
+    { safec_defer_ret = count; printf("counted %d\n", count); return safec_defer_ret; }
+}
+
+unsigned long Max_unsigned_long(unsigned long a, unsigned long b)
+{
+    if (a > b)
+    {
+        return a;
+    }
+    return b;
+}
+
+int main(void)
+{
+    struct Pair_int ints;
+    struct Pair_double doubles;
+    struct Node_char_ptr second;
+    struct Node_char_ptr first;
+
+    ints.first = 3;
+    ints.second = 7;
+    doubles.first = 2.5;
+    doubles.second = 1.5;
+
+    second.value = "second";
+    second.next = 0;
+    first.value = "first";
+    first.next = &second;
+
+    printf("%d %.1f\n", PairMax_int(&ints), PairMax_double(&doubles));
+    printf("%d\n", Count_char_ptr(&first));
+    printf("%lu\n", Max_unsigned_long(1, 2));
+    printf("%d\n", Clamp(Max_int(-5, 20), 0, 10));
+
+    return 0;
+}
\ No newline at end of file
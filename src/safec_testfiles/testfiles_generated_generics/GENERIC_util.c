@@ -0,0 +1,19 @@
+/* second file of the program in GENERIC_main.sc, each file has its own
+   copy of the generics it uses - Max_int is defined by GENERIC_main.c */
+
+extern int Min_int(int a, int b);
+extern int Max_int(int a, int b);
+
+int Min_int(int a, int b)
+{
+    if (a < b)
+    {
+        return a;
+    }
+    return b;
+}
+
+int Clamp(int value, int low, int high)
+{
+    return Min_int(Max_int(value, low), high);
+}
\ No newline at end of file
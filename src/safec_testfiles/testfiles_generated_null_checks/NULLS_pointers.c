@@ -0,0 +1,164 @@
+#ifndef SAFEC_NULL_CHECK
+#include <assert.h>
+#define SAFEC_NULL_CHECK(pointer) assert((pointer) != 0)
+#endif
+
+#define NULL 0
+
+struct Node
+{
+    int value;
+    struct Node *next;
+};
+
+struct Node *head;
+
+extern void Use(int value);
+
+int Sum(struct Node *node)
+{
+    int sum = 0;
+
+    /* the condition covers the body */
+    while (node != NULL)
+    {
+        sum = sum + node->value;
+        node = node->next;
+    }
+
+    return sum;
+}
+
+void Assign(int *p, int *q, struct Node *n)
+{
+    int x = 0;
+    int arr[4];
+    int *r = &x;
+
+    /* one check for all the dereferences after it */
+    SAFEC_NULL_CHECK(p);
+    *p = 1;
+    *p = *p + 1;
+    Use(*p);
+
+    /* known from the assignment or the array */
+    *r = 2;
+    r = arr;
+    *r = 3;
+
+    /* checked again after a change */
+    p = q;
+    SAFEC_NULL_CHECK(p);
+    *p = 4;
+
+    /* the pointer changes in the statement */
+    SAFEC_NULL_CHECK(n);
+    q = n->next == NULL ? &x : q;
+    n = n->next;
+    SAFEC_NULL_CHECK(n);
+    n->value = 5;
+}
+
+int Guards(struct Node *n, int *p)
+{
+    if (n == NULL)
+    {
+        return 0;
+    }
+
+    n->value = 1;
+
+    if (p && (*p > 0))
+    {
+        Use(*p);
+    }
+
+    /* not known after the branch */
+    SAFEC_NULL_CHECK(p);
+    *p = 0;
+
+    if (!head)
+    {
+        return n->value;
+    }
+
+    Use(head->value);
+    Use(0);
+    SAFEC_NULL_CHECK(head);
+    return head->value;
+}
+
+void Loops(struct Node *n, int *p)
+{
+    int i;
+
+    SAFEC_NULL_CHECK(p);
+    *p = 0;
+
+    /* p does not change in the loop */
+    for (i = 0; i < 3; i++)
+    {
+        *p = *p + i;
+    }
+
+    for (; n; n = n->next)
+    {
+        n->value = *p;
+    }
+
+    switch (*p)
+    {
+        case 1:
+            SAFEC_NULL_CHECK(n);
+            n->value = 1;
+            break;
+        default:
+            *p = 0;
+            break;
+    }
+
+    *p = 1;
+}
+
+struct Holder
+{
+    int *p;
+    struct Node *node;
+};
+
+/* the members are not tracked, only the plain pointers are checked */
+void Members(struct Holder h, struct Holder *ph)
+{
+    *h.p = 1;
+    h.node->value = 2;
+    SAFEC_NULL_CHECK(ph);
+    ph->node->value = h.p[0];
+    ph->p = h.p;
+}
+
+/* the condition runs after the body, nothing is kept
+   between the statements */
+void Hidden(int *p, int *q)
+{
+    SAFEC_NULL_CHECK(p);
+    *p = 0;
+
+    do
+    {
+        SAFEC_NULL_CHECK(p);
+        SAFEC_NULL_CHECK(q);
+        *p = *p + *q;
+        q = p;
+    } while (*p < 10);
+}
+
+/* the deferred dereference is only counted, a "goto" or "do" in a
+   comment does not stop the tracking */
+void Deferred(int *p)
+{
+
+    SAFEC_NULL_CHECK(p);
+    *p = 0; /* do not goto here */
+    *p = 1;
+ *p = 5;;
+}
\ No newline at end of file
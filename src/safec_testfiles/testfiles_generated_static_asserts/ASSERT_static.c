@@ -0,0 +1,59 @@
+#include <stdio.h>
+
+#define BUFFER_SIZE 64
+#define HEADER_SIZE 8
+
+#ifndef RECORD_COUNT
+#define RECORD_COUNT 4
+#endif
+
+typedef struct
+{
+    int id;
+    char name[16];
+} record_t;
+
+typedef char safec_static_assert_18[(sizeof(record_t) >= 20) ? 1 : -1];
+
+enum color
+{
+    COLOR_RED,
+    COLOR_GREEN,
+    COLOR_COUNT
+};
+
+typedef char safec_static_assert_22[(COLOR_COUNT == 2) ? 1 : -1];
+typedef char safec_static_assert_26[(RECORD_COUNT <= BUFFER_SIZE / HEADER_SIZE) ? 1 : -1];
+
+/* the blocks may not be compiled, left to the compiler */
+#if 0
+typedef char safec_static_assert_32[(BUFFER_SIZE < HEADER_SIZE) ? 1 : -1];
+#endif
+
+#ifndef RECORD_BUFFER
+typedef char safec_static_assert_36[(HEADER_SIZE > 0) ? 1 : -1];
+#else
+typedef char safec_static_assert_40[(HEADER_SIZE == 0) ? 1 : -1];
+#endif
+
+int sum(int *values, int count)
+{
+    int result = 0;
+    int i;
+    typedef char safec_static_assert_62[(sizeof(result) == sizeof(int)) ? 1 : -1];
+
+    for (i = 0; i < count; i++)
+    {
+        result += values[i];
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int values[HEADER_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    printf("%d\n", sum(values, HEADER_SIZE));
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,1604 @@
+// generated by SafeCCorpusGen: functions 25, depth 3, defers 1, switch cases 8, initializer list 16
+
+#include <stdio.h>
+
+int corpus_fn_0(int *data, int len)
+{
+    int values_0[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(0, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(0, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(0, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(0, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_1(int *data, int len)
+{
+    int values_1[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(1, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(1, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(1, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(1, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_2(int *data, int len)
+{
+    int values_2[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(2, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(2, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(2, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(2, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_3(int *data, int len)
+{
+    int values_3[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(3, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(3, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(3, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(3, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_4(int *data, int len)
+{
+    int values_4[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(4, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(4, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(4, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(4, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_5(int *data, int len)
+{
+    int values_5[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(5, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(5, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(5, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(5, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_6(int *data, int len)
+{
+    int values_6[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(6, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(6, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(6, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(6, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_7(int *data, int len)
+{
+    int values_7[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(7, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(7, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(7, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(7, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_8(int *data, int len)
+{
+    int values_8[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(8, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(8, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(8, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(8, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_9(int *data, int len)
+{
+    int values_9[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(9, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(9, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(9, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(9, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_10(int *data, int len)
+{
+    int values_10[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(10, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(10, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(10, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(10, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_11(int *data, int len)
+{
+    int values_11[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(11, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(11, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(11, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(11, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_12(int *data, int len)
+{
+    int values_12[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(12, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(12, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(12, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(12, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_13(int *data, int len)
+{
+    int values_13[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(13, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(13, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(13, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(13, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_14(int *data, int len)
+{
+    int values_14[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(14, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(14, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(14, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(14, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_15(int *data, int len)
+{
+    int values_15[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(15, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(15, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(15, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(15, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_16(int *data, int len)
+{
+    int values_16[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(16, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(16, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(16, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(16, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_17(int *data, int len)
+{
+    int values_17[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(17, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(17, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(17, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(17, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_18(int *data, int len)
+{
+    int values_18[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(18, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(18, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(18, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(18, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_19(int *data, int len)
+{
+    int values_19[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(19, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(19, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(19, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(19, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_20(int *data, int len)
+{
+    int values_20[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(20, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(20, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(20, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(20, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_21(int *data, int len)
+{
+    int values_21[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(21, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(21, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(21, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(21, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_22(int *data, int len)
+{
+    int values_22[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(22, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(22, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(22, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(22, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_23(int *data, int len)
+{
+    int values_23[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(23, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(23, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(23, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(23, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
+int corpus_fn_24(int *data, int len)
+{
+    int values_24[] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    int result = 0;
+    int i1;
+    int i2;
+    int i3;
+    defer release(24, 0, 0);
+
+    for (i1 = 0; i1 < len; i1++)
+    {
+        defer release(24, 1, 0);
+        result += data[1];
+        while (result < 200)
+        {
+            defer release(24, 2, 0);
+            result += data[2];
+            if (len > 3)
+            {
+                defer release(24, 3, 0);
+                result += data[3];
+                if (result < 0)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    switch (len)
+    {
+        case 0:
+            result += 0;
+            break;
+        case 1:
+            result += 1;
+            break;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result += 3;
+            break;
+        case 4:
+            result += 4;
+            break;
+        case 5:
+            result += 5;
+            break;
+        case 6:
+            result += 6;
+            break;
+        case 7:
+            result += 7;
+            break;
+        default:
+            break;
+    }
+
+    return result;
+}
+
@@ -2,14 +2,15 @@
 
 using namespace safec;
 
-uint32_t SemNode::mIdGlobal = 0;
-
 SemNode::SemNode() //
     : mType{Type::Undefined}
     , mSemStart{0}
     , mSemEnd{0}
-    , mId{mIdGlobal++}
+    , mId{kInvalidId}
     , mDirty{DirtyType::Clean}
+    , mParent{nullptr}
+    , mIndexInParent{kInvalidIndex}
+    , mShared{false}
 {
 }
 
@@ -17,11 +18,32 @@ SemNode::SemNode(const SemNode::Type type) //
     : mType{type}
     , mSemStart{0}
     , mSemEnd{0}
-    , mId{mIdGlobal++}
+    , mId{kInvalidId}
     , mDirty{DirtyType::Clean}
+    , mParent{nullptr}
+    , mIndexInParent{kInvalidIndex}
+    , mShared{false}
 {
 }
 
+SemNode::SemNode(const SemNode &other) //
+    : mType{other.mType}
+    , mRelatedNodes{other.mRelatedNodes}
+    , mSemStart{other.mSemStart}
+    , mSemEnd{other.mSemEnd}
+    , mId{kInvalidId}
+    , mDirty{other.mDirty}
+    , mParent{nullptr}
+    , mIndexInParent{kInvalidIndex}
+    , mShared{false}
+{
+    // the children are not copied, until one of the copies modifies them
+    for (auto &it : mRelatedNodes)
+    {
+        it->mShared = true;
+    }
+}
+
 void SemNode::reset()
 {
     mRelatedNodes.clear();
@@ -33,6 +55,11 @@ SemNode::Type SemNode::getType() const
 }
 
 std::string_view SemNode::getTypeStr() const
+{
+    return typeToStr(mType);
+}
+
+std::string_view SemNode::typeToStr(const Type type)
 {
     // clang-format off
     #define SEMNODE_TYPE_SELECTOR_VALUE_TO_STR(x)                                                                          \
@@ -43,7 +70,7 @@ std::string_view SemNode::getTypeStr() const
         break;
     // clang-format on
 
-    switch (mType)
+    switch (type)
     {
         SEMNODE_TYPE_ENUMERATE(SEMNODE_TYPE_SELECTOR_VALUE_TO_STR)
     }
@@ -53,9 +80,144 @@ std::string_view SemNode::getTypeStr() const
 
 void SemNode::attach(std::shared_ptr<SemNode> node)
 {
+    adopt(*node, static_cast<uint32_t>(mRelatedNodes.size()));
     mRelatedNodes.push_back(node);
 }
 
+void SemNode::attachShared(std::shared_ptr<SemNode> node)
+{
+    mRelatedNodes.push_back(node);
+}
+
+SemNode *SemNode::getParent() const
+{
+    return mParent;
+}
+
+uint32_t SemNode::getIndexInParent() const
+{
+    assert(mParent != nullptr);
+    assert(mIndexInParent < mParent->mRelatedNodes.size());
+    assert(mParent->mRelatedNodes[mIndexInParent].get() == this);
+
+    return mIndexInParent;
+}
+
+void SemNode::insertChild(const uint32_t index, std::shared_ptr<SemNode> node)
+{
+    assert(index <= mRelatedNodes.size());
+
+    adopt(*node, index);
+    mRelatedNodes.insert(mRelatedNodes.begin() + index, node);
+    reindexChildren(index + 1U);
+}
+
+std::shared_ptr<SemNode> SemNode::detachChild(const uint32_t index)
+{
+    assert(index < mRelatedNodes.size());
+
+    auto node = mRelatedNodes[index];
+    mRelatedNodes.erase(mRelatedNodes.begin() + index);
+    reindexChildren(index);
+
+    if (node->mParent == this)
+    {
+        node->mParent = nullptr;
+        node->mIndexInParent = kInvalidIndex;
+    }
+
+    return node;
+}
+
+std::shared_ptr<SemNode> SemNode::replaceChild(const uint32_t index, std::shared_ptr<SemNode> node)
+{
+    assert(index < mRelatedNodes.size());
+
+    auto replaced = mRelatedNodes[index];
+    if (replaced->mParent == this)
+    {
+        replaced->mParent = nullptr;
+        replaced->mIndexInParent = kInvalidIndex;
+    }
+
+    adopt(*node, index);
+    mRelatedNodes[index] = node;
+    childReplaced(*replaced, node);
+
+    return replaced;
+}
+
+std::shared_ptr<SemNode> SemNode::getMutableChild(const uint32_t index)
+{
+    assert(index < mRelatedNodes.size());
+
+    auto child = mRelatedNodes[index];
+    if (child->mShared == false)
+    {
+        return child;
+    }
+
+    // the shared child stays with the other copies, this one gets its own
+    // (shallow, the grandchildren become shared in turn)
+    auto copy = child->clone();
+    if (child->mParent == this)
+    {
+        child->mParent = nullptr;
+        child->mIndexInParent = kInvalidIndex;
+    }
+
+    adopt(*copy, index);
+    mRelatedNodes[index] = copy;
+    childReplaced(*child, copy);
+
+    return copy;
+}
+
+bool SemNode::getIsShared() const
+{
+    return mShared;
+}
+
+void SemNode::insertBefore(std::shared_ptr<SemNode> node)
+{
+    mParent->insertChild(getIndexInParent(), node);
+}
+
+void SemNode::insertAfter(std::shared_ptr<SemNode> node)
+{
+    mParent->insertChild(getIndexInParent() + 1U, node);
+}
+
+std::shared_ptr<SemNode> SemNode::replaceWith(std::shared_ptr<SemNode> node)
+{
+    return mParent->replaceChild(getIndexInParent(), node);
+}
+
+std::shared_ptr<SemNode> SemNode::detach()
+{
+    return mParent->detachChild(getIndexInParent());
+}
+
+void SemNode::adopt(SemNode &node, const uint32_t index)
+{
+    node.mParent = this;
+    node.mIndexInParent = index;
+}
+
+void SemNode::reindexChildren(const uint32_t fromIndex)
+{
+    for (uint32_t i = fromIndex; i < mRelatedNodes.size(); i++)
+    {
+        auto &it = mRelatedNodes[i];
+
+        // children shared with a clone are indexed in their own parent
+        if (it->mParent == this)
+        {
+            it->mIndexInParent = i;
+        }
+    }
+}
+
 void SemNode::setSemStart(const uint32_t i)
 {
     mSemStart = i;
@@ -81,6 +243,11 @@ uint32_t SemNode::getId() const
     return mId;
 }
 
+void SemNode::setId(const uint32_t id)
+{
+    mId = id;
+}
+
 void SemNode::setDirty(const DirtyType dirty)
 {
     mDirty = dirty;
@@ -89,9 +256,9 @@ void SemNode::setDirty(const DirtyType dirty)
     // the type is removed
     if (dirty == DirtyType::Removed)
     {
-        for (auto &it : mRelatedNodes)
+        for (uint32_t i = 0; i < mRelatedNodes.size(); i++)
         {
-            it->setDirty(dirty);
+            getMutableChild(i)->setDirty(dirty);
         }
     }
 }
@@ -116,6 +283,53 @@ std::filesystem::path SemNodeTranslationUnit::getSourcePath() const
     return mSourcePath;
 }
 
+void SemNodeTranslationUnit::registerNode(std::shared_ptr<SemNode> node)
+{
+    assert(node);
+    if (node->getId() != kInvalidId)
+    {
+        return; // already registered
+    }
+
+    node->setId(static_cast<uint32_t>(mNodes.size()));
+    mNodes.push_back(node);
+
+    for (auto &it : node->getAttachedNodes())
+    {
+        registerNode(it);
+    }
+}
+
+void SemNodeTranslationUnit::registerSubtree(std::shared_ptr<SemNode> node)
+{
+    assert(node);
+    if (node->getId() == kInvalidId)
+    {
+        node->setId(static_cast<uint32_t>(mNodes.size()));
+        mNodes.push_back(node);
+    }
+
+    for (auto &it : node->getAttachedNodes())
+    {
+        registerSubtree(it);
+    }
+}
+
+std::shared_ptr<SemNode> SemNodeTranslationUnit::getNodeById(const uint32_t id) const
+{
+    if (id >= mNodes.size())
+    {
+        return nullptr;
+    }
+
+    return mNodes[id].lock();
+}
+
+uint32_t SemNodeTranslationUnit::getNodeCount() const
+{
+    return static_cast<uint32_t>(mNodes.size());
+}
+
 SemNodeScope::SemNodeScope(const uint32_t start) //
     : mStartIndex{start}
     , mEndIndex{0}
@@ -245,6 +459,11 @@ std::string SemNodeReturn::toStr() const
     return "";
 }
 
+void SemNodeReturn::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mRhs, oldChild, newChild);
+}
+
 SemNodeIdentifier::SemNodeIdentifier(const uint32_t pos, const std::string &name)
     : SemNodePositional{pos}
     , mName{name}
@@ -295,6 +514,21 @@ void SemNodeDeclaration::appendToType(const std::string &str)
     mLhsType += str;
 }
 
+void SemNodeDeclaration::prependToType(const std::string &str)
+{
+    mLhsType.insert(0, str);
+}
+
+void SemNodeDeclaration::addArrayDimension(std::shared_ptr<SemNode> size)
+{
+    mArrayDimensions.push_back(size);
+}
+
+const std::vector<std::shared_ptr<SemNode>> &SemNodeDeclaration::getArrayDimensions() const
+{
+    return mArrayDimensions;
+}
+
 SemNodePostfixExpression::SemNodePostfixExpression( //
     const uint32_t pos,
     const std::string &op,
@@ -330,6 +564,12 @@ std::string SemNodePostfixExpression::toStr() const
     return mOperator;
 }
 
+void SemNodePostfixExpression::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    // the args are attached to the lhs
+    replaceRef(mLhs, oldChild, newChild);
+}
+
 SemNodeLoop::SemNodeLoop( //
     const uint32_t pos,
     const std::string &loopName)
@@ -400,6 +640,14 @@ std::string SemNodeLoop::toStr() const
            + itChange + ")";
 }
 
+void SemNodeLoop::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mLoopStatementsGroup, oldChild, newChild);
+    replaceRef(mIteratorInit, oldChild, newChild);
+    replaceRef(mIteratorCondition, oldChild, newChild);
+    replaceRef(mIteratorChange, oldChild, newChild);
+}
+
 SemNodeEmptyStatement::SemNodeEmptyStatement(const uint32_t pos)
     : SemNodePositional{pos}
 {
@@ -440,6 +688,12 @@ std::string SemNodeBinaryOp::toStr() const
     return mOp;
 }
 
+void SemNodeBinaryOp::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mLhs, oldChild, newChild);
+    replaceRef(mRhs, oldChild, newChild);
+}
+
 SemNodeIf::SemNodeIf(const uint32_t pos)
     : SemNodeScope{pos}
     , mCond{}
@@ -469,6 +723,12 @@ std::shared_ptr<SemNodeGroup> SemNodeIf::getGroup() const
     return mGroup;
 }
 
+void SemNodeIf::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mCond, oldChild, newChild);
+    replaceRef(mGroup, oldChild, newChild);
+}
+
 SemNodeUnaryOp::SemNodeUnaryOp(const uint32_t pos, const std::string &op)
     : SemNodePositional{pos}
     , mOp{op}
@@ -483,16 +743,28 @@ void SemNodeUnaryOp::setRhs(std::shared_ptr<SemNode> rhs)
     attach(rhs);
 }
 
+std::shared_ptr<SemNode> SemNodeUnaryOp::getRhs() const
+{
+    return mRhs;
+}
+
 std::string SemNodeUnaryOp::toStr() const
 {
     return mOp;
 }
 
+void SemNodeUnaryOp::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mRhs, oldChild, newChild);
+}
+
 SemNodeJumpStatement::SemNodeJumpStatement( //
     const uint32_t pos,
-    const std::string &name)
+    const std::string &name,
+    const std::string &label)
     : SemNodePositional{pos}
     , mName{name}
+    , mLabel{label}
 {
     mType = Type::JumpStatement;
 }
@@ -502,6 +774,11 @@ std::string SemNodeJumpStatement::getName() const
     return mName;
 }
 
+std::string SemNodeJumpStatement::getLabel() const
+{
+    return mLabel;
+}
+
 SemNodeInitializerList::SemNodeInitializerList(const uint32_t pos)
     : SemNodePositional{pos}
 {
@@ -515,7 +792,7 @@ void SemNodeInitializerList::addEntry(std::shared_ptr<SemNode> node)
     attach(node);
 }
 
-std::vector<std::shared_ptr<SemNode>> &SemNodeInitializerList::getEntries()
+SemNode::Children &SemNodeInitializerList::getEntries()
 {
     return mEntries;
 }
@@ -535,6 +812,14 @@ std::string SemNodeInitializerList::toStr() const
     return str;
 }
 
+void SemNodeInitializerList::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    for (auto &it : mEntries)
+    {
+        replaceRef(it, oldChild, newChild);
+    }
+}
+
 SemNodeDefer::SemNodeDefer( //
     const uint32_t pos)
     : SemNodePositional{pos}
@@ -548,6 +833,11 @@ void SemNodeDefer::setDeferredNode(std::shared_ptr<SemNode> deferred)
     attach(deferred);
 }
 
+void SemNodeDefer::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mDeferredNode, oldChild, newChild);
+}
+
 SemNodeSwitchCaseLabel::SemNodeSwitchCaseLabel(const uint32_t pos)
     : SemNodeScope{pos}
     , mIsFallthrough{false}
@@ -576,6 +866,11 @@ bool SemNodeSwitchCaseLabel::getIsFallthrough() const
     return mIsFallthrough;
 }
 
+void SemNodeSwitchCaseLabel::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mCaseLabel, oldChild, newChild);
+}
+
 SemNodeSwitchCase::SemNodeSwitchCase(const uint32_t pos)
     : SemNodeScope{pos}
 {
@@ -599,3 +894,109 @@ std::shared_ptr<SemNode> SemNodeSwitchCase::getSwitchExpr() const
 {
     return mSwitchExpr;
 }
+
+void SemNodeSwitchCase::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mSwitchExpr, oldChild, newChild);
+    replaceRef(mDefaultStatement, oldChild, newChild);
+}
+
+SemNodeGeneratedCode::SemNodeGeneratedCode( //
+    const uint32_t pos,
+    const std::string &code)
+    : SemNodePositional{pos}
+    , mCode{code}
+{
+    mType = SemNode::Type::GeneratedCode;
+    mDirty = DirtyType::Added;
+}
+
+const std::string &SemNodeGeneratedCode::getCode() const
+{
+    return mCode;
+}
+
+SemNodeGeneric::SemNodeGeneric(const uint32_t start) //
+    : SemNodeScope{start}
+    , mParams{}
+    , mHeaderEnd{start}
+{
+    mType = Type::Generic;
+}
+
+void SemNodeGeneric::addParam(const std::string &name)
+{
+    mParams.push_back(name);
+}
+
+void SemNodeGeneric::setHeaderEnd(const uint32_t headerEnd)
+{
+    mHeaderEnd = headerEnd;
+}
+
+const std::vector<std::string> &SemNodeGeneric::getParams() const
+{
+    return mParams;
+}
+
+uint32_t SemNodeGeneric::getHeaderEnd() const
+{
+    return mHeaderEnd;
+}
+
+std::string SemNodeGeneric::toStr() const
+{
+    std::string str{"generic <"};
+    for (size_t i = 0; i < mParams.size(); i++)
+    {
+        str += (i > 0) ? ", " : "";
+        str += mParams[i];
+    }
+
+    return str + ">";
+}
+
+SemNodeGenericInstance::SemNodeGenericInstance(const uint32_t pos, const std::string &name)
+    : SemNodePositional{pos}
+    , mName{name}
+{
+    mType = Type::GenericInstance;
+}
+
+std::string SemNodeGenericInstance::getName() const
+{
+    return mName;
+}
+
+SemNodeStaticAssert::SemNodeStaticAssert(const uint32_t pos)
+    : SemNodePositional{pos}
+    , mCond{}
+{
+    mType = Type::StaticAssert;
+}
+
+void SemNodeStaticAssert::setCond(std::shared_ptr<SemNode> cond)
+{
+    mCond = cond;
+    attach(cond);
+}
+
+void SemNodeStaticAssert::setMessage(const std::string &message)
+{
+    mMessage = message;
+}
+
+std::shared_ptr<SemNode> SemNodeStaticAssert::getCond() const
+{
+    return mCond;
+}
+
+std::string SemNodeStaticAssert::getMessage() const
+{
+    return mMessage;
+}
+
+void SemNodeStaticAssert::childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+{
+    replaceRef(mCond, oldChild, newChild);
+}
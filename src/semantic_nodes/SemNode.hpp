@@ -1,8 +1,10 @@
 #pragma once
 
 #include "SemNodeEnumeration.hpp"
+#include "utils/SmallVector.hpp"
 
 #include <cassert>
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <memory>
@@ -10,6 +12,10 @@
 #include <string_view>
 #include <vector>
 
+#ifndef SAFEC_SEMNODE_INLINE_CHILDREN
+#define SAFEC_SEMNODE_INLINE_CHILDREN 3
+#endif
+
 namespace safec
 {
 
@@ -35,8 +41,18 @@ public:
         Modified
     };
 
+    // ids are dense per translation unit, assigned when the node
+    // is registered in the owning SemNodeTranslationUnit
+    static constexpr uint32_t kInvalidId = UINT32_MAX;
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    // most nodes have at most a few children, keep them in the node
+    using Children = utils::SmallVector<std::shared_ptr<SemNode>, SAFEC_SEMNODE_INLINE_CHILDREN>;
+
     SemNode();
     SemNode(const Type type);
+    SemNode(const SemNode &other); // the copy is not registered and not attached
+    SemNode &operator=(const SemNode &) = delete; // would alias the id of the other node
     virtual ~SemNode() = default;
 
     void reset();
@@ -44,9 +60,43 @@ public:
     Type getType() const;
     std::string_view getTypeStr() const;
 
+    static std::string_view typeToStr(const Type type);
+
     void attach(std::shared_ptr<SemNode> node);
 
-    std::vector<std::shared_ptr<SemNode>> &getAttachedNodes()
+    // attach without becoming the parent, for temporary containers
+    // that are not part of the AST (e.g. lists built while parsing)
+    void attachShared(std::shared_ptr<SemNode> node);
+
+    // Parent of the last attach, nullptr for the root and detached nodes.
+    // Children shared with a clone keep the parent they were attached to.
+    SemNode *getParent() const;
+
+    // position in the parent attached nodes
+    uint32_t getIndexInParent() const;
+
+    // AST editing, keeps the parent links and indices up to date
+    void insertChild(const uint32_t index, std::shared_ptr<SemNode> node);
+    std::shared_ptr<SemNode> detachChild(const uint32_t index);
+    std::shared_ptr<SemNode> replaceChild(const uint32_t index, std::shared_ptr<SemNode> node);
+
+    // Children of a clone are shared with the original until modified.
+    // Returns the child at index, copied first if it is shared.
+    std::shared_ptr<SemNode> getMutableChild(const uint32_t index);
+    bool getIsShared() const;
+
+    // same as above, relative to this node (must have a parent)
+    void insertBefore(std::shared_ptr<SemNode> node);
+    void insertAfter(std::shared_ptr<SemNode> node);
+    std::shared_ptr<SemNode> replaceWith(std::shared_ptr<SemNode> node);
+    std::shared_ptr<SemNode> detach();
+
+    Children &getAttachedNodes()
+    {
+        return mRelatedNodes;
+    }
+
+    const Children &getAttachedNodes() const
     {
         return mRelatedNodes;
     }
@@ -63,6 +113,7 @@ public:
     uint32_t getSemEnd() const;
 
     uint32_t getId() const;
+    void setId(const uint32_t id);
 
     // if the node was modified and the generator
     // needs to know, mark the node as dirty
@@ -78,16 +129,42 @@ public:
 
 protected:
     Type mType;
-    std::vector<std::shared_ptr<SemNode>> mRelatedNodes;
+    Children mRelatedNodes;
 
     uint32_t mSemStart;
     uint32_t mSemEnd;
 
-    static uint32_t mIdGlobal;
     uint32_t mId;
 
     DirtyType mDirty;
 
+    SemNode *mParent; // the parent owns this node
+    uint32_t mIndexInParent;
+
+    // attached to a clone as well, copy before modifying
+    bool mShared;
+
+    void adopt(SemNode &node, const uint32_t index);
+    void reindexChildren(const uint32_t fromIndex);
+
+    // lets the derived nodes update their own references to a child
+    // that was replaced in the attached nodes
+    virtual void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild)
+    {
+    }
+
+    template <typename TSemNode>
+    static void replaceRef( //
+        std::shared_ptr<TSemNode> &ref,
+        const SemNode &oldChild,
+        const std::shared_ptr<SemNode> &newChild)
+    {
+        if (ref.get() == &oldChild)
+        {
+            ref = std::static_pointer_cast<TSemNode>(newChild);
+        }
+    }
+
     friend class SemNodeWalker;
 };
 
@@ -95,6 +172,8 @@ protected:
 class SemNodeUndefined : public SemNode{};
 // clang-format on
 
+// Root of the AST, owns the node id allocation for the whole
+// translation unit.
 class SemNodeTranslationUnit : public SemNode
 {
 public:
@@ -104,6 +183,21 @@ public:
     void setSourcePath(const std::filesystem::path &path);
     std::filesystem::path getSourcePath() const;
 
+    // assigns the next free id to the node and to all of its attached
+    // nodes that were not registered yet (e.g. clones, internal groups)
+    void registerNode(std::shared_ptr<SemNode> node);
+
+    // same as above, but looks for unregistered nodes also below the
+    // registered ones (e.g. copies made when a shared child was modified)
+    void registerSubtree(std::shared_ptr<SemNode> node);
+
+    // O(1) lookup, nullptr if the node was already released
+    std::shared_ptr<SemNode> getNodeById(const uint32_t id) const;
+
+    // upper bound of all ids registered so far, use it to size
+    // id-indexed side tables
+    uint32_t getNodeCount() const;
+
     virtual std::shared_ptr<SemNode> clone() override
     {
         return std::make_shared<SemNodeTranslationUnit>(*this);
@@ -111,6 +205,9 @@ public:
 
 private:
     std::filesystem::path mSourcePath;
+
+    // indexed by node id
+    std::vector<std::weak_ptr<SemNode>> mNodes;
 };
 
 // Semantic node with dual position info (start & end).
@@ -220,6 +317,8 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::shared_ptr<SemNode> mRhs;
 };
 
@@ -277,6 +376,12 @@ public:
     std::string getLhsIdentifier() const;
 
     void appendToType(const std::string &str);
+    void prependToType(const std::string &str);
+
+    // size expression of each array dimension, outermost first,
+    // nullptr if the size is not given (e.g. "int a[]")
+    void addArrayDimension(std::shared_ptr<SemNode> size);
+    const std::vector<std::shared_ptr<SemNode>> &getArrayDimensions() const;
 
     std::string toStr() const override
     {
@@ -291,6 +396,9 @@ public:
 private:
     std::string mLhsType;
     std::string mLhsIdentifier;
+
+    // not attached, the sizes are not a part of the AST walk
+    std::vector<std::shared_ptr<SemNode>> mArrayDimensions;
 };
 
 class SemNodePostfixExpression : public SemNodePositional
@@ -314,10 +422,12 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::string mOperator;
     std::shared_ptr<SemNode> mLhs;
 
-    std::vector<std::shared_ptr<SemNode>> mArgs;
+    Children mArgs;
 };
 
 class SemNodeLoop : public SemNodeScope
@@ -348,6 +458,8 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::string mLoopName;
     std::shared_ptr<SemNodeGroup> mLoopStatementsGroup;
     std::shared_ptr<SemNode> mIteratorInit;
@@ -394,6 +506,8 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::string mOp;
 
     std::shared_ptr<SemNode> mLhs;
@@ -417,6 +531,8 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::shared_ptr<SemNode> mCond;
     std::shared_ptr<SemNodeGroup> mGroup;
 };
@@ -428,6 +544,13 @@ public:
 
     void setRhs(std::shared_ptr<SemNode> rhs);
 
+    std::string getOp() const
+    {
+        return mOp;
+    }
+
+    std::shared_ptr<SemNode> getRhs() const;
+
     std::string toStr() const override;
 
     virtual std::shared_ptr<SemNode> clone() override
@@ -436,6 +559,8 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::string mOp;
     std::shared_ptr<SemNode> mRhs;
 };
@@ -443,13 +568,16 @@ private:
 class SemNodeJumpStatement : public SemNodePositional
 {
 public:
-    SemNodeJumpStatement(const uint32_t pos, const std::string &name);
+    SemNodeJumpStatement(const uint32_t pos, const std::string &name, const std::string &label = {});
 
     std::string getName() const;
 
+    // the label of a goto
+    std::string getLabel() const;
+
     std::string toStr() const override
     {
-        return mName;
+        return mLabel.empty() ? mName : (mName + " " + mLabel);
     }
 
     virtual std::shared_ptr<SemNode> clone() override
@@ -459,6 +587,7 @@ public:
 
 private:
     std::string mName;
+    std::string mLabel;
 };
 
 class SemNodeInitializerList : public SemNodePositional
@@ -468,7 +597,7 @@ public:
 
     void addEntry(std::shared_ptr<SemNode> node);
 
-    std::vector<std::shared_ptr<SemNode>> &getEntries();
+    Children &getEntries();
 
     std::string toStr() const override;
 
@@ -478,7 +607,9 @@ public:
     }
 
 private:
-    std::vector<std::shared_ptr<SemNode>> mEntries;
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
+    Children mEntries;
 };
 
 class SemNodeDefer : public SemNodePositional
@@ -499,6 +630,8 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::shared_ptr<SemNode> mDeferredNode;
 };
 
@@ -528,6 +661,8 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::shared_ptr<SemNode> mCaseLabel;
     bool mIsFallthrough;
 };
@@ -555,8 +690,120 @@ public:
     }
 
 private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
     std::shared_ptr<SemNode> mSwitchExpr;
     std::shared_ptr<SemNode> mDefaultStatement;
 };
 
+// C code synthesized by a lowering pass (not present in the SafeC source).
+// The generator inserts the code into the output at the source position
+// pos - before the source text starting there. Usually has no source range,
+// a removed one is the source replaced by the code (e.g. a folded constant).
+class SemNodeGeneratedCode : public SemNodePositional
+{
+public:
+    SemNodeGeneratedCode(const uint32_t pos, const std::string &code);
+
+    const std::string &getCode() const;
+
+    std::string toStr() const override
+    {
+        return mCode;
+    }
+
+    virtual std::shared_ptr<SemNode> clone() override
+    {
+        return std::make_shared<SemNodeGeneratedCode>(*this);
+    }
+
+private:
+    std::string mCode;
+};
+
+// Generic function or struct definition, "generic <T, U>" followed by the
+// definition. The definition is parsed with the params as type names and
+// attached to this node. It is not emitted, only its instances are - see
+// GenericExpansion.
+class SemNodeGeneric : public SemNodeScope
+{
+public:
+    SemNodeGeneric(const uint32_t start);
+
+    void addParam(const std::string &name);
+    void setHeaderEnd(const uint32_t headerEnd);
+
+    const std::vector<std::string> &getParams() const;
+
+    // end of the "generic <...>" header, the definition follows
+    uint32_t getHeaderEnd() const;
+
+    std::string toStr() const override;
+
+    virtual std::shared_ptr<SemNode> clone() override
+    {
+        return std::make_shared<SemNodeGeneric>(*this);
+    }
+
+private:
+    std::vector<std::string> mParams;
+    uint32_t mHeaderEnd;
+};
+
+// Use of a generic function in an expression, "Name::<type, ...>". The
+// type arguments are taken from the source when the instance is created.
+class SemNodeGenericInstance : public SemNodePositional
+{
+public:
+    SemNodeGenericInstance(const uint32_t pos, const std::string &name);
+
+    std::string getName() const;
+
+    std::string toStr() const override
+    {
+        return mName + "::<>";
+    }
+
+    virtual std::shared_ptr<SemNode> clone() override
+    {
+        return std::make_shared<SemNodeGenericInstance>(*this);
+    }
+
+private:
+    std::string mName;
+};
+
+// "static_assert(condition, message);" declaration, the condition is attached
+// to this node. Evaluated by the generator, the assertions that hold are not
+// emitted - see WalkerStaticAssert.
+class SemNodeStaticAssert : public SemNodePositional
+{
+public:
+    SemNodeStaticAssert(const uint32_t pos);
+
+    void setCond(std::shared_ptr<SemNode> cond);
+    void setMessage(const std::string &message);
+
+    std::shared_ptr<SemNode> getCond() const;
+
+    // the string literal with the quotes, empty if there is none
+    std::string getMessage() const;
+
+    std::string toStr() const override
+    {
+        return "static_assert " + mMessage;
+    }
+
+    virtual std::shared_ptr<SemNode> clone() override
+    {
+        return std::make_shared<SemNodeStaticAssert>(*this);
+    }
+
+private:
+    void childReplaced(const SemNode &oldChild, const std::shared_ptr<SemNode> &newChild) override;
+
+    std::shared_ptr<SemNode> mCond;
+    std::string mMessage;
+};
+
 } // namespace safec
@@ -24,5 +24,9 @@
         selector(Group) \
         selector(Defer) \
         selector(SwitchCase) \
-        selector(SwitchCaseLabel)
+        selector(SwitchCaseLabel) \
+        selector(GeneratedCode) \
+        selector(Generic) \
+        selector(GenericInstance) \
+        selector(StaticAssert)
 // clang-format on
@@ -0,0 +1,108 @@
+#include "SemNodeFlat.hpp"
+
+#include <cassert>
+#include <utility>
+
+namespace safec
+{
+
+SemNodeFlat::SemNodeFlat(const SemNode &root)
+    : mSourcePath{}
+    , mTypes{}
+    , mDirty{}
+    , mSemStarts{}
+    , mSemEnds{}
+    , mLevels{}
+    , mFirstChildren{}
+    , mNextSiblings{}
+    , mIds{}
+    , mGeneratedCode{}
+{
+    if (root.getType() == SemNode::Type::TranslationUnit)
+    {
+        const auto &tu = static_cast<const SemNodeTranslationUnit &>(root);
+        mSourcePath = tu.getSourcePath();
+
+        // ids are dense, the count is a good upper bound of attached nodes
+        const uint32_t nodeCountHint = tu.getNodeCount();
+        mTypes.reserve(nodeCountHint);
+        mDirty.reserve(nodeCountHint);
+        mSemStarts.reserve(nodeCountHint);
+        mSemEnds.reserve(nodeCountHint);
+        mLevels.reserve(nodeCountHint);
+        mFirstChildren.reserve(nodeCountHint);
+        mNextSiblings.reserve(nodeCountHint);
+        mIds.reserve(nodeCountHint);
+    }
+
+    // explicit stack instead of recursion, children are pushed in
+    // reverse so they are popped (and stored) in the walk order
+    std::vector<std::pair<const SemNode *, uint32_t>> pending;
+    pending.emplace_back(&root, 0);
+
+    // index of the last node stored on each level, to link the siblings
+    std::vector<uint32_t> lastOnLevel;
+
+    while (pending.empty() == false)
+    {
+        const auto [node, level] = pending.back();
+        pending.pop_back();
+
+        const uint32_t index = append(*node, level);
+
+        if (lastOnLevel.size() < (level + 2U))
+        {
+            lastOnLevel.resize(level + 2U, kNoIndex);
+        }
+
+        if (level > 0)
+        {
+            const uint32_t parent = lastOnLevel[level - 1U];
+            assert(parent != kNoIndex);
+
+            if (mFirstChildren[parent] == kNoIndex)
+            {
+                mFirstChildren[parent] = index;
+            }
+            else
+            {
+                const uint32_t prevSibling = lastOnLevel[level];
+                assert(prevSibling != kNoIndex);
+                mNextSiblings[prevSibling] = index;
+            }
+        }
+
+        lastOnLevel[level] = index;
+        lastOnLevel[level + 1U] = kNoIndex; // new parent, no children yet
+
+        const auto &children = node->getAttachedNodes();
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+        {
+            pending.emplace_back(it->get(), level + 1U);
+        }
+    }
+}
+
+uint32_t SemNodeFlat::append(const SemNode &node, const uint32_t level)
+{
+    const uint32_t index = getNodeCount();
+
+    mTypes.push_back(node.getType());
+    mDirty.push_back(node.getDirty());
+    mSemStarts.push_back(node.getSemStart());
+    mSemEnds.push_back(node.getSemEnd());
+    mLevels.push_back(level);
+    mFirstChildren.push_back(kNoIndex);
+    mNextSiblings.push_back(kNoIndex);
+    mIds.push_back(node.getId());
+
+    if (node.getType() == SemNode::Type::GeneratedCode)
+    {
+        const auto &generatedCode = static_cast<const SemNodeGeneratedCode &>(node);
+        mGeneratedCode.push_back(GeneratedCode{index, generatedCode.getPos(), generatedCode.getCode()});
+    }
+
+    return index;
+}
+
+} // namespace safec
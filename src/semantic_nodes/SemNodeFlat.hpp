@@ -0,0 +1,113 @@
+#pragma once
+
+#include "SemNode.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace safec
+{
+
+// Flat, structure-of-arrays snapshot of an AST for passes that only need
+// node types, positions and the tree shape. Nodes are stored in the walk
+// (pre-order) order, so iterating the indices 0..getNodeCount() visits the
+// nodes like SemNodeWalker does, but reads a few dense arrays instead of
+// chasing pointers to the individually allocated nodes.
+//
+// The snapshot is not updated when the AST changes, build it after all
+// modifications are committed.
+class SemNodeFlat
+{
+public:
+    static constexpr uint32_t kNoIndex = UINT32_MAX;
+
+    // few nodes carry code, kept aside instead of in a per-node array
+    struct GeneratedCode
+    {
+        uint32_t mIndex;
+        uint32_t mPos;
+        std::string mCode;
+    };
+
+    SemNodeFlat(const SemNode &root);
+
+    uint32_t getNodeCount() const
+    {
+        return static_cast<uint32_t>(mTypes.size());
+    }
+
+    // source path of the root, empty if the root is not a translation unit
+    const std::filesystem::path &getSourcePath() const
+    {
+        return mSourcePath;
+    }
+
+    const std::vector<SemNode::Type> &getTypes() const
+    {
+        return mTypes;
+    }
+
+    const std::vector<SemNode::DirtyType> &getDirty() const
+    {
+        return mDirty;
+    }
+
+    const std::vector<uint32_t> &getSemStarts() const
+    {
+        return mSemStarts;
+    }
+
+    const std::vector<uint32_t> &getSemEnds() const
+    {
+        return mSemEnds;
+    }
+
+    // depth in the tree, root is 0 (same as the walker astLevel)
+    const std::vector<uint32_t> &getLevels() const
+    {
+        return mLevels;
+    }
+
+    // kNoIndex if the node has no children, otherwise always index + 1
+    const std::vector<uint32_t> &getFirstChildren() const
+    {
+        return mFirstChildren;
+    }
+
+    // kNoIndex for the last child of a node
+    const std::vector<uint32_t> &getNextSiblings() const
+    {
+        return mNextSiblings;
+    }
+
+    const std::vector<uint32_t> &getIds() const
+    {
+        return mIds;
+    }
+
+    // all SemNodeGeneratedCode nodes, in the walk order
+    const std::vector<GeneratedCode> &getGeneratedCode() const
+    {
+        return mGeneratedCode;
+    }
+
+private:
+    std::filesystem::path mSourcePath;
+
+    std::vector<SemNode::Type> mTypes;
+    std::vector<SemNode::DirtyType> mDirty;
+    std::vector<uint32_t> mSemStarts;
+    std::vector<uint32_t> mSemEnds;
+    std::vector<uint32_t> mLevels;
+    std::vector<uint32_t> mFirstChildren;
+    std::vector<uint32_t> mNextSiblings;
+    std::vector<uint32_t> mIds;
+
+    std::vector<GeneratedCode> mGeneratedCode;
+
+    uint32_t append(const SemNode &node, const uint32_t level);
+};
+
+} // namespace safec
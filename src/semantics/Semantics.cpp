@@ -9,8 +9,7 @@
 #include <cassert>
 #include <filesystem>
 #include <iostream>
-
-// TODO: typedefs not supported at all, current parser does not recognize the type
+#include <iterator>
 
 namespace safec
 {
@@ -19,24 +18,20 @@ namespace
 {
 
 template <typename TUnderlyingSemNode>
-std::shared_ptr<TUnderlyingSemNode> semNodeConvert(std::shared_ptr<SemNode> &w)
+std::shared_ptr<TUnderlyingSemNode> semNodeConvert(const std::shared_ptr<SemNode> &w)
 {
     return std::static_pointer_cast<TUnderlyingSemNode>(w);
 }
 
 } // namespace
 
-Semantics::Semantics() //
+Semantics::Semantics(const fs::path &path) //
     : mTranslationUnit{std::make_shared<SemNodeTranslationUnit>()}
     , mPrevReducePos{0}
 {
-    mState.addScope(mTranslationUnit);
-}
-
-void Semantics::newTranslationUnit(const fs::path &path)
-{
-    mTranslationUnit->reset();
+    mTranslationUnit->registerNode(mTranslationUnit);
     mTranslationUnit->setSourcePath(path);
+    mState.addScope(mTranslationUnit);
 }
 
 void Semantics::walk(SemNodeWalker &walker, WalkerStrategy &strategy)
@@ -44,770 +39,752 @@ void Semantics::walk(SemNodeWalker &walker, WalkerStrategy &strategy)
     walker.walk(*mTranslationUnit, strategy);
 }
 
-void Semantics::handle( //
+NodeHandle Semantics::handle( //
     const SyntaxChunkType type,
     const uint32_t stringIndex,
-    const std::string &additional)
+    const std::string_view additional,
+    const NodeHandles children)
 {
-    // huge switch..case, but leaving it here as-is for now to keep it simple
-    switch (type)
-    {
-        case SyntaxChunkType::kType:
-            {
-                if (mState.mState == SState::WaitingForStructType)
-                {
-                    // struct consumed - reset state
-                    mState.mState = SState::Idle;
-                }
-                else
-                {
-                    mState.addChunk({type, stringIndex, additional});
-                }
-            }
-            break;
+    // clang-format off
+    #define SYNTAXCHUNKTYPE_HANDLER(x, name) &Semantics::on##name,
+    // clang-format on
 
-        case SyntaxChunkType::kDirectDecl:
-            handleDirectDecl(stringIndex, additional);
-            break;
+    // one handler per chunk type, in the SyntaxChunkType order
+    static constexpr HandlerType handlers[] = {SYNTAXCHUNKTYPE_ENUM(SYNTAXCHUNKTYPE_HANDLER)};
 
-        case SyntaxChunkType::kFunctionHeader:
-            {
-                const bool isVoidRetType = (additional == "void");
-                handleFunctionHeader(stringIndex, isVoidRetType);
-            }
-            break;
-
-        case SyntaxChunkType::kFunction:
-            handleFunctionEnd(stringIndex);
-            break;
+    #undef SYNTAXCHUNKTYPE_HANDLER
 
-        case SyntaxChunkType::kStructOrUnionDecl:
-            mState.getChunks().clear(); // TODO: handle struct declaration
-            mState.mState = SState::WaitingForStructType;
-            break;
+    const auto index = static_cast<uint32_t>(type);
+    assert(index < std::size(handlers));
 
-        case SyntaxChunkType::kPointer:
-            mState.addChunk({type, stringIndex});
-            break;
+    return (this->*handlers[index])(stringIndex, additional, children);
+}
 
-        case SyntaxChunkType::kConstant:
-            {
-                auto node = std::make_shared<SemNodeConstant>(stringIndex, additional);
-                mState.stageNode(node);
-            }
-            break;
+NodeHandle Semantics::onUnknown( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    log("type not handled: %", Color::Red, syntaxChunkTypeToStr(SyntaxChunkType::kUnknown));
+    return kNoNode;
+}
 
-        case SyntaxChunkType::kInitDeclaration:
-            {
-                const bool withAssignment = (additional == "asgn");
-                handleInitDeclaration(stringIndex, withAssignment);
-            }
-            break;
+NodeHandle Semantics::onFunctionHeader( //
+    const uint32_t stringIndex,
+    const std::string_view returnType,
+    const NodeHandles children)
+{
+    auto declNode = getNode<SemNodeDeclaration>(getChild(children, 0));
+    assert(declNode);
+    declNode->prependToType(std::string{returnType});
 
-        case SyntaxChunkType::kAssignment:
-            handleAssignment(stringIndex);
-            break;
+    auto node = makeNode<SemNodeFunction>(stringIndex);
+    node->setReturn(declNode->getLhsType());
+    node->setName(declNode->getLhsIdentifier());
 
-        case SyntaxChunkType::kAssignmentOperator:
-            {
-                auto &stagedNodes = mState.getStagedNodes();
-                auto lhs = stagedNodes.back();
-                stagedNodes.pop_back();
+    node->setSemStart(mPrevReducePos);
+    setPrevReducePos(stringIndex);
 
-                auto node = std::make_shared<SemNodeBinaryOp>(stringIndex, additional, lhs);
+    auto &symbols = mState.getSymbols();
+    symbols.declare(declNode->getLhsIdentifier(), SymbolTable::Kind::Object);
 
-                mState.stageNode(node);
-            }
-            break;
+    addNodeToAst(node);
+    mState.addScope(node);
 
-        case SyntaxChunkType::kIdentifier:
-            {
-                auto node = std::make_shared<SemNodeIdentifier>(stringIndex, additional);
-                mState.stageNode(node);
-            }
-            break;
+    // function params were attached to the declarator
+    for (auto &it : declNode->getAttachedNodes())
+    {
+        assert(it->getType() == SemNode::Type::Declaration);
+        auto nodeDecl = semNodeConvert<SemNodeDeclaration>(it);
+        node->addParam(nodeDecl->getLhsType(), nodeDecl->getLhsIdentifier());
 
-        case SyntaxChunkType::kConditionHeader:
-            {
-                auto nodeIf = std::make_shared<SemNodeIf>(stringIndex);
-                nodeIf->setSemStart(mPrevReducePos);
+        symbols.declare(nodeDecl->getLhsIdentifier(), SymbolTable::Kind::Object);
+    }
 
-                auto ifGroup = nodeIf->getGroup();
-                ifGroup->setSemStart(mPrevReducePos);
+    return kNoNode;
+}
 
-                setPrevReducePos(stringIndex);
-                mState.stageNode(nodeIf);
-            }
-            break;
+NodeHandle Semantics::onFunction( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto currentScopeFun = mState.getCurrentScope();
+    assert(currentScopeFun->getType() == SemNode::Type::Function);
+    auto funScopeNode = semNodeConvert<SemNodeFunction>(currentScopeFun);
+    funScopeNode->setEnd(stringIndex);
 
-        case SyntaxChunkType::kConditionExpression:
-            handleConditionExpression(stringIndex);
-            break;
+    funScopeNode->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-        case SyntaxChunkType::kCondition:
-            {
-                auto currentScope = mState.getCurrentScope();
-                auto scopeNode = semNodeConvert<SemNodeScope>(currentScope);
-                scopeNode->setEnd(stringIndex);
+    mState.removeScope();
 
-                scopeNode->setSemEnd(stringIndex);
-                setPrevReducePos(stringIndex);
+    return kNoNode;
+}
 
-                mState.removeScope();
-            }
-            break;
+NodeHandle Semantics::onDeclaration( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    const std::string_view type,
+    const NodeHandles children)
+{
+    declareList(getChild(children, 0), type, SymbolTable::Kind::Object);
+    return kNoNode;
+}
 
-        case SyntaxChunkType::kForLoopHeader:
-            {
-                mState.mState = SState::InForLoopContext;
-                auto node = std::make_shared<SemNodeLoop>(stringIndex, "for");
+NodeHandle Semantics::onTypeDefinition( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    const std::string_view type,
+    const NodeHandles children)
+{
+    // typedef names must be known before the lexer reads the next token
+    declareList(getChild(children, 0), type, SymbolTable::Kind::Type);
+    return kNoNode;
+}
 
-                node->setSemStart(mPrevReducePos);
-                setPrevReducePos(stringIndex);
+NodeHandle Semantics::onDirectDecl( //
+    const uint32_t stringIndex,
+    const std::string_view identifier,
+    [[maybe_unused]] const NodeHandles children)
+{
+    // type is filled in by the enclosing declarator & declaration
+    auto node = makeNode<SemNodeDeclaration>(stringIndex, std::string{}, std::string{identifier});
+    return node->getId();
+}
 
-                addNodeToAst(node);
-                mState.addScope(node);
-            }
-            break;
+NodeHandle Semantics::onPointer( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    const std::string_view pointers,
+    const NodeHandles children)
+{
+    const NodeHandle declHandle = getChild(children, 0);
 
-        case SyntaxChunkType::kForLoopConditions:
-            {
-                mState.mState = SState::Idle;
-                handleForLoopConditions(stringIndex);
-            }
-            break;
+    auto nodeDecl = getNode<SemNodeDeclaration>(declHandle);
+    assert(nodeDecl);
+    nodeDecl->prependToType(std::string{pointers});
 
-        case SyntaxChunkType::kForLoop:
-            {
-                auto currentScope = mState.getCurrentScope();
-                auto scopeNode = semNodeConvert<SemNodeScope>(currentScope);
-                scopeNode->setEnd(stringIndex);
+    return declHandle;
+}
 
-                scopeNode->setSemEnd(stringIndex);
-                setPrevReducePos(stringIndex);
+NodeHandle Semantics::onArrayDecl( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    const NodeHandle declHandle = getChild(children, 0);
 
-                mState.removeScope();
-            }
-            break;
+    auto nodeDecl = getNode<SemNodeDeclaration>(declHandle);
+    assert(nodeDecl);
+    nodeDecl->appendToType("[]");
 
-        case SyntaxChunkType::kRelationalExpression:
-            handleRelationalExpression(stringIndex, additional);
-            break;
+    // no size node for "[]"
+    nodeDecl->addArrayDimension(getNode(getChild(children, 1)));
 
-        case SyntaxChunkType::kPostfixExpression:
-            handlePostfixExpression(stringIndex, additional);
-            break;
+    return declHandle;
+}
 
-        case SyntaxChunkType::kEmptyStatement:
-            {
-                auto node = std::make_shared<SemNodeEmptyStatement>(stringIndex);
-                mState.stageNode(node);
-            }
-            break;
+NodeHandle Semantics::onFunctionDecl( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    const NodeHandle declHandle = getChild(children, 0);
 
-        case SyntaxChunkType::kReturn:
-            handleReturn(stringIndex, additional);
-            break;
+    auto nodeDecl = getNode<SemNodeDeclaration>(declHandle);
+    assert(nodeDecl);
 
-        case SyntaxChunkType::kUnaryOp:
-            handleUnaryOp(stringIndex, additional);
-            break;
+    auto params = getNode(getChild(children, 1));
+    assert(params);
 
-        case SyntaxChunkType::kSimpleExpr:
-            handleSimpleExpr(stringIndex);
-            break;
+    for (auto &it : params->getAttachedNodes())
+    {
+        nodeDecl->attach(it);
+    }
 
-        case SyntaxChunkType::kBinaryOp:
-            handleBinaryOp(stringIndex, additional);
-            break;
+    return declHandle;
+}
 
-        case SyntaxChunkType::kJumpStatement:
-            handleJumpStatement(stringIndex, additional);
-            break;
+NodeHandle Semantics::onParameter( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    const std::string_view type,
+    const NodeHandles children)
+{
+    const NodeHandle declHandle = getChild(children, 0);
 
-        case SyntaxChunkType::kWhileLoopHeader:
-            {
-                auto node = std::make_shared<SemNodeLoop>(stringIndex, "while");
+    auto nodeDecl = getNode<SemNodeDeclaration>(declHandle);
+    assert(nodeDecl);
+    nodeDecl->prependToType(std::string{type});
 
-                node->setSemStart(mPrevReducePos);
-                setPrevReducePos(stringIndex);
+    return declHandle;
+}
 
-                addNodeToAst(node);
-                mState.addScope(node);
-            }
-            break;
+NodeHandle Semantics::onList( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    // list reductions come as (first) or (list, next), the group
+    // is only a container and is never attached to the AST
+    NodeHandle listHandle = kNoNode;
+    NodeHandle elementHandle = getChild(children, 0);
 
-        case SyntaxChunkType::kWhileLoopConditions:
-            handleWhileLoopConditions(stringIndex);
-            break;
+    if (children.size() == 1)
+    {
+        listHandle = makeNode<SemNodeGroup>(stringIndex)->getId();
+    }
+    else
+    {
+        listHandle = getChild(children, 0);
+        elementHandle = getChild(children, 1);
+    }
 
-        case SyntaxChunkType::kWhileLoop:
-            {
-                auto currentScope = mState.getCurrentScope();
-                auto scopeNode = semNodeConvert<SemNodeScope>(currentScope);
-                scopeNode->setEnd(stringIndex);
+    auto element = getNode(elementHandle);
+    if (element)
+    {
+        getNode(listHandle)->attachShared(element);
+    }
 
-                scopeNode->setSemEnd(stringIndex);
-                setPrevReducePos(stringIndex);
+    return listHandle;
+}
 
-                mState.removeScope();
-            }
-            break;
+NodeHandle Semantics::onConstant( //
+    const uint32_t stringIndex,
+    const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto node = makeNode<SemNodeConstant>(stringIndex, std::string{additional});
+    return node->getId();
+}
 
-        case SyntaxChunkType::kArrayDecl:
-            {
-                auto &stagedNodes = mState.getStagedNodes();
-                assert(stagedNodes.size() >= 1);
+NodeHandle Semantics::onIdentifier( //
+    const uint32_t stringIndex,
+    const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto node = makeNode<SemNodeIdentifier>(stringIndex, std::string{additional});
+    return node->getId();
+}
 
-                auto &node = stagedNodes.back();
-                assert(node->getType() == SemNode::Type::Declaration);
-                auto nodeDecl = semNodeConvert<SemNodeDeclaration>(node);
-                nodeDecl->appendToType("[]");
-            }
-            break;
+NodeHandle Semantics::onInitDeclaration( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    const NodeHandle declHandle = getChild(children, 0);
+    auto decl = getNode(declHandle);
+    assert(decl);
 
-        case SyntaxChunkType::kInitializerList:
-            handleInitializerList(stringIndex);
-            break;
+    std::shared_ptr<SemNode> statement = decl;
 
-        case SyntaxChunkType::kDeferHeader:
-            {
-                auto deferNode = std::make_shared<SemNodeDefer>(stringIndex);
-
-                deferNode->setSemStart(mPrevReducePos);
-                setPrevReducePos(stringIndex);
+    auto initializer = getNode(getChild(children, 1));
+    if (initializer)
+    {
+        auto binaryOp = makeNode<SemNodeBinaryOp>(stringIndex, "=", decl);
+        binaryOp->setRhs(initializer);
+        statement = binaryOp;
+    }
 
-                mState.mDeferNodeWaitingForDeferredOp = deferNode;
-                mState.mState = SState::WaitingForDeferredOp;
-            }
-            break;
+    statement->setSemStart(mPrevReducePos);
+    statement->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-        case SyntaxChunkType::kDefer:
-            handleDefer(stringIndex);
-            break;
+    addNodeToAst(statement);
 
-        case SyntaxChunkType::kSimpleScopeStart:
-            {
-                auto scopeNode = std::make_shared<SemNodeScope>(stringIndex);
+    // the declaration gets its type once the whole declaration is reduced
+    return declHandle;
+}
 
-                scopeNode->setSemStart(mPrevReducePos);
-                setPrevReducePos(stringIndex);
+NodeHandle Semantics::onConditionHeader( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto nodeIf = makeNode<SemNodeIf>(stringIndex);
+    nodeIf->setSemStart(mPrevReducePos);
 
-                addNodeToAst(scopeNode);
-                mState.addScope(scopeNode);
-            }
-            break;
+    auto ifGroup = nodeIf->getGroup();
+    ifGroup->setSemStart(mPrevReducePos);
 
-        case SyntaxChunkType::kSimpleScopeEnd:
-            {
-                auto currentScope = mState.getCurrentScope();
-                auto currentScopeTyped = semNodeConvert<SemNodeScope>(currentScope);
-                currentScopeTyped->setEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-                currentScopeTyped->setSemEnd(stringIndex);
-                setPrevReducePos(stringIndex);
+    return nodeIf->getId();
+}
 
-                mState.removeScope();
-            }
-            break;
+NodeHandle Semantics::onConditionExpression( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    auto nodeIf = getNode<SemNodeIf>(getChild(children, 0));
+    assert(nodeIf && (nodeIf->getType() == SemNode::Type::If));
 
-        case SyntaxChunkType::kSwitchHeader:
-            {
-                auto switchNode = std::make_shared<SemNodeSwitchCase>(stringIndex);
+    auto condNode = getNode(getChild(children, 1));
+    assert(condNode);
+    nodeIf->setCond(condNode);
 
-                switchNode->setSemStart(mPrevReducePos);
-                setPrevReducePos(stringIndex);
+    auto group = nodeIf->getGroup();
+    group->setSemEnd(stringIndex);
 
-                addNodeToAst(switchNode);
-                mState.addScope(switchNode);
-            }
-            break;
+    setPrevReducePos(stringIndex);
 
-        case SyntaxChunkType::kSwitchStatement:
-            handleSwitchStatement(stringIndex);
-            break;
+    addNodeToAst(nodeIf);
+    mState.addScope(nodeIf);
 
-        case SyntaxChunkType::kSwitchEnd:
-            handleSwitchEnd(stringIndex);
-            break;
+    return kNoNode;
+}
 
-        case SyntaxChunkType::kSwitchCaseHeader:
-            handleSwitchCaseHeader(stringIndex, additional);
-            break;
+NodeHandle Semantics::onCondition( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto currentScope = mState.getCurrentScope();
+    auto scopeNode = semNodeConvert<SemNodeScope>(currentScope);
+    scopeNode->setEnd(stringIndex);
 
-        case SyntaxChunkType::kSwitchCaseEnd:
-            handleSwitchCaseEnd(stringIndex);
-            break;
+    scopeNode->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-        default:
-            log("type not handled: %", Color::Red, static_cast<uint32_t>(type));
-            break;
-    }
-}
+    mState.removeScope();
 
-std::shared_ptr<SemNodeTranslationUnit> Semantics::getAst() const
-{
-    return mTranslationUnit;
+    return kNoNode;
 }
 
-void Semantics::handleFunctionHeader( //
+NodeHandle Semantics::onForLoopHeader( //
     const uint32_t stringIndex,
-    const bool isVoidOrVoidPtrRetType)
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
-
-    // first node is the function name & return type
-    auto declNode = semNodeConvert<SemNodeDeclaration>(stagedNodes[0]);
-
-    auto node = std::make_shared<SemNodeFunction>(stringIndex);
-    node->setReturn(declNode->getLhsType());
-    node->setName(declNode->getLhsIdentifier());
+    auto node = makeNode<SemNodeLoop>(stringIndex, "for");
 
     node->setSemStart(mPrevReducePos);
     setPrevReducePos(stringIndex);
 
-    // add function params
-    for (uint32_t i = 1; i < stagedNodes.size(); i++)
-    {
-        auto it = stagedNodes[i];
-
-        // all nodes should be direct decls now
-        assert(it->getType() == SemNode::Type::Declaration);
-        auto nodeDecl = semNodeConvert<SemNodeDeclaration>(it);
-        node->addParam(nodeDecl->getLhsType(), nodeDecl->getLhsIdentifier());
-    }
-
-    stagedNodes.clear(); // all staged nodes should be consumed now
-
-    // clear all chunks when using ...function(void) the "void" is added
-    // as chunk type "kType"
-    auto &chunks = mState.getChunks();
-    chunks.clear();
-
     addNodeToAst(node);
     mState.addScope(node);
-}
-
-void Semantics::handleFunctionEnd(const uint32_t stringIndex)
-{
-    auto currentScopeFun = mState.getCurrentScope();
-    assert(currentScopeFun->getType() == SemNode::Type::Function);
-    auto funScopeNode = semNodeConvert<SemNodeFunction>(currentScopeFun);
-    funScopeNode->setEnd(stringIndex);
-
-    funScopeNode->setSemEnd(stringIndex);
-    setPrevReducePos(stringIndex);
 
-    mState.removeScope();
+    return kNoNode;
 }
 
-void Semantics::handleInitDeclaration( //
+NodeHandle Semantics::onForLoopConditions( //
     const uint32_t stringIndex,
-    const bool withAssignment)
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
+    auto itInit = getNode(getChild(children, 0));
+    auto itCond = getNode(getChild(children, 1));
+    auto itChange = getNode(getChild(children, 2));
 
-    if (withAssignment)
+    auto currentScope = mState.getCurrentScope(); // the loop
+    auto loopNode = semNodeConvert<SemNodeLoop>(currentScope);
+    loopNode->setIteratorInit(itInit);
+    loopNode->setIteratorCondition(itCond);
+
+    if (itChange)
     {
-        if (stagedNodes.size() > 2)
+        // not an expression statement, ends where it was reduced
+        auto itChangePositional = std::dynamic_pointer_cast<SemNodePositional>(itChange);
+        if (itChangePositional)
         {
-            foldUnaryOps(stagedNodes.size() - 1);
+            itChange->setSemStart(mPrevReducePos);
+            itChange->setSemEnd(itChangePositional->getPos());
         }
 
-        auto rhs = stagedNodes.back();
-        stagedNodes.pop_back();
-
-        auto binaryOp = semNodeConvert<SemNodeBinaryOp>(stagedNodes.back());
-        stagedNodes.pop_back();
-        binaryOp->setRhs(rhs);
+        loopNode->setIteratorChange(itChange);
+    }
 
-        // rhs might use a unary operator (&, *) -- this breaks
-        // position setting for init decl, fix it here
-        uint32_t fixedStartPos = rhs->getSemStart();
-        if (fixedStartPos == 0)
-        {
-            fixedStartPos = mPrevReducePos;
+    // group starts right after the "for" keyword
+    auto group = loopNode->getGroup();
+    group->setSemStart(group->getPos());
+    group->setSemEnd(stringIndex);
 
-            // check if initializer list with unary operator...
-            if (rhs->getType() == SemNode::Type::InitializerList)
-            {
-                auto &initListEntries = semNodeConvert<SemNodeInitializerList>(rhs)->getEntries();
-                if (initListEntries.size() > 0)
-                {
-                    const uint32_t initListWithUnaryOpSemStart = initListEntries[0]->getSemStart();
-                    if (initListWithUnaryOpSemStart != 0)
-                    {
-                        fixedStartPos = initListWithUnaryOpSemStart;
-                    }
-                }
-            }
-        }
+    setPrevReducePos(stringIndex);
 
-        binaryOp->setSemStart(fixedStartPos);
-        binaryOp->setSemEnd(stringIndex);
+    return kNoNode;
+}
 
-        addNodeToAst(binaryOp);
-    }
-    else
-    {
-        auto decl = stagedNodes.back();
-        stagedNodes.pop_back();
+NodeHandle Semantics::onForLoop( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto currentScope = mState.getCurrentScope();
+    auto scopeNode = semNodeConvert<SemNodeScope>(currentScope);
+    scopeNode->setEnd(stringIndex);
 
-        decl->setSemStart(mPrevReducePos);
-        decl->setSemEnd(stringIndex);
+    scopeNode->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-        addNodeToAst(decl);
-    }
+    mState.removeScope();
 
-    setPrevReducePos(stringIndex);
+    return kNoNode;
 }
 
-void Semantics::handleAssignment(const uint32_t stringIndex)
+NodeHandle Semantics::onWhileLoopHeader( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
+    auto node = makeNode<SemNodeLoop>(stringIndex, "while");
 
-    // If we have more that 2 staged nodes, probably
-    // unary operator was used...
-    if (stagedNodes.size() > 2)
-    {
-        foldUnaryOps(stagedNodes.size() - 1);
-    }
+    node->setSemStart(mPrevReducePos);
+    setPrevReducePos(stringIndex);
+
+    addNodeToAst(node);
+    mState.addScope(node);
 
-    auto rhs = stagedNodes.back();
-    stagedNodes.pop_back();
+    return kNoNode;
+}
 
-    auto binaryOp = semNodeConvert<SemNodeBinaryOp>(stagedNodes.back());
-    stagedNodes.pop_back();
-    binaryOp->setRhs(rhs);
+NodeHandle Semantics::onWhileLoopConditions( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    auto itCond = getNode(getChild(children, 0));
+    assert(itCond);
 
-    // if rhs contains an unary op, need to fix the position...
-    uint32_t fixedStartPos = rhs->getSemStart();
-    if (fixedStartPos == 0)
-    {
-        fixedStartPos = mPrevReducePos;
-    }
+    auto currentScope = mState.getCurrentScope(); // the loop
+    auto loopNode = semNodeConvert<SemNodeLoop>(currentScope);
+    loopNode->setIteratorCondition(itCond);
 
-    binaryOp->setSemStart(fixedStartPos);
-    binaryOp->setSemEnd(stringIndex);
     setPrevReducePos(stringIndex);
 
-    mState.stageNode(binaryOp);
+    return kNoNode;
 }
 
-void Semantics::handleRelationalExpression( //
+NodeHandle Semantics::onWhileLoop( //
     const uint32_t stringIndex,
-    const std::string &op)
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
+    auto currentScope = mState.getCurrentScope();
+    auto scopeNode = semNodeConvert<SemNodeScope>(currentScope);
+    scopeNode->setEnd(stringIndex);
 
-    auto rhs = stagedNodes.back();
-    stagedNodes.pop_back();
+    scopeNode->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-    auto lhs = stagedNodes.back();
-    stagedNodes.pop_back();
+    mState.removeScope();
 
-    auto node = std::make_shared<SemNodeBinaryOp>(stringIndex, op, lhs);
-    node->setRhs(rhs);
+    return kNoNode;
+}
+
+NodeHandle Semantics::onDoLoopHeader( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto node = makeNode<SemNodeLoop>(stringIndex, "do");
 
     node->setSemStart(mPrevReducePos);
-    node->setSemEnd(stringIndex);
     setPrevReducePos(stringIndex);
 
-    mState.stageNode(node);
+    addNodeToAst(node);
+    mState.addScope(node);
+
+    return kNoNode;
 }
 
-void Semantics::handlePostfixExpression( //
+NodeHandle Semantics::onDoLoop( //
     const uint32_t stringIndex,
-    const std::string &op)
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
-
-    if (op == "(...)")
-    {
-        auto &stagedNodes = mState.getStagedNodes();
-        assert(stagedNodes.size() > 0);
+    auto itCond = getNode(getChild(children, 0));
+    assert(itCond);
 
-        if (stagedNodes[0]->getType() == SemNode::Type::BinaryOp)
-        {
-            // this is postfix with binary op (i.e. int res = fun(a, b, c);)
-            // should have staged binary op & function name at least
-            assert(stagedNodes.size() > 2);
-
-            auto functionNameNode = stagedNodes[1];
-            auto node = std::make_shared<SemNodePostfixExpression>(stringIndex, op, functionNameNode);
+    // the condition is after the body, the loop ends with it
+    auto currentScope = mState.getCurrentScope(); // the loop
+    auto loopNode = semNodeConvert<SemNodeLoop>(currentScope);
+    loopNode->setIteratorCondition(itCond);
+    loopNode->setEnd(stringIndex);
 
-            node->setSemStart(mPrevReducePos);
-            node->setSemEnd(stringIndex);
-            setPrevReducePos(stringIndex);
+    loopNode->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-            for (uint32_t i = 2; i < stagedNodes.size(); i++)
-            {
-                node->addArg(stagedNodes[i]);
-            }
+    mState.removeScope();
 
-            stagedNodes.erase(stagedNodes.begin() + 1, stagedNodes.end());
-            mState.stageNode(node);
-        }
-        else
-        {
-            auto functionNameNode = stagedNodes[0];
-            auto node = std::make_shared<SemNodePostfixExpression>(stringIndex, op, functionNameNode);
+    return kNoNode;
+}
 
-            node->setSemStart(mPrevReducePos);
-            node->setSemEnd(stringIndex);
-            setPrevReducePos(stringIndex);
+NodeHandle Semantics::onPostfixExpression( //
+    const uint32_t stringIndex,
+    const std::string_view op,
+    const NodeHandles children)
+{
+    auto lhs = getNode(getChild(children, 0));
+    assert(lhs);
 
-            for (uint32_t i = 1; i < stagedNodes.size(); i++)
-            {
-                node->addArg(stagedNodes[i]);
-            }
+    auto node = makeNode<SemNodePostfixExpression>(stringIndex, std::string{op}, lhs);
 
-            stagedNodes.clear();
-            mState.stageNode(node);
+    auto rhs = getNode(getChild(children, 1));
+    if (op == "(...)")
+    {
+        // function call arguments come as a list
+        assert(rhs);
+        for (auto &it : rhs->getAttachedNodes())
+        {
+            node->addArg(it);
         }
     }
     else if (op == "[]")
     {
-        // should have index & array at least
-        assert(stagedNodes.size() >= 2);
+        assert(rhs);
+        node->addArg(rhs);
+    }
 
-        auto indexExprNode = stagedNodes.back();
-        stagedNodes.pop_back();
+    return node->getId();
+}
 
-        auto lhs = stagedNodes.back();
-        stagedNodes.pop_back();
+NodeHandle Semantics::onEmptyStatement( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto node = makeNode<SemNodeEmptyStatement>(stringIndex);
+    return node->getId();
+}
 
-        auto node = std::make_shared<SemNodePostfixExpression>(stringIndex, op, lhs);
+NodeHandle Semantics::onReturn( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    auto rhs = getNode(getChild(children, 0));
+    auto node = makeNode<SemNodeReturn>(stringIndex, rhs);
 
-        node->setSemStart(mPrevReducePos);
-        node->setSemEnd(stringIndex);
-        setPrevReducePos(stringIndex);
+    node->setSemStart(mPrevReducePos);
+    node->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-        node->addArg(indexExprNode);
-        mState.stageNode(node);
-    }
-    else
-    {
-        auto lhs = stagedNodes.back();
-        stagedNodes.pop_back();
+    addNodeToAst(node);
 
-        auto node = std::make_shared<SemNodePostfixExpression>(stringIndex, op, lhs);
+    return kNoNode;
+}
 
-        node->setSemStart(mPrevReducePos);
-        node->setSemEnd(stringIndex);
-        setPrevReducePos(stringIndex);
+NodeHandle Semantics::onUnaryOp( //
+    const uint32_t stringIndex,
+    const std::string_view op,
+    const NodeHandles children)
+{
+    auto node = makeNode<SemNodeUnaryOp>(stringIndex, std::string{op});
 
-        mState.stageNode(node);
+    auto rhs = getNode(getChild(children, 0));
+    if (rhs)
+    {
+        node->setRhs(rhs);
     }
+
+    return node->getId();
 }
 
-void Semantics::handleForLoopConditions(const uint32_t pos)
+NodeHandle Semantics::onBinaryOp( //
+    const uint32_t stringIndex,
+    const std::string_view op,
+    const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
+    auto lhs = getNode(getChild(children, 0));
+    auto rhs = getNode(getChild(children, 1));
+    assert(lhs && rhs);
 
-    auto itChange = stagedNodes.back();
-    stagedNodes.pop_back();
-    auto itCond = stagedNodes.back();
-    stagedNodes.pop_back();
-    auto itInit = stagedNodes.back();
-    stagedNodes.pop_back();
+    auto node = makeNode<SemNodeBinaryOp>(stringIndex, std::string{op}, lhs);
+    node->setRhs(rhs);
 
-    auto currentScope = mState.getCurrentScope(); // the loop
-    auto loopNode = semNodeConvert<SemNodeLoop>(currentScope);
-    loopNode->setIteratorInit(itInit);
-    loopNode->setIteratorCondition(itCond);
-    loopNode->setIteratorChange(itChange);
+    return node->getId();
+}
 
-    auto group = loopNode->getGroup();
-    group->setSemStart(itInit->getSemStart()); // grab the start of first node in group...
-    group->setSemEnd(pos);
+NodeHandle Semantics::onSimpleExpr( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    // only the statement root is positioned, it covers the whole expression
+    const NodeHandle exprHandle = getChild(children, 0);
 
-    setPrevReducePos(pos);
+    auto expr = getNode(exprHandle);
+    assert(expr);
+
+    expr->setSemStart(mPrevReducePos);
+    expr->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
+
+    return exprHandle;
 }
 
-void Semantics::handleConditionExpression(const uint32_t stringIndex)
+NodeHandle Semantics::onExpressionStatement( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
+    auto statement = getNode(getChild(children, 0));
+    assert(statement);
 
-    auto condNode = stagedNodes.back();
-    stagedNodes.pop_back();
+    addNodeToAst(statement);
 
-    auto nodeIf = stagedNodes.back();
-    stagedNodes.pop_back();
-
-    assert(nodeIf->getType() == SemNode::Type::If);
-    auto nodeIfTyped = semNodeConvert<SemNodeIf>(nodeIf);
-    nodeIfTyped->setCond(condNode);
+    return kNoNode;
+}
 
-    auto group = nodeIfTyped->getGroup();
-    group->setSemEnd(stringIndex);
+NodeHandle Semantics::onJumpStatement( //
+    const uint32_t stringIndex,
+    const std::string_view stmtName,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto node = makeNode<SemNodeJumpStatement>(stringIndex, std::string{stmtName});
 
+    node->setSemStart(mPrevReducePos);
+    node->setSemEnd(stringIndex);
     setPrevReducePos(stringIndex);
 
-    // all staged nodes should be now placed into AST, since
-    // we now encountered condition expression the previously
-    // staged nodes will not be used for anything but should be
-    // placed in "upper" scope
-    for (auto &it : stagedNodes)
-    {
-        addNodeToAst(it);
-    }
-    stagedNodes.clear();
+    addNodeToAst(node);
 
-    addNodeToAst(nodeIf);
-    mState.addScope(nodeIf);
+    return kNoNode;
 }
 
-void Semantics::handleWhileLoopConditions(const uint32_t stringIndex)
+NodeHandle Semantics::onGoto( //
+    const uint32_t stringIndex,
+    const std::string_view label,
+    [[maybe_unused]] const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
+    auto node = makeNode<SemNodeJumpStatement>(stringIndex, "goto", std::string{label});
 
-    assert(stagedNodes.size() >= 1);
-
-    auto itCond = stagedNodes.back();
-    stagedNodes.pop_back();
+    node->setSemStart(mPrevReducePos);
+    node->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-    auto currentScope = mState.getCurrentScope(); // the loop
-    auto loopNode = semNodeConvert<SemNodeLoop>(currentScope);
-    loopNode->setIteratorCondition(itCond);
+    addNodeToAst(node);
 
-    setPrevReducePos(stringIndex);
+    return kNoNode;
 }
 
-void Semantics::handleDirectDecl(const uint32_t stringIndex, const std::string &additional)
+NodeHandle Semantics::onInitializerList( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
 {
-    auto &chunks = mState.getChunks();
-    const auto chunksSize = chunks.size();
-
-    if (chunksSize == 0)
-    {
-        std::string typeStr = "void";
+    // braced init list
+    auto nodeInitList = makeNode<SemNodeInitializerList>(stringIndex);
 
-        const uint32_t ptrCount = countPointersInChunks(0);
-        for (uint32_t i = 0; i < ptrCount; ++i)
-        {
-            typeStr += "*";
-        }
+    auto entries = getNode(getChild(children, 0));
+    assert(entries);
 
-        // void decl - probably a function
-        auto node = std::make_shared<SemNodeDeclaration>(stringIndex, "void", additional);
-        mState.stageNode(node);
-    }
-    else
+    for (auto &it : entries->getAttachedNodes())
     {
-        // should have only type on stack, maybe with pointers
-        assert(chunksSize >= 1);
-        assert((chunks[0].mType == SyntaxChunkType::kType) || //
-               (chunks[0].mType == SyntaxChunkType::kPointer));
-
-        uint32_t pointerCountStartIndex = 1;
-        std::string typeStr = chunks[0].mAdditional;
-        if (chunks[0].mType == SyntaxChunkType::kPointer)
-        {
-            pointerCountStartIndex = 0;
-            typeStr = "void";
-        }
-
-        const uint32_t ptrCount = countPointersInChunks(pointerCountStartIndex);
-        for (uint32_t i = 0; i < ptrCount; ++i)
-        {
-            typeStr += "*";
-        }
-
-        auto node = std::make_shared<SemNodeDeclaration>(stringIndex, typeStr, additional);
-        mState.stageNode(node);
+        nodeInitList->addEntry(it);
     }
 
-    chunks.clear();
+    return nodeInitList->getId();
 }
 
-void Semantics::handleInitializerList(const uint32_t stringIndex)
+NodeHandle Semantics::onDeferHeader( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
-    // braced init list
-    auto nodeInitList = std::make_shared<SemNodeInitializerList>(stringIndex);
+    // position of the defer node is where the deferred operation starts
+    auto deferNode = makeNode<SemNodeDefer>(stringIndex);
+    return deferNode->getId();
+}
 
-    auto &stagedNodes = mState.getStagedNodes();
-    assert(stagedNodes.size() > 1);
+NodeHandle Semantics::onDefer( //
+    [[maybe_unused]] const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    const NodeHandle deferHandle = getChild(children, 0);
 
-    assert(stagedNodes[0]->getType() == SemNode::Type::BinaryOp);
-    auto binOpNode = semNodeConvert<SemNodeBinaryOp>(stagedNodes[0]);
+    auto deferNode = getNode<SemNodeDefer>(deferHandle);
+    assert(deferNode && (deferNode->getType() == SemNode::Type::Defer));
 
-    // first staged node should be the declaration
-    // all following nodes should be identifiers - contents
-    // of the initializer list
+    auto deferredNode = getNode(getChild(children, 1));
+    assert(deferredNode);
 
-    // fold any unary operators in init list
-    const size_t stagedNodeLastIdx = stagedNodes.size() - 1;
-    for (size_t i = stagedNodeLastIdx; i > 0 /* skip first */; i--)
+    // the deferred operation is emitted on its own, so it needs
+    // the source range from the defer keyword to its reduction
+    auto deferredNodePositional = std::dynamic_pointer_cast<SemNodePositional>(deferredNode);
+    if (deferredNodePositional)
     {
-        auto node = stagedNodes[i];
-        if (node->getType() == SemNode::Type::UnaryOp)
-        {
-            auto nodeUnaryOp = semNodeConvert<SemNodeUnaryOp>(node);
-
-            const bool nextNodeInRange = ((i + 1) < stagedNodeLastIdx);
-            if (nextNodeInRange)
-            {
-                auto nodeFollowing = stagedNodes[i + 1];
-                nodeUnaryOp->setRhs(nodeFollowing);
-                stagedNodes.erase(stagedNodes.begin() + i + 1);
-            }
-        }
+        deferredNode->setSemStart(deferNode->getPos());
+        deferredNode->setSemEnd(deferredNodePositional->getPos());
     }
 
-    for (size_t i = 1 /* skip first */; i < stagedNodes.size(); i++)
-    {
-        auto node = stagedNodes[i];
-        nodeInitList->addEntry(node);
-    }
-    stagedNodes.erase(stagedNodes.begin() + 1, stagedNodes.end());
+    deferNode->setDeferredNode(deferredNode);
 
-    mState.stageNode(nodeInitList);
+    return deferHandle;
 }
 
-void Semantics::handleDefer(const uint32_t stringIndex)
+NodeHandle Semantics::onSimpleScopeStart( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
-    assert(mState.mState == SState::WaitingForDeferredOp);
-    mState.mState = SState::Idle;
+    auto scopeNode = makeNode<SemNodeScope>(stringIndex);
 
-    auto deferNode = mState.mDeferNodeWaitingForDeferredOp;
-    mState.mDeferNodeWaitingForDeferredOp.reset();
+    scopeNode->setSemStart(mPrevReducePos);
+    setPrevReducePos(stringIndex);
 
-    auto &stagedNodes = mState.getStagedNodes();
-    assert(stagedNodes.size() >= 1);
+    addNodeToAst(scopeNode);
+    mState.addScope(scopeNode);
 
-    auto lastNode = stagedNodes.back();
-    stagedNodes.pop_back();
+    return kNoNode;
+}
 
-    assert(deferNode->getType() == SemNode::Type::Defer);
-    auto deferNodeTyped = semNodeConvert<SemNodeDefer>(deferNode);
-    deferNodeTyped->setDeferredNode(lastNode);
+NodeHandle Semantics::onSimpleScopeEnd( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto currentScope = mState.getCurrentScope();
+    auto currentScopeTyped = semNodeConvert<SemNodeScope>(currentScope);
+    currentScopeTyped->setEnd(stringIndex);
 
-    deferNode->setSemEnd(stringIndex);
+    currentScopeTyped->setSemEnd(stringIndex);
     setPrevReducePos(stringIndex);
 
-    mState.stageNode(deferNode);
+    mState.removeScope();
+
+    return kNoNode;
 }
 
-void Semantics::handleSwitchStatement(const uint32_t stringIndex)
+NodeHandle Semantics::onSwitchHeader( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
-    assert(stagedNodes.size() >= 1);
+    auto switchNode = makeNode<SemNodeSwitchCase>(stringIndex);
+
+    switchNode->setSemStart(mPrevReducePos);
+    setPrevReducePos(stringIndex);
 
-    auto lastNode = stagedNodes.back();
-    stagedNodes.pop_back();
+    addNodeToAst(switchNode);
+    mState.addScope(switchNode);
+
+    return kNoNode;
+}
+
+NodeHandle Semantics::onSwitchStatement( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
+{
+    auto switchExpr = getNode(getChild(children, 0));
+    assert(switchExpr);
 
     // current scope must be a switch..case
     auto currentScope = mState.getCurrentScope();
     assert(currentScope->getType() == SemNode::Type::SwitchCase);
 
     auto switchCaseNode = semNodeConvert<SemNodeSwitchCase>(currentScope);
-    switchCaseNode->setSwitchExpr(lastNode);
+    switchCaseNode->setSwitchExpr(switchExpr);
 
     setPrevReducePos(stringIndex);
+
+    return kNoNode;
 }
 
-void Semantics::handleSwitchEnd(const uint32_t stringIndex)
+NodeHandle Semantics::onSwitchEnd( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
     auto currentScope = mState.getCurrentScope();
 
@@ -821,24 +798,25 @@ void Semantics::handleSwitchEnd(const uint32_t stringIndex)
     setPrevReducePos(stringIndex);
 
     mState.removeScope();
+
+    return kNoNode;
 }
 
-void Semantics::handleSwitchCaseHeader(const uint32_t stringIndex, const std::string &additional)
+NodeHandle Semantics::onSwitchCaseHeader( //
+    const uint32_t stringIndex,
+    const std::string_view additional,
+    const NodeHandles children)
 {
     assert((additional == "case") || (additional == "default"));
 
-    auto caseLabelNode = std::make_shared<SemNodeSwitchCaseLabel>(stringIndex);
-
-    auto &stagedNodes = mState.getStagedNodes();
+    auto caseLabelNode = makeNode<SemNodeSwitchCaseLabel>(stringIndex);
 
-    // grab the case statement (grab X in "case X: ...")
-    std::shared_ptr<SemNode> nodeToBeSetAsCaseLabel = //
-        std::make_shared<SemNodeEmptyStatement>(stringIndex);
-    if (additional == "case")
+    // the case statement (X in "case X: ..."), empty for default
+    std::shared_ptr<SemNode> nodeToBeSetAsCaseLabel = getNode(getChild(children, 0));
+    if (!nodeToBeSetAsCaseLabel)
     {
-        assert(stagedNodes.size() >= 1);
-        nodeToBeSetAsCaseLabel = stagedNodes.back();
-        stagedNodes.pop_back();
+        assert(additional == "default");
+        nodeToBeSetAsCaseLabel = makeNode<SemNodeEmptyStatement>(stringIndex);
     }
 
     auto currentScope = mState.getCurrentScope();
@@ -853,7 +831,7 @@ void Semantics::handleSwitchCaseHeader(const uint32_t stringIndex, const std::st
         // already know the previous case statement is done
         // set stringIndex as previous reduce position, since we're
         // closing a previous parser match
-        handleSwitchCaseEnd(mPrevReducePos);
+        onSwitchCaseEnd(mPrevReducePos, {}, {});
     }
     else
     {
@@ -926,9 +904,14 @@ void Semantics::handleSwitchCaseHeader(const uint32_t stringIndex, const std::st
 
     addNodeToAst(caseLabelNode);
     mState.addScope(caseLabelNode);
+
+    return kNoNode;
 }
 
-void Semantics::handleSwitchCaseEnd(const uint32_t stringIndex)
+NodeHandle Semantics::onSwitchCaseEnd( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
     auto currentScope = mState.getCurrentScope();
     if (currentScope->getType() == SemNode::Type::Scope)
@@ -936,7 +919,7 @@ void Semantics::handleSwitchCaseEnd(const uint32_t stringIndex)
         // we are currently in the scope under SemNodeSwitch, this
         // means we had a fallthrough statements that were already closed,
         // ignore this chunk
-        return;
+        return kNoNode;
     }
 
     // current scope must be a switch..case label
@@ -949,142 +932,129 @@ void Semantics::handleSwitchCaseEnd(const uint32_t stringIndex)
     setPrevReducePos(stringIndex);
 
     mState.removeScope();
+
+    return kNoNode;
 }
 
-void Semantics::handleBinaryOp(const uint32_t stringIndex, const std::string &op)
+NodeHandle Semantics::onGenericHeader( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
+    // position of the generic keyword, the definition is
+    // attached to this node, the params are its scope
+    auto genericNode = makeNode<SemNodeGeneric>(stringIndex);
+    genericNode->setSemStart(stringIndex);
 
-    // since this is a binary op we should have
-    // at least two staged nodes already
-    assert(stagedNodes.size() >= 2);
-
-    auto rhs = stagedNodes.back();
-    stagedNodes.pop_back();
-    auto lhs = stagedNodes.back();
-    stagedNodes.pop_back();
-
-    auto node = std::make_shared<SemNodeBinaryOp>(stringIndex, op, lhs);
-    node->setRhs(rhs);
+    addNodeToAst(genericNode);
+    mState.addScope(genericNode);
 
-    mState.stageNode(node);
+    return genericNode->getId();
 }
 
-void Semantics::handleReturn(const uint32_t stringIndex, const std::string &additional)
+NodeHandle Semantics::onGenericParameters( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    const NodeHandles children)
 {
-    if (additional == "no-value")
-    {
-        auto node = std::make_shared<SemNodeReturn>(stringIndex);
+    auto genericNode = getNode<SemNodeGeneric>(getChild(children, 0));
+    assert(genericNode && (genericNode->getType() == SemNode::Type::Generic));
 
-        node->setSemStart(mPrevReducePos);
-        node->setSemEnd(stringIndex);
-        setPrevReducePos(stringIndex);
+    auto paramsNode = getNode(getChild(children, 1));
+    assert(paramsNode);
 
-        addNodeToAst(node);
-    }
-    else
+    // the params are type names in the definition
+    auto &symbols = mState.getSymbols();
+    for (auto &it : paramsNode->getAttachedNodes())
     {
-        auto &stagedNodes = mState.getStagedNodes();
-        assert(stagedNodes.empty() == false);
-
-        auto rhs = stagedNodes.back();
-        stagedNodes.pop_back();
+        assert(it->getType() == SemNode::Type::Identifier);
+        const std::string name = semNodeConvert<SemNodeIdentifier>(it)->getName();
 
-        auto finalRhs = rhs;
+        genericNode->addParam(name);
+        symbols.declare(name, SymbolTable::Kind::Type);
+    }
 
-        if (stagedNodes.size() > 0)
-        {
-            auto possibleUnaryOp = stagedNodes.back();
-            while (possibleUnaryOp && possibleUnaryOp->getType() == SemNode::Type::UnaryOp)
-            {
-                // TODO: how far back should this while() reach?
-                semNodeConvert<SemNodeUnaryOp>(possibleUnaryOp)->setRhs(rhs);
-                finalRhs = possibleUnaryOp;
-                stagedNodes.pop_back();
-                rhs = finalRhs;
+    genericNode->setHeaderEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-                if (stagedNodes.empty() == true)
-                {
-                    break;
-                }
+    return kNoNode;
+}
 
-                possibleUnaryOp = stagedNodes.back();
-            }
-        }
+NodeHandle Semantics::onGenericDefinition( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    auto currentScope = mState.getCurrentScope();
+    assert(currentScope->getType() == SemNode::Type::Generic);
 
-        auto node = std::make_shared<SemNodeReturn>(stringIndex, finalRhs);
+    auto genericNode = semNodeConvert<SemNodeGeneric>(currentScope);
+    genericNode->setEnd(stringIndex);
 
-        // if returning unary op need to fix the sem position
-        uint32_t fixedStartPos = rhs->getSemStart();
-        if (fixedStartPos == 0)
-        {
-            fixedStartPos = mPrevReducePos;
-        }
+    genericNode->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
 
-        node->setSemStart(fixedStartPos);
-        node->setSemEnd(stringIndex);
-        setPrevReducePos(stringIndex);
+    mState.removeScope();
 
-        addNodeToAst(node);
-    }
+    return kNoNode;
 }
 
-void Semantics::handleUnaryOp(const uint32_t stringIndex, const std::string &additional)
+NodeHandle Semantics::onGenericInstance( //
+    const uint32_t stringIndex,
+    const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
 {
-    auto node = std::make_shared<SemNodeUnaryOp>(stringIndex, additional);
+    auto node = makeNode<SemNodeGenericInstance>(stringIndex, std::string{additional});
+    return node->getId();
+}
 
-    node->setSemStart(mPrevReducePos);
-    node->setSemEnd(stringIndex);
-    setPrevReducePos(stringIndex);
+NodeHandle Semantics::onStaticAssertHeader( //
+    const uint32_t stringIndex,
+    [[maybe_unused]] const std::string_view additional,
+    [[maybe_unused]] const NodeHandles children)
+{
+    // position of the static_assert keyword
+    auto staticAssertNode = makeNode<SemNodeStaticAssert>(stringIndex);
+    staticAssertNode->setSemStart(mPrevReducePos);
 
-    if (additional == "++")
-    {
-        // ++prefix;
-        auto &stagedNodes = mState.getStagedNodes();
-        assert(stagedNodes.size() >= 1);
-        auto rhs = stagedNodes.back();
-        stagedNodes.pop_back();
-        node->setRhs(rhs);
-        mState.stageNode(node);
-    }
-    else
-    {
-        mState.stageNode(node);
-    }
+    return staticAssertNode->getId();
 }
 
-void Semantics::handleSimpleExpr(const uint32_t stringIndex)
+NodeHandle Semantics::onStaticAssert( //
+    const uint32_t stringIndex,
+    const std::string_view additional,
+    const NodeHandles children)
 {
-    auto &stagedNodes = mState.getStagedNodes();
-    if (mState.mState != SState::InForLoopContext)
-    {
-        // flush staged nodes
-        for (auto &it : stagedNodes)
-        {
-            addNodeToAst(it);
-        }
+    auto staticAssertNode = getNode<SemNodeStaticAssert>(getChild(children, 0));
+    assert(staticAssertNode && (staticAssertNode->getType() == SemNode::Type::StaticAssert));
 
-        if (stagedNodes.size() > 0)
-        {
-            stagedNodes.back()->setSemEnd(stringIndex);
-            setPrevReducePos(stringIndex);
-        }
+    auto condNode = getNode(getChild(children, 1));
+    assert(condNode);
 
-        stagedNodes.clear();
-    }
+    staticAssertNode->setCond(condNode);
+    staticAssertNode->setMessage(std::string{additional});
+
+    staticAssertNode->setSemEnd(stringIndex);
+    setPrevReducePos(stringIndex);
+
+    addNodeToAst(staticAssertNode);
+
+    return kNoNode;
 }
 
-void Semantics::handleJumpStatement( //
-    const uint32_t stringIndex,
-    const std::string &stmtName)
+std::shared_ptr<SemNodeTranslationUnit> Semantics::getAst() const
 {
-    auto node = std::make_shared<SemNodeJumpStatement>(stringIndex, stmtName);
+    return mTranslationUnit;
+}
 
-    node->setSemStart(mPrevReducePos);
-    node->setSemEnd(stringIndex);
-    setPrevReducePos(stringIndex);
+bool Semantics::isTypeName(const std::string_view name) const
+{
+    return mState.getSymbols().isTypeName(name);
+}
 
-    addNodeToAst(node);
+const std::string &Semantics::intern(const std::string_view name)
+{
+    return mState.getSymbols().intern(name);
 }
 
 void Semantics::addNodeToAst(std::shared_ptr<SemNode> node)
@@ -1092,55 +1062,35 @@ void Semantics::addNodeToAst(std::shared_ptr<SemNode> node)
     mState.getCurrentScope()->attach(node);
 }
 
-void Semantics::foldUnaryOps(const size_t start)
+void Semantics::declareList( //
+    const NodeHandle declList,
+    const std::string_view type,
+    const SymbolTable::Kind kind)
 {
-    auto &stagedNodes = mState.getStagedNodes();
+    // declaration specifiers are reduced last, apply
+    // the type to all declarators in the list
+    auto declListNode = getNode(declList);
+    assert(declListNode);
 
-    for (size_t i = start; i > 0; i--)
+    auto &symbols = mState.getSymbols();
+    for (auto &it : declListNode->getAttachedNodes())
     {
-        auto node = stagedNodes[i];
-        if (node->getType() == SemNode::Type::UnaryOp)
-        {
-            const bool nextNodeInRange = ((i + 1) < stagedNodes.size());
-            assert(nextNodeInRange);
+        assert(it->getType() == SemNode::Type::Declaration);
+        auto nodeDecl = semNodeConvert<SemNodeDeclaration>(it);
+        nodeDecl->prependToType(std::string{type});
 
-            auto unaryOpNode = semNodeConvert<SemNodeUnaryOp>(node);
-            unaryOpNode->setRhs(stagedNodes[i + 1]);
-            stagedNodes.erase(stagedNodes.begin() + i + 1);
-        }
+        symbols.declare(nodeDecl->getLhsIdentifier(), kind);
     }
 }
 
-uint32_t Semantics::countPointersInChunks(const uint32_t index)
+NodeHandle Semantics::getChild(const NodeHandles children, const size_t index)
 {
-    auto &chunks = mState.getChunks();
-    const auto chunksSize = chunks.size();
-    uint32_t ptrCount = 0;
-    for (uint32_t i = index; i < chunksSize; ++i)
+    if (index >= children.size())
     {
-        if (chunks[index].mType == SyntaxChunkType::kPointer)
-        {
-            ptrCount++;
-        }
-        else
-        {
-            break;
-        }
+        return kNoNode;
     }
 
-    chunks.erase(chunks.begin() + index, chunks.begin() + index + ptrCount);
-
-    return ptrCount;
-}
-
-void Semantics::printStagedNodes(const std::string &str)
-{
-    log("\nSTAGED NODES [ % ], staged nodes:", Color::Green, str);
-    auto &stagedNodes = mState.getStagedNodes();
-    for (auto &it : stagedNodes)
-    {
-        log("\tstaged node: [ % ] %", Color::Green, it->getTypeStr(), it->toStr());
-    }
+    return children.begin()[index];
 }
 
 void Semantics::setPrevReducePos(const uint32_t pos)
@@ -4,9 +4,14 @@
 #include "SyntaxChunkTypes.hpp"
 #include "semantic_nodes/SemNode.hpp"
 
+#include <cassert>
 #include <cstdint>
 #include <filesystem>
+#include <initializer_list>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace safec
 {
@@ -16,63 +21,108 @@ namespace fs = ::std::filesystem;
 class SemNodeWalker;
 class WalkerStrategy;
 
+// Handle of a node created while parsing, carried in the bison semantic
+// values ($$, $1, ...). Equal to the node id in the translation unit.
+using NodeHandle = uint32_t;
+using NodeHandles = std::initializer_list<NodeHandle>;
+
+static constexpr NodeHandle kNoNode = SemNode::kInvalidId;
+
+// Semantic analysis of a single translation unit. Each parse job
+// creates its own instance, which owns the resulting AST.
 class Semantics
 {
 public:
-    Semantics();
+    Semantics(const fs::path &path);
 
     Semantics(const Semantics &) = delete;
     Semantics(Semantics &&) = delete;
     Semantics &operator=(const Semantics &) = delete;
     Semantics &operator=(Semantics &&) = delete;
 
-    void newTranslationUnit(const fs::path &path);
     void walk(SemNodeWalker &walker, WalkerStrategy &strategy);
 
-    void handle( //
+    // builds the node for a grammar reduction from the handles of its
+    // children, returns the handle passed up as $$ (or kNoNode)
+    NodeHandle handle( //
         const SyntaxChunkType type,
         const uint32_t stringIndex,
-        const std::string &additional = "");
+        const std::string_view additional = {},
+        const NodeHandles children = {});
 
     std::shared_ptr<SemNodeTranslationUnit> getAst() const;
 
+    // typedef name lookup for the lexer, follows the current scope
+    bool isTypeName(const std::string_view name) const;
+
+    // stable copy of name, lives as long as this instance
+    const std::string &intern(const std::string_view name);
+
 private:
     std::shared_ptr<SemNodeTranslationUnit> mTranslationUnit;
 
     SemanticsState mState;
 
-    void handleFunctionHeader(const uint32_t stringIndex, const bool isVoidRetType);
-    void handleFunctionEnd(const uint32_t stringIndex);
-    void handleInitDeclaration(const uint32_t stringIndex, const bool withAssignment);
-    void handleAssignment(const uint32_t stringIndex);
-    void handleRelationalExpression(const uint32_t stringIndex, const std::string &op);
-    void handlePostfixExpression(const uint32_t stringIndex, const std::string &op);
-    void handleForLoopConditions(const uint32_t pos);
-    void handleConditionExpression(const uint32_t stringIndex);
-    void handleBinaryOp(const uint32_t stringIndex, const std::string &op);
-    void handleReturn(const uint32_t stringIndex, const std::string &additional);
-    void handleUnaryOp(const uint32_t stringIndex, const std::string &additional);
-    void handleSimpleExpr(const uint32_t stringIndex);
-    void handleJumpStatement(const uint32_t stringIndex, const std::string &stmtName);
-    void handleWhileLoopConditions(const uint32_t stringIndex);
-    void handleDirectDecl(const uint32_t stringIndex, const std::string &additional);
-    void handleInitializerList(const uint32_t stringIndex);
-    void handleDefer(const uint32_t stringIndex);
-    void handleSwitchStatement(const uint32_t stringIndex);
-    void handleSwitchEnd(const uint32_t stringIndex);
-    void handleSwitchCaseHeader(const uint32_t stringIndex, const std::string &additional);
-    void handleSwitchCaseEnd(const uint32_t stringIndex);
+    using HandlerType = NodeHandle (Semantics::*)( //
+        const uint32_t stringIndex,
+        const std::string_view additional,
+        const NodeHandles children);
 
-    void addNodeToAst(std::shared_ptr<SemNode> node);
+// clang-format off
+    #define SYNTAXCHUNKTYPE_HANDLER_DECL(x, name) \
+        NodeHandle on##name(const uint32_t stringIndex, const std::string_view additional, const NodeHandles children);
+
+    // chunk handlers, Semantics::handle() dispatches through a table of these
+    SYNTAXCHUNKTYPE_ENUM(SYNTAXCHUNKTYPE_HANDLER_DECL)
 
-    void foldUnaryOps(const size_t start);
+    #undef SYNTAXCHUNKTYPE_HANDLER_DECL
+    // clang-format on
 
-    uint32_t countPointersInChunks(const uint32_t index);
+    void addNodeToAst(std::shared_ptr<SemNode> node);
 
-    void printStagedNodes(const std::string &str = "");
+    // applies the declaration type to all declarators in the list and
+    // declares them in the current scope
+    void declareList(const NodeHandle declList, const std::string_view type, const SymbolTable::Kind kind);
+
+    // create a node with an id from this translation unit
+    template <typename TSemNode, typename... TArgs>
+    std::shared_ptr<TSemNode> makeNode(TArgs &&...args)
+    {
+        auto node = std::make_shared<TSemNode>(std::forward<TArgs>(args)...);
+        mTranslationUnit->registerNode(node);
+
+        const uint32_t id = node->getId();
+        if (id >= mNodes.size())
+        {
+            mNodes.resize(mTranslationUnit->getNodeCount());
+        }
+        mNodes[id] = node;
+
+        return node;
+    }
+
+    template <typename TSemNode = SemNode>
+    std::shared_ptr<TSemNode> getNode(const NodeHandle handle) const
+    {
+        if (handle == kNoNode)
+        {
+            return nullptr;
+        }
+
+        assert(handle < mNodes.size());
+        assert(mNodes[handle]);
+        return std::static_pointer_cast<TSemNode>(mNodes[handle]);
+    }
+
+    // handle of the index-th child, kNoNode if the reduction has fewer children
+    static NodeHandle getChild(const NodeHandles children, const size_t index);
 
     void setPrevReducePos(const uint32_t pos);
 
+    // nodes created while parsing, indexed by handle - keeps the nodes
+    // referenced only from the parser stack alive until they are attached
+    std::vector<std::shared_ptr<SemNode>> mNodes;
+
     uint32_t mPrevReducePos;
 };
 
@@ -1,18 +0,0 @@
-#pragma once
-
-#include "Semantics.hpp"
-
-namespace safec
-{
-
-class SemanticsFactory final
-{
-public:
-    static Semantics &get()
-    {
-        static Semantics sem;
-        return sem;
-    }
-};
-
-} // namespace safec
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stdbool.h>
+
+// true if name is a typedef name visible in the current scope of
+// the translation unit being parsed
+bool SemanticsIsTypeName(const char *name);
@@ -1,11 +1,10 @@
 #pragma once
 
-#include "SyntaxChunkTypes.hpp"
-#include "logger/Logger.hpp"
+#include "SymbolTable.hpp"
 #include "semantic_nodes/SemNode.hpp"
 
+#include <cassert>
 #include <memory>
-#include <string>
 #include <vector>
 
 namespace safec
@@ -13,127 +12,47 @@ namespace safec
 
 class SemNode;
 
-enum class SState
-{
-    Idle,
-    WaitingForStructType,
-    InForLoopContext,
-    WaitingForDeferredOp,
-};
-
-struct SyntaxChunkInfo
-{
-    SyntaxChunkInfo()
-        : mType{SyntaxChunkType::kUnknown}
-        , mPos{0}
-        , mAdditional{}
-    {
-    }
-
-    SyntaxChunkInfo(const SyntaxChunkType type, const uint32_t pos)
-        : mType{type}
-        , mPos{pos}
-        , mAdditional{}
-    {
-    }
-
-    SyntaxChunkInfo(const SyntaxChunkType type, const uint32_t pos, const std::string &additional)
-        : mType{type}
-        , mPos{pos}
-        , mAdditional{additional}
-    {
-    }
-
-    SyntaxChunkType mType;
-    uint32_t mPos;
-    std::string mAdditional;
-};
-
 class SemanticsState
 {
 public:
-    SState mState;
-    std::shared_ptr<SemNode> mDeferNodeWaitingForDeferredOp;
-
-    using StagedNodesType = std::vector<std::shared_ptr<SemNode>>;
-
     SemanticsState() //
-        : mState{SState::Idle}
-        , mSyntaxChunks{}
+        : mScope{}
+        , mSymbols{}
     {
     }
 
-    void addChunk(SyntaxChunkInfo &&chunk)
-    {
-        mSyntaxChunks.emplace_back(chunk);
-    }
-
-    std::vector<SyntaxChunkInfo> &getChunks()
-    {
-        return mSyntaxChunks;
-    }
-
-    void printChunks(const std::string &str = "") const
-    {
-        log("\n--- SYNTAX CHUNKS [ % ] (chunks count: %):",
-            Color::Green, //
-            str,
-            mSyntaxChunks.size());
-        for (const auto &it : mSyntaxChunks)
-        {
-            log("---\t-> chunk type: %, pos: %, additional: '%'",
-                Color::Green, //
-                syntaxChunkTypeToStr(it.mType),
-                it.mPos,
-                it.mAdditional);
-        }
-    }
-
     std::shared_ptr<SemNode> getCurrentScope()
     {
         assert(mScope.size() > 0);
         return mScope.back();
     }
 
-    void addStagedNodesToCurrentScope()
-    {
-        auto currentScope = getCurrentScope();
-
-        for (auto &it : mStagedNodes)
-        {
-            currentScope->attach(it);
-        }
-
-        mStagedNodes.clear();
-    }
-
     void addScope(std::shared_ptr<SemNode> node)
     {
-        // addStagedNodesToCurrentScope();
         mScope.push_back(node);
+        mSymbols.pushScope();
     }
 
     void removeScope()
     {
-        addStagedNodesToCurrentScope();
+        assert(mScope.size() > 0);
         mScope.pop_back();
+        mSymbols.popScope();
     }
 
-    void stageNode(std::shared_ptr<SemNode> node)
+    SymbolTable &getSymbols()
     {
-        mStagedNodes.push_back(node);
+        return mSymbols;
     }
 
-    std::vector<std::shared_ptr<SemNode>> &getStagedNodes()
+    const SymbolTable &getSymbols() const
     {
-        return mStagedNodes;
+        return mSymbols;
     }
 
 private:
-    std::vector<SyntaxChunkInfo> mSyntaxChunks;
     std::vector<std::shared_ptr<SemNode>> mScope;
-
-    std::vector<std::shared_ptr<SemNode>> mStagedNodes;
+    SymbolTable mSymbols;
 };
 
 } // namespace safec
@@ -0,0 +1,82 @@
+#include "SymbolTable.hpp"
+
+#include <cassert>
+
+namespace safec
+{
+
+SymbolTable::SymbolTable() //
+    : mNames{}
+    , mNameIndex{}
+    , mSymbols{}
+    , mScopes{}
+{
+}
+
+void SymbolTable::pushScope()
+{
+    mScopes.emplace_back();
+}
+
+void SymbolTable::popScope()
+{
+    assert(mScopes.size() > 0);
+
+    for (const auto &name : mScopes.back())
+    {
+        auto it = mSymbols.find(name);
+        assert(it != mSymbols.end());
+        assert(it->second.empty() == false);
+
+        it->second.pop_back();
+    }
+
+    mScopes.pop_back();
+}
+
+void SymbolTable::declare(const std::string_view name, const Kind kind)
+{
+    assert(mScopes.size() > 0);
+
+    const std::string_view key = intern(name);
+    const auto scopeDepth = static_cast<uint32_t>(mScopes.size());
+
+    auto &declarations = mSymbols[key];
+    if ((declarations.empty() == false) && (declarations.back().mScopeDepth == scopeDepth))
+    {
+        // redeclaration in the same scope
+        declarations.back().mKind = kind;
+        return;
+    }
+
+    declarations.push_back({kind, scopeDepth});
+    mScopes.back().push_back(key);
+}
+
+bool SymbolTable::isTypeName(const std::string_view name) const
+{
+    const auto it = mSymbols.find(name);
+    if ((it == mSymbols.end()) || it->second.empty())
+    {
+        return false;
+    }
+
+    return (it->second.back().mKind == Kind::Type);
+}
+
+const std::string &SymbolTable::intern(const std::string_view name)
+{
+    const auto it = mNameIndex.find(name);
+    if (it != mNameIndex.end())
+    {
+        return mNames[it->second];
+    }
+
+    const auto index = static_cast<uint32_t>(mNames.size());
+    const std::string &interned = mNames.emplace_back(name);
+    mNameIndex.emplace(interned, index);
+
+    return interned;
+}
+
+} // namespace safec
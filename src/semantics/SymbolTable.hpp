@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace safec
+{
+
+// Scoped symbol table used while parsing, mainly to let the lexer tell
+// typedef names from identifiers. Names are interned, every symbol
+// keeps a stack of declarations so inner scopes can shadow outer ones.
+class SymbolTable
+{
+public:
+    enum class Kind
+    {
+        Object, // variables, functions, parameters
+        Type,   // typedef names
+    };
+
+    SymbolTable();
+
+    void pushScope();
+    void popScope();
+
+    void declare(const std::string_view name, const Kind kind);
+
+    bool isTypeName(const std::string_view name) const;
+
+    // returns the interned copy of name, stable for the table lifetime
+    const std::string &intern(const std::string_view name);
+
+private:
+    struct Symbol
+    {
+        Kind mKind;
+        uint32_t mScopeDepth;
+    };
+
+    // interned names, deque keeps the strings in place when growing
+    std::deque<std::string> mNames;
+    std::unordered_map<std::string_view, uint32_t> mNameIndex;
+
+    // visible declarations of a name, innermost last
+    std::unordered_map<std::string_view, std::vector<Symbol>> mSymbols;
+
+    // names declared in each open scope, to be dropped on popScope()
+    std::vector<std::vector<std::string_view>> mScopes;
+};
+
+} // namespace safec
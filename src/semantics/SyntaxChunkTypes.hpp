@@ -6,55 +6,65 @@
 // clang-format off
 
 // TODO: duplicate with SEMNODE_TYPE_SELECTOR_VALUE, move to common header
-#define SYNTAXCHUNKTYPE_LIST(x) x,
-#define SYNTAXCHUNKTYPE_TOSTR(x)   \
+#define SYNTAXCHUNKTYPE_LIST(x, name) x,
+#define SYNTAXCHUNKTYPE_TOSTR(x, name)   \
     case SyntaxChunkType::x: {                             \
         return #x;                              \
     }                                           \
     break;
 
+// entry(enumerator, name), the name selects the Semantics::on<name>() handler
 #define SYNTAXCHUNKTYPE_ENUM(entry) \
-    entry(kUnknown) \
-    entry(kFunctionHeader) \
-    entry(kFunction) \
-    entry(kStructOrUnionDecl) \
-    entry(kEnumDecl) \
-    entry(kType) \
-    entry(kDirectDecl) \
-    entry(kPointer) \
-    entry(kConstant) \
-    entry(kIdentifier) \
-    entry(kInitDeclaration) \
-    entry(kAssignment) \
-    entry(kAssignmentOperator) \
-    entry(kConditionHeader) \
-    entry(kConditionExpression) \
-    entry(kCondition) \
-    entry(kForLoopHeader) \
-    entry(kForLoopConditions) \
-    entry(kForLoop) \
-    entry(kWhileLoopHeader) \
-    entry(kWhileLoopConditions) \
-    entry(kWhileLoop) \
-    entry(kRelationalExpression) \
-    entry(kPostfixExpression) \
-    entry(kEmptyStatement) \
-    entry(kReturn) \
-    entry(kUnaryOp) \
-    entry(kBinaryOp) \
-    entry(kSimpleExpr) /* needed? */ \
-    entry(kJumpStatement) \
-    entry(kArrayDecl) \
-    entry(kInitializerList) \
-    entry(kDeferHeader) \
-    entry(kDefer) \
-    entry(kSimpleScopeStart) \
-    entry(kSimpleScopeEnd) \
-    entry(kSwitchHeader) \
-    entry(kSwitchStatement) \
-    entry(kSwitchEnd) \
-    entry(kSwitchCaseHeader) \
-    entry(kSwitchCaseEnd)
+    entry(kUnknown, Unknown) \
+    entry(kFunctionHeader, FunctionHeader) \
+    entry(kFunction, Function) \
+    entry(kDeclaration, Declaration) \
+    entry(kTypeDefinition, TypeDefinition) \
+    entry(kDirectDecl, DirectDecl) \
+    entry(kPointer, Pointer) \
+    entry(kArrayDecl, ArrayDecl) \
+    entry(kFunctionDecl, FunctionDecl) \
+    entry(kParameter, Parameter) \
+    entry(kList, List) \
+    entry(kConstant, Constant) \
+    entry(kIdentifier, Identifier) \
+    entry(kInitDeclaration, InitDeclaration) \
+    entry(kConditionHeader, ConditionHeader) \
+    entry(kConditionExpression, ConditionExpression) \
+    entry(kCondition, Condition) \
+    entry(kForLoopHeader, ForLoopHeader) \
+    entry(kForLoopConditions, ForLoopConditions) \
+    entry(kForLoop, ForLoop) \
+    entry(kWhileLoopHeader, WhileLoopHeader) \
+    entry(kWhileLoopConditions, WhileLoopConditions) \
+    entry(kWhileLoop, WhileLoop) \
+    entry(kDoLoopHeader, DoLoopHeader) \
+    entry(kDoLoop, DoLoop) \
+    entry(kPostfixExpression, PostfixExpression) \
+    entry(kEmptyStatement, EmptyStatement) \
+    entry(kReturn, Return) \
+    entry(kUnaryOp, UnaryOp) \
+    entry(kBinaryOp, BinaryOp) \
+    entry(kSimpleExpr, SimpleExpr) \
+    entry(kExpressionStatement, ExpressionStatement) \
+    entry(kJumpStatement, JumpStatement) \
+    entry(kGoto, Goto) \
+    entry(kInitializerList, InitializerList) \
+    entry(kDeferHeader, DeferHeader) \
+    entry(kDefer, Defer) \
+    entry(kSimpleScopeStart, SimpleScopeStart) \
+    entry(kSimpleScopeEnd, SimpleScopeEnd) \
+    entry(kSwitchHeader, SwitchHeader) \
+    entry(kSwitchStatement, SwitchStatement) \
+    entry(kSwitchEnd, SwitchEnd) \
+    entry(kSwitchCaseHeader, SwitchCaseHeader) \
+    entry(kSwitchCaseEnd, SwitchCaseEnd) \
+    entry(kGenericHeader, GenericHeader) \
+    entry(kGenericParameters, GenericParameters) \
+    entry(kGenericDefinition, GenericDefinition) \
+    entry(kGenericInstance, GenericInstance) \
+    entry(kStaticAssertHeader, StaticAssertHeader) \
+    entry(kStaticAssert, StaticAssert)
 // clang-format on
 
 enum class SyntaxChunkType : uint32_t
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+namespace safec
+{
+
+// Binary AST file layout, all values in host byte order:
+//
+//  AstBinaryHeader
+//  AstBinaryNode[mNodeCount]         - breadth-first, so children of each
+//                                      node are a contiguous index range
+//  AstBinaryString[mStringCount]     - per-node strings (names, operators)
+//  char[mStringTableSize]            - deduplicated, NUL-terminated strings
+//
+// Bump kAstBinaryVersion on any change of the structures below.
+
+static constexpr char kAstBinaryMagic[8] = {'S', 'A', 'F', 'E', 'C', 'A', 'S', 'T'};
+static constexpr uint32_t kAstBinaryVersion = 1;
+
+struct AstBinaryHeader
+{
+    char mMagic[8];
+    uint32_t mVersion;
+    uint32_t mNodeCount;
+    uint32_t mStringCount;
+    uint32_t mStringTableSize;
+};
+
+struct AstBinaryNode
+{
+    // node position info is either the scope start & end
+    // or the single position of SemNodePositional
+    static constexpr uint32_t kFlagScope = (1 << 0);
+    static constexpr uint32_t kFlagPositional = (1 << 1);
+    static constexpr uint32_t kFlagFallthrough = (1 << 2);
+
+    uint32_t mType; // SemNode::Type
+    uint32_t mDirty; // SemNode::DirtyType
+    uint32_t mId;
+    uint32_t mSemStart;
+    uint32_t mSemEnd;
+    uint32_t mFirstChild;
+    uint32_t mChildCount;
+    uint32_t mFirstString;
+    uint32_t mStringCount;
+    uint32_t mPosStart;
+    uint32_t mPosEnd;
+    uint32_t mFlags;
+};
+
+// string in the string table, the length excludes the terminating NUL
+struct AstBinaryString
+{
+    uint32_t mOffset;
+    uint32_t mLength;
+};
+
+} // namespace safec
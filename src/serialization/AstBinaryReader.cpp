@@ -0,0 +1,220 @@
+#include "AstBinaryReader.hpp"
+
+#include "logger/Logger.hpp"
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace safec
+{
+
+AstBinaryReader::AstBinaryReader()
+    : mMapping{nullptr}
+    , mMappingSize{0}
+    , mHeader{nullptr}
+    , mNodes{nullptr}
+    , mStrings{nullptr}
+    , mStringTable{nullptr}
+{
+}
+
+AstBinaryReader::~AstBinaryReader()
+{
+    close();
+}
+
+bool AstBinaryReader::open(const std::filesystem::path &path)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        log("failed to open file %, error: %", Color::Red, path.c_str(), strerror(errno));
+        return false;
+    }
+
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) != 0) || (static_cast<size_t>(fileStat.st_size) < sizeof(AstBinaryHeader)))
+    {
+        log("binary AST % is too short", Color::Red, path.c_str());
+        ::close(fd);
+        return false;
+    }
+
+    mMappingSize = static_cast<size_t>(fileStat.st_size);
+    mMapping = mmap(nullptr, mMappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (mMapping == MAP_FAILED)
+    {
+        log("failed to map file %, error: %", Color::Red, path.c_str(), strerror(errno));
+        mMapping = nullptr;
+        return false;
+    }
+
+    const char *const base = static_cast<const char *>(mMapping);
+    mHeader = reinterpret_cast<const AstBinaryHeader *>(base);
+
+    if (memcmp(mHeader->mMagic, kAstBinaryMagic, sizeof(kAstBinaryMagic)) != 0)
+    {
+        log("% is not a binary AST file", Color::Red, path.c_str());
+        close();
+        return false;
+    }
+
+    if (mHeader->mVersion != kAstBinaryVersion)
+    {
+        log("binary AST % has version %, expected %", //
+            Color::Red,
+            path.c_str(),
+            mHeader->mVersion,
+            kAstBinaryVersion);
+        close();
+        return false;
+    }
+
+    const size_t nodesOffset = sizeof(AstBinaryHeader);
+    const size_t stringsOffset = nodesOffset + (size_t{mHeader->mNodeCount} * sizeof(AstBinaryNode));
+    const size_t stringTableOffset = stringsOffset + (size_t{mHeader->mStringCount} * sizeof(AstBinaryString));
+    const size_t expectedSize = stringTableOffset + mHeader->mStringTableSize;
+
+    if ((expectedSize != mMappingSize) || (mHeader->mNodeCount == 0))
+    {
+        log("binary AST % is corrupted", Color::Red, path.c_str());
+        close();
+        return false;
+    }
+
+    mNodes = reinterpret_cast<const AstBinaryNode *>(base + nodesOffset);
+    mStrings = reinterpret_cast<const AstBinaryString *>(base + stringsOffset);
+    mStringTable = base + stringTableOffset;
+
+    if (validate() == false)
+    {
+        log("binary AST % is corrupted", Color::Red, path.c_str());
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool AstBinaryReader::validate() const
+{
+    // single pass over the ranges, so the accessors do not have to check
+    // them, children always follow the parent in breadth-first order
+    for (uint32_t idx = 0; idx < mHeader->mNodeCount; idx++)
+    {
+        const AstBinaryNode &node = mNodes[idx];
+        if (((node.mChildCount > 0) && (node.mFirstChild <= idx)) ||
+            ((uint64_t{node.mFirstChild} + node.mChildCount) > mHeader->mNodeCount) ||
+            ((uint64_t{node.mFirstString} + node.mStringCount) > mHeader->mStringCount))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t idx = 0; idx < mHeader->mStringCount; idx++)
+    {
+        const AstBinaryString &str = mStrings[idx];
+        if ((uint64_t{str.mOffset} + str.mLength) >= mHeader->mStringTableSize)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void AstBinaryReader::close()
+{
+    if (mMapping != nullptr)
+    {
+        munmap(mMapping, mMappingSize);
+    }
+
+    mMapping = nullptr;
+    mMappingSize = 0;
+    mHeader = nullptr;
+    mNodes = nullptr;
+    mStrings = nullptr;
+    mStringTable = nullptr;
+}
+
+uint32_t AstBinaryReader::getNodeCount() const
+{
+    return (mHeader != nullptr) ? mHeader->mNodeCount : 0;
+}
+
+const AstBinaryNode &AstBinaryReader::getNode(const uint32_t index) const
+{
+    assert(index < getNodeCount());
+    return mNodes[index];
+}
+
+std::string_view AstBinaryReader::getString(const AstBinaryNode &node, const uint32_t index) const
+{
+    assert(index < node.mStringCount);
+    assert((node.mFirstString + index) < mHeader->mStringCount);
+
+    const AstBinaryString &str = mStrings[node.mFirstString + index];
+    assert((str.mOffset + str.mLength) < mHeader->mStringTableSize);
+
+    return std::string_view{mStringTable + str.mOffset, str.mLength};
+}
+
+void AstBinaryReader::print() const
+{
+    if (getNodeCount() > 0)
+    {
+        printNode(0, 0);
+    }
+}
+
+void AstBinaryReader::printNode(const uint32_t index, const uint32_t level) const
+{
+    // clang-format off
+    #define SEMNODE_TYPE_SELECTOR_NAME(x) #x,
+    // clang-format on
+
+    static constexpr const char *kTypeNames[] = {SEMNODE_TYPE_ENUMERATE(SEMNODE_TYPE_SELECTOR_NAME)};
+
+    const AstBinaryNode &node = getNode(index);
+
+    std::string line(level, '\t');
+    line += "[" + std::to_string(level) + "] ";
+    line += (node.mType < std::size(kTypeNames)) ? kTypeNames[node.mType] : "?";
+
+    for (uint32_t idx = 0; idx < node.mStringCount; idx++)
+    {
+        line += " '";
+        line += getString(node, idx);
+        line += "'";
+    }
+
+    if ((node.mFlags & AstBinaryNode::kFlagFallthrough) != 0)
+    {
+        line += " fallthrough";
+    }
+
+    line += " { " + std::to_string(node.mSemStart) + " -- " + std::to_string(node.mSemEnd) + " }";
+
+    log("%", line);
+
+    assert((node.mFirstChild + node.mChildCount) <= getNodeCount());
+    for (uint32_t idx = 0; idx < node.mChildCount; idx++)
+    {
+        printNode(node.mFirstChild + idx, level + 1);
+    }
+}
+
+} // namespace safec
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "AstBinaryFormat.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace safec
+{
+
+// Read-only view of a binary AST file. The file is memory-mapped and the
+// nodes are accessed in place, nothing is allocated per node.
+class AstBinaryReader
+{
+public:
+    AstBinaryReader();
+    ~AstBinaryReader();
+
+    AstBinaryReader(const AstBinaryReader &) = delete;
+    AstBinaryReader &operator=(const AstBinaryReader &) = delete;
+
+    // maps and validates the file, logs the reason on failure
+    bool open(const std::filesystem::path &path);
+    void close();
+
+    uint32_t getNodeCount() const;
+
+    // node 0 is the translation unit, the children of a node are the
+    // nodes [mFirstChild, mFirstChild + mChildCount)
+    const AstBinaryNode &getNode(const uint32_t index) const;
+
+    std::string_view getString(const AstBinaryNode &node, const uint32_t index) const;
+
+    // prints the tree in a WalkerPrint-like format
+    void print() const;
+
+private:
+    void *mMapping;
+    size_t mMappingSize;
+
+    const AstBinaryHeader *mHeader;
+    const AstBinaryNode *mNodes;
+    const AstBinaryString *mStrings;
+    const char *mStringTable;
+
+    bool validate() const;
+    void printNode(const uint32_t index, const uint32_t level) const;
+};
+
+} // namespace safec
@@ -0,0 +1,231 @@
+#include "AstBinaryWriter.hpp"
+
+#include "logger/Logger.hpp"
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace safec
+{
+
+bool AstBinaryWriter::write(const SemNodeTranslationUnit &ast, const std::filesystem::path &outputFile)
+{
+    mNodes.clear();
+    mStrings.clear();
+    mStringTable.clear();
+    mStringOffsets.clear();
+
+    // breadth-first, the queue is the node order in the file
+    std::vector<const SemNode *> queue;
+    queue.push_back(&ast);
+
+    for (size_t idx = 0; idx < queue.size(); idx++)
+    {
+        const SemNode &node = *queue[idx];
+        addNode(node, static_cast<uint32_t>(queue.size()));
+
+        for (const auto &it : node.getAttachedNodes())
+        {
+            queue.push_back(it.get());
+        }
+    }
+
+    AstBinaryHeader header;
+    memcpy(header.mMagic, kAstBinaryMagic, sizeof(header.mMagic));
+    header.mVersion = kAstBinaryVersion;
+    header.mNodeCount = static_cast<uint32_t>(mNodes.size());
+    header.mStringCount = static_cast<uint32_t>(mStrings.size());
+    header.mStringTableSize = static_cast<uint32_t>(mStringTable.size());
+
+    FILE *fp = fopen(outputFile.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        log("failed to open file %, error: %", //
+            Color::Red,
+            outputFile.c_str(),
+            strerror(errno));
+        return false;
+    }
+
+    bool ok = (fwrite(&header, sizeof(header), 1, fp) == 1);
+    ok = ok && (fwrite(mNodes.data(), sizeof(AstBinaryNode), mNodes.size(), fp) == mNodes.size());
+    ok = ok && (fwrite(mStrings.data(), sizeof(AstBinaryString), mStrings.size(), fp) == mStrings.size());
+    ok = ok && (fwrite(mStringTable.data(), 1, mStringTable.size(), fp) == mStringTable.size());
+
+    if (ok == false)
+    {
+        log("failed to write binary AST to %, error: %", //
+            Color::Red,
+            outputFile.c_str(),
+            strerror(errno));
+    }
+
+    fclose(fp);
+    return ok;
+}
+
+void AstBinaryWriter::addNode(const SemNode &node, const uint32_t firstChild)
+{
+    AstBinaryNode record{};
+    record.mType = static_cast<uint32_t>(node.getType());
+    record.mDirty = static_cast<uint32_t>(node.getDirty());
+    record.mId = node.getId();
+    record.mSemStart = node.getSemStart();
+    record.mSemEnd = node.getSemEnd();
+    record.mFirstChild = firstChild;
+    record.mChildCount = static_cast<uint32_t>(node.getAttachedNodes().size());
+    record.mFirstString = static_cast<uint32_t>(mStrings.size());
+
+    const auto setScope = [&record](const SemNodeScope &scope) {
+        record.mFlags |= AstBinaryNode::kFlagScope;
+        record.mPosStart = scope.getStart();
+        record.mPosEnd = scope.getEnd();
+    };
+
+    const auto setPositional = [&record](const SemNodePositional &positional) {
+        record.mFlags |= AstBinaryNode::kFlagPositional;
+        record.mPosStart = positional.getPos();
+        record.mPosEnd = positional.getPos();
+    };
+
+    switch (node.getType())
+    {
+        case SemNode::Type::TranslationUnit:
+            addString(record, static_cast<const SemNodeTranslationUnit &>(node).getSourcePath().string());
+            break;
+
+        case SemNode::Type::Function:
+        {
+            const auto &function = static_cast<const SemNodeFunction &>(node);
+            setScope(function);
+            addString(record, function.getName());
+            addString(record, function.getReturn());
+            for (const auto &it : function.getParams())
+            {
+                addString(record, it.mType);
+                addString(record, it.mName);
+            }
+        }
+        break;
+
+        case SemNode::Type::Loop:
+        {
+            const auto &loop = static_cast<const SemNodeLoop &>(node);
+            setScope(loop);
+            addString(record, loop.getName());
+        }
+        break;
+
+        case SemNode::Type::SwitchCaseLabel:
+        {
+            const auto &label = static_cast<const SemNodeSwitchCaseLabel &>(node);
+            setScope(label);
+            if (label.getIsFallthrough())
+            {
+                record.mFlags |= AstBinaryNode::kFlagFallthrough;
+            }
+        }
+        break;
+
+        case SemNode::Type::Scope:
+        case SemNode::Type::If:
+        case SemNode::Type::SwitchCase:
+            setScope(static_cast<const SemNodeScope &>(node));
+            break;
+
+        case SemNode::Type::Identifier:
+            setPositional(static_cast<const SemNodePositional &>(node));
+            addString(record, static_cast<const SemNodeIdentifier &>(node).getName());
+            break;
+
+        case SemNode::Type::Constant:
+            setPositional(static_cast<const SemNodePositional &>(node));
+            addString(record, static_cast<const SemNodeConstant &>(node).getName());
+            break;
+
+        case SemNode::Type::Declaration:
+        {
+            const auto &declaration = static_cast<const SemNodeDeclaration &>(node);
+            setPositional(declaration);
+            addString(record, declaration.getLhsType());
+            addString(record, declaration.getLhsIdentifier());
+        }
+        break;
+
+        case SemNode::Type::PostfixExpression:
+            setPositional(static_cast<const SemNodePositional &>(node));
+            addString(record, static_cast<const SemNodePostfixExpression &>(node).getOperator());
+            break;
+
+        case SemNode::Type::BinaryOp:
+            setPositional(static_cast<const SemNodePositional &>(node));
+            addString(record, static_cast<const SemNodeBinaryOp &>(node).getOp());
+            break;
+
+        case SemNode::Type::UnaryOp:
+        case SemNode::Type::JumpStatement:
+            // the operator / jump keyword
+            setPositional(static_cast<const SemNodePositional &>(node));
+            addString(record, node.toStr());
+            break;
+
+        case SemNode::Type::GeneratedCode:
+            setPositional(static_cast<const SemNodePositional &>(node));
+            addString(record, static_cast<const SemNodeGeneratedCode &>(node).getCode());
+            break;
+
+        case SemNode::Type::Generic:
+        {
+            const auto &generic = static_cast<const SemNodeGeneric &>(node);
+            setScope(generic);
+            for (const auto &it : generic.getParams())
+            {
+                addString(record, it);
+            }
+        }
+        break;
+
+        case SemNode::Type::GenericInstance:
+            setPositional(static_cast<const SemNodePositional &>(node));
+            addString(record, static_cast<const SemNodeGenericInstance &>(node).getName());
+            break;
+
+        case SemNode::Type::StaticAssert:
+            setPositional(static_cast<const SemNodePositional &>(node));
+            addString(record, static_cast<const SemNodeStaticAssert &>(node).getMessage());
+            break;
+
+        case SemNode::Type::Return:
+        case SemNode::Type::EmptyStatement:
+        case SemNode::Type::InitializerList:
+        case SemNode::Type::Group:
+        case SemNode::Type::Defer:
+            setPositional(static_cast<const SemNodePositional &>(node));
+            break;
+
+        case SemNode::Type::Undefined:
+            break;
+    }
+
+    mNodes.push_back(record);
+}
+
+void AstBinaryWriter::addString(AstBinaryNode &record, const std::string &str)
+{
+    auto it = mStringOffsets.find(str);
+    if (it == mStringOffsets.end())
+    {
+        const uint32_t offset = static_cast<uint32_t>(mStringTable.size());
+        mStringTable.append(str);
+        mStringTable.push_back('\0');
+
+        it = mStringOffsets.emplace(str, offset).first;
+    }
+
+    mStrings.push_back(AstBinaryString{it->second, static_cast<uint32_t>(str.size())});
+    record.mStringCount++;
+}
+
+} // namespace safec
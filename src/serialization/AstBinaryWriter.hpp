@@ -0,0 +1,35 @@
+#pragma once
+
+#include "AstBinaryFormat.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace safec
+{
+
+class SemNode;
+class SemNodeTranslationUnit;
+
+// Serializes the AST of a translation unit into the binary format
+// described in AstBinaryFormat.hpp.
+class AstBinaryWriter
+{
+public:
+    bool write(const SemNodeTranslationUnit &ast, const std::filesystem::path &outputFile);
+
+private:
+    std::vector<AstBinaryNode> mNodes;
+    std::vector<AstBinaryString> mStrings;
+    std::string mStringTable;
+    std::unordered_map<std::string, uint32_t> mStringOffsets;
+
+    void addNode(const SemNode &node, const uint32_t firstChild);
+    void addString(AstBinaryNode &record, const std::string &str);
+};
+
+} // namespace safec
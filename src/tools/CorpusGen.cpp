@@ -0,0 +1,229 @@
+#include <boost/program_options.hpp>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace po = boost::program_options;
+
+// Generates synthetic SafeC sources for scaling tests. The output only
+// depends on the parameters, so the same corpus can be regenerated on
+// any machine.
+
+namespace
+{
+
+struct CorpusParams
+{
+    uint32_t mFunctions;
+    uint32_t mDepth;
+    uint32_t mDefers;
+    uint32_t mSwitchCases;
+    uint32_t mInitListLen;
+};
+
+class CorpusWriter
+{
+public:
+    CorpusWriter(std::ostream &out, const CorpusParams &params)
+        : mOut{out}
+        , mParams{params}
+    {
+    }
+
+    void write()
+    {
+        mOut << "// generated by SafeCCorpusGen: "                  //
+             << "functions " << mParams.mFunctions                  //
+             << ", depth " << mParams.mDepth                        //
+             << ", defers " << mParams.mDefers                      //
+             << ", switch cases " << mParams.mSwitchCases           //
+             << ", initializer list " << mParams.mInitListLen << "\n" //
+             << "\n"                                                //
+             << "#include <stdio.h>\n"                              //
+             << "\n";
+
+        for (uint32_t fn = 0; fn < mParams.mFunctions; fn++)
+        {
+            writeFunction(fn);
+        }
+    }
+
+private:
+    std::ostream &mOut;
+    const CorpusParams &mParams;
+
+    std::string indent(const uint32_t level) const
+    {
+        return std::string(level * 4, ' ');
+    }
+
+    void writeFunction(const uint32_t fn)
+    {
+        mOut << "int corpus_fn_" << fn << "(int *data, int len)\n"
+             << "{\n";
+
+        if (mParams.mInitListLen > 0)
+        {
+            writeInitList(fn);
+        }
+
+        mOut << indent(1) << "int result = 0;\n";
+        for (uint32_t level = 1; level <= mParams.mDepth; level++)
+        {
+            mOut << indent(1) << "int i" << level << ";\n";
+        }
+
+        writeDefers(fn, 0, 1);
+        mOut << "\n";
+
+        if (mParams.mDepth > 0)
+        {
+            writeNested(fn, 1);
+            mOut << "\n";
+        }
+
+        if (mParams.mSwitchCases > 0)
+        {
+            writeSwitch();
+        }
+
+        mOut << indent(1) << "return result;\n"
+             << "}\n"
+             << "\n";
+    }
+
+    void writeInitList(const uint32_t fn)
+    {
+        static constexpr uint32_t kValuesPerLine = 16;
+
+        mOut << indent(1) << "int values_" << fn << "[] = {";
+        for (uint32_t idx = 0; idx < mParams.mInitListLen; idx++)
+        {
+            if ((idx % kValuesPerLine) == 0)
+            {
+                mOut << "\n" << indent(2);
+            }
+
+            mOut << idx;
+            if ((idx + 1) < mParams.mInitListLen)
+            {
+                mOut << ((((idx + 1) % kValuesPerLine) == 0) ? "," : ", ");
+            }
+        }
+        mOut << "\n" << indent(1) << "};\n";
+    }
+
+    void writeDefers(const uint32_t fn, const uint32_t level, const uint32_t indentLevel)
+    {
+        for (uint32_t defer = 0; defer < mParams.mDefers; defer++)
+        {
+            mOut << indent(indentLevel) << "defer release(" << fn << ", " << level << ", " << defer << ");\n";
+        }
+    }
+
+    // every level opens a different kind of scope, the deepest one
+    // returns early so the defers have to be unwound through all of them
+    void writeNested(const uint32_t fn, const uint32_t level)
+    {
+        const uint32_t ind = level;
+
+        switch (level % 4)
+        {
+            case 1:
+                mOut << indent(ind) << "for (i" << level << " = 0; i" << level << " < len; i" << level << "++)\n";
+                break;
+            case 2:
+                mOut << indent(ind) << "while (result < " << (level * 100) << ")\n";
+                break;
+            case 3:
+                mOut << indent(ind) << "if (len > " << level << ")\n";
+                break;
+            default:
+                // plain scope
+                break;
+        }
+
+        mOut << indent(ind) << "{\n";
+        writeDefers(fn, level, ind + 1);
+        mOut << indent(ind + 1) << "result += data[" << level << "];\n";
+
+        if (level < mParams.mDepth)
+        {
+            writeNested(fn, level + 1);
+        }
+        else
+        {
+            mOut << indent(ind + 1) << "if (result < 0)\n"
+                 << indent(ind + 1) << "{\n"
+                 << indent(ind + 2) << "return -1;\n"
+                 << indent(ind + 1) << "}\n";
+        }
+
+        mOut << indent(ind) << "}\n";
+    }
+
+    void writeSwitch()
+    {
+        mOut << indent(1) << "switch (len)\n"
+             << indent(1) << "{\n";
+
+        for (uint32_t caseIdx = 0; caseIdx < mParams.mSwitchCases; caseIdx++)
+        {
+            mOut << indent(2) << "case " << caseIdx << ":\n"
+                 << indent(3) << "result += " << caseIdx << ";\n"
+                 << indent(3) << "break;\n";
+        }
+
+        mOut << indent(2) << "default:\n"
+             << indent(3) << "break;\n"
+             << indent(1) << "}\n"
+             << "\n";
+    }
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    CorpusParams params;
+
+    po::options_description desc("SafeC corpus generator options:");
+    desc.add_options()                                                                                         //
+        ("help,h", "print help")                                                                               //
+        ("output,o", po::value<std::string>(), "output .sc file (stdout if not set)")                          //
+        ("functions,n", po::value<uint32_t>(&params.mFunctions)->default_value(100), "number of functions")    //
+        ("depth,d", po::value<uint32_t>(&params.mDepth)->default_value(3), "scope nesting depth")              //
+        ("defers,k", po::value<uint32_t>(&params.mDefers)->default_value(1), "defers per scope")               //
+        ("switch-cases,s", po::value<uint32_t>(&params.mSwitchCases)->default_value(8), "switch fan-out")      //
+        ("init-list,l", po::value<uint32_t>(&params.mInitListLen)->default_value(16), "initializer list size");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") > 0)
+    {
+        std::cout << desc << std::endl;
+        return 0;
+    }
+
+    if (vm.count("output") > 0)
+    {
+        const auto &outputPath = vm["output"].as<std::string>();
+        std::ofstream out{outputPath, std::ios::trunc};
+        if (out.is_open() == false)
+        {
+            std::cerr << "cannot open output file " << outputPath << std::endl;
+            return -1;
+        }
+
+        CorpusWriter{out, params}.write();
+    }
+    else
+    {
+        CorpusWriter{std::cout, params}.write();
+    }
+
+    return 0;
+}
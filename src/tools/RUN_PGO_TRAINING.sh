@@ -0,0 +1,67 @@
+#!/bin/bash
+
+# Runs an instrumented transpiler (SAFEC_BUILD_PROFILE=release,
+# SAFEC_PGO=generate) over the test files and a synthetic corpus, then
+# merges the raw profiles for the SAFEC_PGO=use build.
+#
+# usage: RUN_PGO_TRAINING.sh <output .profdata>
+#
+# SAFEC_PATH            - instrumented transpiler binary
+# SAFEC_CORPUSGEN_PATH  - corpus generator binary
+# LLVM_PROFDATA         - llvm-profdata binary matching the clang version
+
+if [ -z "$1" ];
+then
+    echo "usage: $0 <output .profdata>"
+    exit 1
+fi
+
+OUTPUT_PROFILE=$(realpath -m "$1")
+
+if [ -z "$SAFEC_PATH" ];
+then
+    SAFEC_PATH=../../build/bin/SafeCTranspiler
+fi
+
+if [ -z "$SAFEC_CORPUSGEN_PATH" ];
+then
+    SAFEC_CORPUSGEN_PATH=../../build/bin/SafeCCorpusGen
+fi
+
+if [ -z "$LLVM_PROFDATA" ];
+then
+    LLVM_PROFDATA=llvm-profdata
+fi
+
+SCRIPT_DIR=$(dirname "$(realpath "$0")")
+TESTFILES_DIR=$SCRIPT_DIR/../safec_testfiles
+
+WORK_DIR=$(mktemp -d)
+trap "rm -rf $WORK_DIR" EXIT
+
+export LLVM_PROFILE_FILE=$WORK_DIR/safec-%p.profraw
+
+for i in $TESTFILES_DIR/AST_*.sc;
+do
+    ${SAFEC_PATH} -f $i -o $WORK_DIR -n --generate > /dev/null || exit 1
+done
+
+# corpus shapes stressing different passes: deep scopes with many
+# defers, wide switches and long initializer lists
+CORPUS_SHAPES=(
+    "-n 50"
+    "-n 20 -d 8 -k 4"
+    "-n 20 -s 64"
+    "-n 20 -l 512"
+)
+
+for shape_idx in ${!CORPUS_SHAPES[@]};
+do
+    corpus=$WORK_DIR/corpus_$shape_idx.sc
+    ${SAFEC_CORPUSGEN_PATH} ${CORPUS_SHAPES[$shape_idx]} -o $corpus || exit 1
+    ${SAFEC_PATH} -f $corpus -o $WORK_DIR -n --generate > /dev/null || exit 1
+done
+
+${LLVM_PROFDATA} merge -output=$OUTPUT_PROFILE $WORK_DIR/*.profraw || exit 1
+
+echo "PGO profile written to $OUTPUT_PROFILE"
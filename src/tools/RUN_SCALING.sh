@@ -0,0 +1,59 @@
+#!/bin/bash
+
+# Transpiles synthetic corpora of growing size and prints the time spent
+# in each phase (us) and the peak memory (kB) as CSV, one row per size.
+#
+# usage: RUN_SCALING.sh [functions count...]     (default: 10 25 50 100)
+#
+# SAFEC_PATH            - transpiler binary
+# SAFEC_CORPUSGEN_PATH  - corpus generator binary
+# CORPUS_ARGS           - extra generator parameters, e.g. "-d 6 -k 3"
+
+if [ -z "$SAFEC_PATH" ];
+then
+    SAFEC_PATH=../../build/bin/SafeCTranspiler
+fi
+
+if [ -z "$SAFEC_CORPUSGEN_PATH" ];
+then
+    SAFEC_CORPUSGEN_PATH=../../build/bin/SafeCCorpusGen
+fi
+
+SIZES=("$@")
+if [ ${#SIZES[@]} -eq 0 ];
+then
+    SIZES=(10 25 50 100)
+fi
+
+WORK_DIR=$(mktemp -d)
+trap "rm -rf $WORK_DIR" EXIT
+
+header_printed=0
+
+for functions in ${SIZES[@]};
+do
+    corpus=$WORK_DIR/corpus_$functions.sc
+
+    ${SAFEC_CORPUSGEN_PATH} -n $functions $CORPUS_ARGS -o $corpus || exit 1
+
+    lines=$(wc -l < $corpus)
+    bytes=$(wc -c < $corpus)
+
+    ${SAFEC_PATH} -f $corpus -o $WORK_DIR -n -t --generate > $WORK_DIR/log.txt
+    if [ $? -ne 0 ];
+    then
+        echo "transpiler failed for $functions functions" >&2
+        exit 1
+    fi
+
+    # timings are printed as "<tab><phase> <value>" lines
+    timings=$(grep -P "^\t" $WORK_DIR/log.txt | tr -d '\r')
+
+    if [ $header_printed -eq 0 ];
+    then
+        echo "functions,lines,bytes,$(echo "$timings" | awk '{ print $1 }' | paste -sd ',')"
+        header_printed=1
+    fi
+
+    echo "$functions,$lines,$bytes,$(echo "$timings" | awk '{ print $2 }' | paste -sd ',')"
+done
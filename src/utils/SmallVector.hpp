@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace safec
+{
+
+namespace utils
+{
+
+// Vector keeping up to N elements inline, moves them to the heap only
+// when it grows above N. Iterators are plain pointers and are invalidated
+// by any modification, like the std::vector ones on reallocation.
+template <typename T, size_t N>
+class SmallVector
+{
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SmallVector()
+        : mData{getInlineData()}
+        , mSize{0}
+        , mCapacity{N}
+    {
+    }
+
+    SmallVector(const SmallVector &other)
+        : SmallVector{}
+    {
+        reserve(other.mSize);
+        std::uninitialized_copy(other.begin(), other.end(), mData);
+        mSize = other.mSize;
+    }
+
+    SmallVector(SmallVector &&other) noexcept
+        : SmallVector{}
+    {
+        takeFrom(std::move(other));
+    }
+
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+        {
+            clear();
+            reserve(other.mSize);
+            std::uninitialized_copy(other.begin(), other.end(), mData);
+            mSize = other.mSize;
+        }
+
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            clear();
+            releaseHeapData();
+            takeFrom(std::move(other));
+        }
+
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        releaseHeapData();
+    }
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+    bool empty() const
+    {
+        return (mSize == 0);
+    }
+
+    size_t capacity() const
+    {
+        return mCapacity;
+    }
+
+    // true while the elements are stored inline
+    bool isInline() const
+    {
+        return (mData == getInlineData());
+    }
+
+    T *data()
+    {
+        return mData;
+    }
+
+    const T *data() const
+    {
+        return mData;
+    }
+
+    iterator begin()
+    {
+        return mData;
+    }
+
+    iterator end()
+    {
+        return mData + mSize;
+    }
+
+    const_iterator begin() const
+    {
+        return mData;
+    }
+
+    const_iterator end() const
+    {
+        return mData + mSize;
+    }
+
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator{end()};
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator{begin()};
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator{end()};
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator{begin()};
+    }
+
+    T &operator[](const size_t index)
+    {
+        assert(index < mSize);
+        return mData[index];
+    }
+
+    const T &operator[](const size_t index) const
+    {
+        assert(index < mSize);
+        return mData[index];
+    }
+
+    T &front()
+    {
+        assert(mSize > 0);
+        return mData[0];
+    }
+
+    const T &front() const
+    {
+        assert(mSize > 0);
+        return mData[0];
+    }
+
+    T &back()
+    {
+        assert(mSize > 0);
+        return mData[mSize - 1];
+    }
+
+    const T &back() const
+    {
+        assert(mSize > 0);
+        return mData[mSize - 1];
+    }
+
+    void push_back(const T &value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... TArgs>
+    T &emplace_back(TArgs &&...args)
+    {
+        if (mSize == mCapacity)
+        {
+            // the argument may live in this vector, construct it first
+            T value(std::forward<TArgs>(args)...);
+            grow(mSize + 1);
+            new (mData + mSize) T(std::move(value));
+        }
+        else
+        {
+            new (mData + mSize) T(std::forward<TArgs>(args)...);
+        }
+
+        mSize++;
+        return back();
+    }
+
+    iterator insert(const_iterator pos, T value)
+    {
+        const size_t index = static_cast<size_t>(pos - begin());
+        assert(index <= mSize);
+
+        push_back(std::move(value));
+        std::rotate(begin() + index, end() - 1, end());
+
+        return begin() + index;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        const size_t index = static_cast<size_t>(pos - begin());
+        assert(index < mSize);
+
+        std::move(begin() + index + 1, end(), begin() + index);
+        pop_back();
+
+        return begin() + index;
+    }
+
+    void pop_back()
+    {
+        assert(mSize > 0);
+
+        mSize--;
+        mData[mSize].~T();
+    }
+
+    void clear()
+    {
+        std::destroy(begin(), end());
+        mSize = 0;
+    }
+
+    void reserve(const size_t capacity)
+    {
+        if (capacity > mCapacity)
+        {
+            grow(capacity);
+        }
+    }
+
+private:
+    // N == 0 is allowed, the storage is just never used
+    alignas(T) unsigned char mInlineStorage[sizeof(T) * (N > 0 ? N : 1)];
+
+    T *mData;
+    uint32_t mSize;
+    uint32_t mCapacity;
+
+    T *getInlineData()
+    {
+        return reinterpret_cast<T *>(mInlineStorage);
+    }
+
+    const T *getInlineData() const
+    {
+        return reinterpret_cast<const T *>(mInlineStorage);
+    }
+
+    void grow(const size_t minCapacity)
+    {
+        const size_t newCapacity = std::max<size_t>(minCapacity, mCapacity * 2U);
+        T *newData = static_cast<T *>(::operator new(newCapacity * sizeof(T)));
+
+        std::uninitialized_move(begin(), end(), newData);
+        std::destroy(begin(), end());
+        releaseHeapData();
+
+        mData = newData;
+        mCapacity = static_cast<uint32_t>(newCapacity);
+    }
+
+    void releaseHeapData()
+    {
+        if (isInline() == false)
+        {
+            ::operator delete(mData);
+            mData = getInlineData();
+            mCapacity = N;
+        }
+    }
+
+    // expects this vector to be empty and inline
+    void takeFrom(SmallVector &&other)
+    {
+        if (other.isInline())
+        {
+            std::uninitialized_move(other.begin(), other.end(), mData);
+            mSize = other.mSize;
+            other.clear();
+        }
+        else
+        {
+            mData = other.mData;
+            mSize = other.mSize;
+            mCapacity = other.mCapacity;
+
+            other.mData = other.getInlineData();
+            other.mSize = 0;
+            other.mCapacity = N;
+        }
+    }
+};
+
+} // namespace utils
+
+} // namespace safec
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace safec
+{
+
+namespace utils
+{
+
+// Wall time spent in the transpiler phases, gathered only when enabled
+// (--timings). Phases are kept in the order they were first entered.
+class Timings
+{
+public:
+    using Duration = std::chrono::microseconds;
+    using Phase = std::pair<std::string, Duration>;
+
+    static Timings &getInstance()
+    {
+        static Timings timings;
+        return timings;
+    }
+
+    void setEnabled(const bool enabled)
+    {
+        mEnabled = enabled;
+    }
+
+    bool getEnabled() const
+    {
+        return mEnabled;
+    }
+
+    void add(const std::string &phase, const Duration duration)
+    {
+        for (auto &it : mPhases)
+        {
+            if (it.first == phase)
+            {
+                it.second += duration;
+                return;
+            }
+        }
+
+        mPhases.emplace_back(phase, duration);
+    }
+
+    const std::vector<Phase> &getPhases() const
+    {
+        return mPhases;
+    }
+
+    void clear()
+    {
+        mPhases.clear();
+    }
+
+private:
+    Timings()
+        : mEnabled{false}
+        , mPhases{}
+    {
+    }
+
+    bool mEnabled;
+    std::vector<Phase> mPhases;
+};
+
+// Measures the enclosing scope as a single phase.
+class ScopedTiming
+{
+public:
+    ScopedTiming(const char *phase)
+        : mPhase{phase}
+        , mStart{std::chrono::steady_clock::now()}
+    {
+    }
+
+    ~ScopedTiming()
+    {
+        auto &timings = Timings::getInstance();
+        if (timings.getEnabled())
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - mStart;
+            timings.add(mPhase, std::chrono::duration_cast<Timings::Duration>(elapsed));
+        }
+    }
+
+    ScopedTiming(const ScopedTiming &) = delete;
+    ScopedTiming &operator=(const ScopedTiming &) = delete;
+
+private:
+    const char *mPhase;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+} // namespace utils
+
+} // namespace safec
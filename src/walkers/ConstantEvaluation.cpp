@@ -0,0 +1,510 @@
+#include "ConstantEvaluation.hpp"
+
+#include "SourceText.hpp"
+#include "config/Config.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <string_view>
+
+namespace safec
+{
+
+namespace constants
+{
+
+namespace
+{
+
+// int and unsigned int of the target
+struct IntRange
+{
+    int64_t mBits;
+    int64_t mMin;
+    int64_t mMax;
+    int64_t mUnsignedMax;
+};
+
+IntRange getIntRange()
+{
+    const int64_t bits = Config::getInstance().getIntWidth();
+    const int64_t max = (int64_t{1} << (bits - 1)) - 1;
+    return IntRange{bits, -max - 1, max, (int64_t{1} << bits) - 1};
+}
+
+// the unsigned arithmetic wraps around
+Value makeUnsigned(const int64_t value)
+{
+    const auto unsignedMax = static_cast<uint64_t>(getIntRange().mUnsignedMax);
+    return Value{static_cast<int64_t>(static_cast<uint64_t>(value) & unsignedMax), true};
+}
+
+std::optional<Value> makeSigned(const int64_t value, std::string &error)
+{
+    const auto range = getIntRange();
+    if ((value < range.mMin) || (value > range.mMax))
+    {
+        error = "signed overflow";
+        return std::nullopt;
+    }
+
+    return Value{value, false};
+}
+
+Value makeBool(const bool value)
+{
+    return Value{value ? 1 : 0, false};
+}
+
+// the usual arithmetic conversions, both unsigned if one of them is
+void convert(Value &lhs, Value &rhs)
+{
+    if (lhs.mIsUnsigned || rhs.mIsUnsigned)
+    {
+        lhs = makeUnsigned(lhs.mValue);
+        rhs = makeUnsigned(rhs.mValue);
+    }
+}
+
+std::optional<Value> evaluateUnary(const std::string &op, const Value &value, std::string &error)
+{
+    if (op == "+")
+    {
+        return value;
+    }
+
+    if (op == "-")
+    {
+        return value.mIsUnsigned ? makeUnsigned(-value.mValue) : makeSigned(-value.mValue, error);
+    }
+
+    if (op == "~")
+    {
+        return value.mIsUnsigned ? makeUnsigned(~value.mValue) : Value{~value.mValue, false};
+    }
+
+    if (op == "!")
+    {
+        return makeBool(value.mValue == 0);
+    }
+
+    return std::nullopt;
+}
+
+// the type of a shift is the type of its left operand, no conversions
+std::optional<Value> evaluateShift(const std::string &op, const Value &lhs, const Value &rhs, std::string &error)
+{
+    if ((rhs.mValue < 0) || (rhs.mValue >= getIntRange().mBits))
+    {
+        error = "shift count out of range";
+        return std::nullopt;
+    }
+
+    if (lhs.mIsUnsigned)
+    {
+        return (op == "<<") ? makeUnsigned(lhs.mValue << rhs.mValue) : Value{lhs.mValue >> rhs.mValue, true};
+    }
+
+    if (lhs.mValue < 0)
+    {
+        error = "shift of a negative value";
+        return std::nullopt;
+    }
+
+    return (op == "<<") ? makeSigned(lhs.mValue << rhs.mValue, error) : Value{lhs.mValue >> rhs.mValue, false};
+}
+
+std::optional<Value> evaluateBinary(const std::string &op, Value lhs, Value rhs, std::string &error)
+{
+    if ((op == "<<") || (op == ">>"))
+    {
+        return evaluateShift(op, lhs, rhs, error);
+    }
+
+    if (op == "&&")
+    {
+        return makeBool((lhs.mValue != 0) && (rhs.mValue != 0));
+    }
+
+    if (op == "||")
+    {
+        return makeBool((lhs.mValue != 0) || (rhs.mValue != 0));
+    }
+
+    convert(lhs, rhs);
+
+    const int64_t a = lhs.mValue;
+    const int64_t b = rhs.mValue;
+    const bool isUnsigned = lhs.mIsUnsigned;
+
+    const auto make = [&](const int64_t value) -> std::optional<Value> {
+        return isUnsigned ? makeUnsigned(value) : makeSigned(value, error);
+    };
+
+    if ((op == "/") || (op == "%"))
+    {
+        if (b == 0)
+        {
+            error = "division by zero";
+            return std::nullopt;
+        }
+
+        // C89 - the rounding of a negative quotient is implementation-defined
+        if ((isUnsigned == false) && ((a < 0) || (b < 0)))
+        {
+            error = "division of a negative value";
+            return std::nullopt;
+        }
+
+        return make((op == "/") ? (a / b) : (a % b));
+    }
+
+    if (op == "*")
+    {
+        // the unsigned product can overflow int64_t, wrap it around as uint64_t
+        return isUnsigned ? makeUnsigned(static_cast<int64_t>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b)))
+                          : make(a * b);
+    }
+
+    if ((op == "+") || (op == "-"))
+    {
+        return make((op == "+") ? (a + b) : (a - b));
+    }
+
+    if ((op == "&") || (op == "|") || (op == "^"))
+    {
+        return make((op == "&") ? (a & b) : ((op == "|") ? (a | b) : (a ^ b)));
+    }
+
+    if ((op == "<") || (op == ">") || (op == "<=") || (op == ">="))
+    {
+        return makeBool((op == "<") ? (a < b) : ((op == ">") ? (a > b) : ((op == "<=") ? (a <= b) : (a >= b))));
+    }
+
+    if ((op == "==") || (op == "!="))
+    {
+        return makeBool((op == "==") == (a == b));
+    }
+
+    return std::nullopt;
+}
+
+std::string toHex(int64_t value)
+{
+    static constexpr char kDigits[] = "0123456789ABCDEF";
+
+    std::string digits;
+    do
+    {
+        digits.insert(digits.begin(), kDigits[value & 0xF]);
+        value >>= 4;
+    } while (value != 0);
+
+    return "0x" + digits;
+}
+
+std::string_view skipSpaces(std::string_view text)
+{
+    while ((text.empty() == false) && ((text.front() == ' ') || (text.front() == '\t')))
+    {
+        text.remove_prefix(1);
+    }
+
+    return text;
+}
+
+// "64", "(64U)" - the body of a macro without the comments
+std::optional<Value> parseMacroBody(std::string_view body)
+{
+    body = body.substr(0, std::min(body.find("//"), body.find("/*")));
+    body = source::trim(body);
+
+    while ((body.size() > 1) && (body.front() == '(') && (body.back() == ')'))
+    {
+        body = source::trim(body.substr(1, body.size() - 2));
+    }
+
+    std::string error;
+    return parseConstant(std::string{body}, error);
+}
+
+} // namespace
+
+std::optional<Value> evaluate(const SemNode &node, std::string &error, const Symbols *symbols)
+{
+    switch (node.getType())
+    {
+        case SemNode::Type::Constant:
+            return parseConstant(static_cast<const SemNodeConstant &>(node).getName(), error);
+
+        case SemNode::Type::Identifier:
+        {
+            // an identifier with children is a call or an array access
+            if ((symbols == nullptr) || (node.getAttachedNodes().empty() == false))
+            {
+                return std::nullopt;
+            }
+
+            const auto symbol = symbols->find(static_cast<const SemNodeIdentifier &>(node).getName());
+            return (symbol != symbols->end()) ? std::optional<Value>{symbol->second} : std::nullopt;
+        }
+
+        case SemNode::Type::UnaryOp:
+        {
+            const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(node);
+            if (unaryOp.getRhs() == nullptr)
+            {
+                return std::nullopt;
+            }
+
+            const std::string op = unaryOp.getOp();
+            if ((op != "+") && (op != "-") && (op != "~") && (op != "!"))
+            {
+                return std::nullopt;
+            }
+
+            const auto value = evaluate(*unaryOp.getRhs(), error, symbols);
+            return value.has_value() ? evaluateUnary(op, *value, error) : std::nullopt;
+        }
+
+        case SemNode::Type::BinaryOp:
+        {
+            const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(node);
+            if ((binaryOp.getLhs() == nullptr) || (binaryOp.getRhs() == nullptr))
+            {
+                return std::nullopt;
+            }
+
+            const std::string op = binaryOp.getOp();
+            if (op == "?")
+            {
+                // the branches are the operands of the ":"
+                const auto &branches = *binaryOp.getRhs();
+                if ((branches.getType() != SemNode::Type::BinaryOp) ||
+                    (static_cast<const SemNodeBinaryOp &>(branches).getOp() != ":"))
+                {
+                    return std::nullopt;
+                }
+
+                const auto condition = evaluate(*binaryOp.getLhs(), error, symbols);
+                if (condition.has_value() == false)
+                {
+                    return std::nullopt;
+                }
+
+                auto thenValue = evaluate(*static_cast<const SemNodeBinaryOp &>(branches).getLhs(), error, symbols);
+                if (thenValue.has_value() == false)
+                {
+                    return std::nullopt;
+                }
+
+                auto elseValue = evaluate(*static_cast<const SemNodeBinaryOp &>(branches).getRhs(), error, symbols);
+                if (elseValue.has_value() == false)
+                {
+                    return std::nullopt;
+                }
+
+                convert(*thenValue, *elseValue);
+                return (condition->mValue != 0) ? thenValue : elseValue;
+            }
+
+            // clang-format off
+            static constexpr std::string_view kOperators[] = {
+                "+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^",
+                "<", ">", "<=", ">=", "==", "!=", "&&", "||"};
+            // clang-format on
+
+            if (std::find(std::begin(kOperators), std::end(kOperators), op) == std::end(kOperators))
+            {
+                return std::nullopt;
+            }
+
+            const auto lhs = evaluate(*binaryOp.getLhs(), error, symbols);
+            if (lhs.has_value() == false)
+            {
+                return std::nullopt;
+            }
+
+            const auto rhs = evaluate(*binaryOp.getRhs(), error, symbols);
+            if (rhs.has_value() == false)
+            {
+                return std::nullopt;
+            }
+
+            return evaluateBinary(op, *lhs, *rhs, error);
+        }
+
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<Value> parseConstant(const std::string &text, std::string &error)
+{
+    if (text.empty())
+    {
+        return std::nullopt;
+    }
+
+    if (text.front() == '\'')
+    {
+        error = "character constant, its value depends on the character set";
+        return std::nullopt;
+    }
+
+    // strings and floating constants starting with a dot
+    if (std::isdigit(static_cast<unsigned char>(text.front())) == 0)
+    {
+        return std::nullopt;
+    }
+
+    size_t suffixStart = text.size();
+    while ((suffixStart > 0) && (std::string_view{"uUlL"}.find(text[suffixStart - 1]) != std::string_view::npos))
+    {
+        suffixStart--;
+    }
+
+    const std::string digits = text.substr(0, suffixStart);
+    const std::string suffix = text.substr(suffixStart);
+    const bool hasUnsignedSuffix = (suffix.find_first_of("uU") != std::string::npos);
+    const bool hasLongSuffix = (suffix.find_first_of("lL") != std::string::npos);
+
+    errno = 0;
+    char *end = nullptr;
+    const unsigned long long value = std::strtoull(digits.c_str(), &end, 0);
+    if (*end != '\0')
+    {
+        // floating constant
+        return std::nullopt;
+    }
+
+    // C89 - the first type the value fits in, a decimal constant
+    // without a suffix is never unsigned int
+    const bool isDecimal = (digits.front() != '0');
+    const auto range = getIntRange();
+    if ((errno == 0) && (hasLongSuffix == false))
+    {
+        if ((value <= static_cast<unsigned long long>(range.mMax)) && (hasUnsignedSuffix == false))
+        {
+            return Value{static_cast<int64_t>(value), false};
+        }
+
+        const bool canBeUnsigned = (hasUnsignedSuffix || (isDecimal == false));
+        if ((value <= static_cast<unsigned long long>(range.mUnsignedMax)) && canBeUnsigned)
+        {
+            return Value{static_cast<int64_t>(value), true};
+        }
+    }
+
+    error = "long constant";
+    return std::nullopt;
+}
+
+std::string toSource(const Value &value, const bool hex)
+{
+    if ((value.mIsUnsigned == false) && (value.mValue < 0))
+    {
+        // -2147483648 would be the negated long 2147483648
+        const auto range = getIntRange();
+        return (value.mValue == range.mMin) ? ("(-" + std::to_string(range.mMax) + " - 1)")
+                                            : ("(-" + std::to_string(-value.mValue) + ")");
+    }
+
+    const std::string digits = hex ? toHex(value.mValue) : std::to_string(value.mValue);
+    return value.mIsUnsigned ? (digits + "U") : digits;
+}
+
+MacroConstants::MacroConstants(const std::string &text)
+{
+    // the macros in a conditional block, defined again or undefined can
+    // have other values when the file is compiled, their value is not known
+    uint32_t conditionalDepth = 0;
+    for (size_t lineStart = 0; lineStart < text.size();)
+    {
+        const size_t lineEnd = std::min(text.find('\n', lineStart), text.size());
+        std::string_view line = skipSpaces(std::string_view{text}.substr(lineStart, lineEnd - lineStart));
+        const size_t pos = lineStart;
+        lineStart = lineEnd + 1;
+
+        if (line.empty() || (line.front() != '#'))
+        {
+            continue;
+        }
+
+        line = skipSpaces(line.substr(1));
+        const size_t directiveEnd = std::min(line.find_first_of(" \t"), line.size());
+        const std::string_view directive = line.substr(0, directiveEnd);
+        line = skipSpaces(line.substr(directiveEnd));
+
+        if ((directive == "if") || (directive == "ifdef") || (directive == "ifndef"))
+        {
+            conditionalDepth++;
+            mConditionalDepths[pos] = conditionalDepth;
+            continue;
+        }
+
+        if (directive == "endif")
+        {
+            conditionalDepth -= (conditionalDepth > 0) ? 1U : 0U;
+            mConditionalDepths[pos] = conditionalDepth;
+            continue;
+        }
+
+        if ((directive != "define") && (directive != "undef"))
+        {
+            continue;
+        }
+
+        size_t nameEnd = 0;
+        while ((nameEnd < line.size()) && source::isIdentifierChar(line[nameEnd]))
+        {
+            nameEnd++;
+        }
+
+        const std::string name{line.substr(0, nameEnd)};
+        if (name.empty())
+        {
+            continue;
+        }
+
+        // a function-like macro or a body on the next lines is not parsed
+        const std::string_view body = line.substr(nameEnd);
+        const bool isKnown = (directive == "define") && (conditionalDepth == 0) && (mMacros.count(name) == 0) &&
+                             ((body.empty() == false) && (body.front() != '(')) && (body.back() != '\\');
+
+        mMacros[name] = Macro{pos, isKnown ? parseMacroBody(body) : std::nullopt};
+    }
+}
+
+Symbols MacroConstants::getSymbols(const size_t pos) const
+{
+    Symbols symbols;
+    for (const auto &it : mMacros)
+    {
+        if ((it.second.mPos < pos) && it.second.mValue.has_value())
+        {
+            symbols.emplace(it.first, *it.second.mValue);
+        }
+    }
+
+    return symbols;
+}
+
+bool MacroConstants::isConditional(const size_t pos) const
+{
+    // the last directive before pos
+    auto it = mConditionalDepths.lower_bound(pos);
+    if (it == mConditionalDepths.begin())
+    {
+        return false;
+    }
+
+    it--;
+    return (it->second > 0);
+}
+
+} // namespace constants
+
+} // namespace safec
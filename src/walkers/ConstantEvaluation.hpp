@@ -0,0 +1,68 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace safec
+{
+
+// C89 integer constant expressions, evaluated the way the target would.
+// The target has a two's complement int of Config::getIntWidth() bits,
+// only the int and unsigned int types are handled - the width of long
+// differs between the targets, the long operands are left to the compiler.
+namespace constants
+{
+
+struct Value
+{
+    int64_t mValue = 0;
+    bool mIsUnsigned = false;
+};
+
+// values of the identifiers known to be constants, e.g. the macros
+using Symbols = std::map<std::string, Value>;
+
+// The value of an integer constant or a constant expression made of the
+// unary, binary and "?:" operators. Nullopt if the node is not one, the
+// error is set if it is but its value is not known here (long operands,
+// overflow, division by zero, implementation-defined results). The
+// identifiers are looked up in the symbols, if there are any.
+std::optional<Value> evaluate(const SemNode &node, std::string &error, const Symbols *symbols = nullptr);
+
+std::optional<Value> parseConstant(const std::string &text, std::string &error);
+
+// literal of the same type and value, parenthesized if negative
+std::string toSource(const Value &value, const bool hex);
+
+// The macros defined once in the source as an integer constant ("#define
+// SIZE 64U"). The source is not preprocessed, the macros in a conditional
+// block, defined again or undefined have no value here.
+class MacroConstants
+{
+public:
+    MacroConstants(const std::string &text);
+
+    // the macros defined before pos
+    Symbols getSymbols(const size_t pos) const;
+
+    // pos is in an #if, #ifdef or #ifndef block, it may not be compiled
+    bool isConditional(const size_t pos) const;
+
+private:
+    struct Macro
+    {
+        size_t mPos = 0;             // of the definition
+        std::optional<Value> mValue; // none if not known here
+    };
+
+    std::map<std::string, Macro> mMacros;
+    std::map<size_t, uint32_t> mConditionalDepths; // after the directive at the pos
+};
+
+} // namespace constants
+
+} // namespace safec
@@ -0,0 +1,350 @@
+#include "DeferAnalysis.hpp"
+
+#include "SourceText.hpp"
+#include "logger/Logger.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace safec;
+
+namespace
+{
+
+// nodes the defers are armed in, or an exit can jump out of
+bool isScope(const SemNode &node)
+{
+    switch (node.getType())
+    {
+        case SemNode::Type::Scope:
+        case SemNode::Type::Function:
+        case SemNode::Type::Loop:
+        case SemNode::Type::If:
+        case SemNode::Type::SwitchCase:
+        case SemNode::Type::SwitchCaseLabel:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+DeferAnalysis::DeferAnalysis()
+    : mCurrentState{kNoState}
+    , mErrors{0}
+{
+}
+
+bool DeferAnalysis::analyze(const SemNodeTranslationUnit &translationUnit)
+{
+    mFunctions.clear();
+    mDeferStates.clear();
+    mStateNodes.clear();
+    mScopes.clear();
+    mCurrentState = kNoState;
+    mErrors = 0;
+
+    mSourcePath = translationUnit.getSourcePath().string();
+    mSource.clear();
+    mGotos.clear();
+
+    analyzeNode(translationUnit);
+
+    return (mErrors == 0);
+}
+
+const std::vector<DeferAnalysis::FunctionDefers> &DeferAnalysis::getFunctions() const
+{
+    return mFunctions;
+}
+
+const std::vector<DeferAnalysis::DeferState> &DeferAnalysis::getDeferStates() const
+{
+    return mDeferStates;
+}
+
+std::vector<uint32_t> DeferAnalysis::getExitDefers(const Exit &exit) const
+{
+    std::vector<uint32_t> deferNodeIds;
+    for (uint32_t state = exit.mState; state != exit.mTargetState; state = mDeferStates[state].mParent)
+    {
+        assert(state != kNoState);
+        deferNodeIds.push_back(mDeferStates[state].mDeferNodeId);
+    }
+
+    return deferNodeIds;
+}
+
+std::string_view DeferAnalysis::getExitKeyword(const ExitKind kind)
+{
+    switch (kind)
+    {
+        case ExitKind::Return:
+            return "return";
+
+        case ExitKind::Break:
+            return "break";
+
+        case ExitKind::Continue:
+            return "continue";
+
+        case ExitKind::Goto:
+            return "goto";
+    }
+
+    return "";
+}
+
+void DeferAnalysis::analyzeNode(const SemNode &node)
+{
+    // the unreachable code is not emitted (see WalkerDeadCode)
+    if (node.getDirty() == SemNode::DirtyType::Removed)
+    {
+        return;
+    }
+
+    const uint32_t firstState = static_cast<uint32_t>(mDeferStates.size());
+
+    switch (node.getType())
+    {
+        case SemNode::Type::Function:
+            mFunctions.push_back(FunctionDefers{node.getId(), {}, {}});
+            mGotos.clear();
+            break;
+
+        case SemNode::Type::Defer:
+            deferAdd(node);
+            break;
+
+        case SemNode::Type::Return:
+            exitAdd(node, ExitKind::Return);
+            break;
+
+        case SemNode::Type::JumpStatement:
+        {
+            const auto &jumpStatement = static_cast<const SemNodeJumpStatement &>(node);
+            if (jumpStatement.getName() == "break")
+            {
+                exitAdd(node, ExitKind::Break);
+            }
+            else if (jumpStatement.getName() == "continue")
+            {
+                exitAdd(node, ExitKind::Continue);
+            }
+            else if (jumpStatement.getName() == "goto")
+            {
+                gotoAdd(node);
+            }
+        }
+        break;
+
+        default:
+            break;
+    }
+
+    // the defers armed in a scope are dropped when it is left
+    const bool scope = isScope(node);
+    if (scope)
+    {
+        mScopes.push_back(ScopeFrame{&node, mCurrentState});
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        analyzeNode(*it);
+    }
+
+    if (scope)
+    {
+        mCurrentState = mScopes.back().mEntryState;
+        mScopes.pop_back();
+    }
+
+    if (node.getType() == SemNode::Type::Function)
+    {
+        gotosCheck(node, firstState);
+    }
+}
+
+void DeferAnalysis::deferAdd(const SemNode &deferNode)
+{
+    if (mScopes.empty() || mFunctions.empty())
+    {
+        log("ERROR: defer at % is not in a function", Color::Red, deferNode.getSemStart());
+        mErrors++;
+        return;
+    }
+
+    const SemNode &currentScope = *mScopes.back().mScope;
+
+    Defer defer;
+    defer.mDeferNodeId = deferNode.getId();
+    defer.mOwnerScopeId = currentScope.getId();
+    defer.mHasState = (currentScope.getType() == SemNode::Type::Scope);
+    mFunctions.back().mDefers.push_back(defer);
+
+    if (defer.mHasState)
+    {
+        DeferState state;
+        state.mDeferNodeId = defer.mDeferNodeId;
+        state.mOwnerScopeId = defer.mOwnerScopeId;
+        state.mParent = mCurrentState;
+
+        mCurrentState = static_cast<uint32_t>(mDeferStates.size());
+        mDeferStates.push_back(state);
+        mStateNodes.push_back(StateNodes{&deferNode, static_cast<const SemNodeScope *>(&currentScope)});
+    }
+}
+
+void DeferAnalysis::exitAdd(const SemNode &exitNode, const ExitKind kind)
+{
+    // the innermost scope the exit jumps out of
+    const ScopeFrame *target = nullptr;
+    for (auto it = mScopes.rbegin(); it != mScopes.rend(); it++)
+    {
+        const auto type = it->mScope->getType();
+
+        const bool isTarget =                                                                    //
+            ((kind == ExitKind::Return) && (type == SemNode::Type::Function)) ||                 //
+            ((kind == ExitKind::Break) && ((type == SemNode::Type::Loop) ||                      //
+                                           (type == SemNode::Type::SwitchCase))) ||              //
+            ((kind == ExitKind::Continue) && (type == SemNode::Type::Loop));
+
+        if (isTarget)
+        {
+            target = &(*it);
+            break;
+        }
+    }
+
+    // nothing to run on the way out
+    if ((target == nullptr) || (target->mEntryState == mCurrentState))
+    {
+        return;
+    }
+
+    assert(mFunctions.empty() == false);
+
+    Exit exit;
+    exit.mExitNodeId = exitNode.getId();
+    exit.mKind = kind;
+    exit.mState = mCurrentState;
+    exit.mTargetState = target->mEntryState;
+
+    mFunctions.back().mExits.push_back(exit);
+}
+
+void DeferAnalysis::gotoAdd(const SemNode &gotoNode)
+{
+    if (mFunctions.empty())
+    {
+        return;
+    }
+
+    // the target is known when the label is found, the exit is added
+    // here to keep the source order and dropped if nothing is run
+    uint32_t exitIndex = kNoExit;
+    if (mCurrentState != kNoState)
+    {
+        Exit exit;
+        exit.mExitNodeId = gotoNode.getId();
+        exit.mKind = ExitKind::Goto;
+        exit.mState = mCurrentState;
+        exit.mTargetState = mCurrentState;
+        exit.mLabel = static_cast<const SemNodeJumpStatement &>(gotoNode).getLabel();
+
+        exitIndex = static_cast<uint32_t>(mFunctions.back().mExits.size());
+        mFunctions.back().mExits.push_back(exit);
+    }
+
+    mGotos.push_back(Goto{&gotoNode, mCurrentState, exitIndex});
+}
+
+void DeferAnalysis::gotosCheck(const SemNode &function, const uint32_t firstState)
+{
+    // no defer in the function, a goto can not skip or leave one
+    if (mGotos.empty() || (firstState == mDeferStates.size()))
+    {
+        return;
+    }
+
+    if (mSource.empty())
+    {
+        mSource = source::readSourceFile(mSourcePath);
+    }
+
+    const auto functionSource = source::getNodeSource(mSource, function);
+
+    for (const auto &it : mGotos)
+    {
+        const auto &gotoNode = static_cast<const SemNodeJumpStatement &>(*it.mNode);
+
+        const size_t labelOffset = source::findLabel(functionSource, gotoNode.getLabel());
+        if (labelOffset == std::string_view::npos)
+        {
+            log("ERROR: line %: no label '%' for the goto leaving the defers",
+                Color::Red,
+                getLine(gotoNode.getPos()),
+                gotoNode.getLabel());
+            mErrors++;
+            continue;
+        }
+
+        const size_t labelPos = function.getSemStart() + labelOffset;
+
+        // the defers armed at the label that were not armed at the goto,
+        // their cleanup would run without the defer
+        for (uint32_t state = firstState; state < mDeferStates.size(); state++)
+        {
+            bool armedAtGoto = false;
+            for (uint32_t gotoState = it.mState; gotoState != kNoState; gotoState = mDeferStates[gotoState].mParent)
+            {
+                armedAtGoto = armedAtGoto || (gotoState == state);
+            }
+
+            if (isArmedAt(state, labelPos) && (armedAtGoto == false))
+            {
+                log("ERROR: line %: goto % jumps over the defer at line %",
+                    Color::Red,
+                    getLine(gotoNode.getPos()),
+                    gotoNode.getLabel(),
+                    getLine(mStateNodes[state].mDefer->getSemEnd()));
+                mErrors++;
+            }
+        }
+
+        if (it.mExitIndex == kNoExit)
+        {
+            continue;
+        }
+
+        // the defers armed at the goto and not at the label are run
+        uint32_t targetState = it.mState;
+        while ((targetState != kNoState) && (isArmedAt(targetState, labelPos) == false))
+        {
+            targetState = mDeferStates[targetState].mParent;
+        }
+
+        mFunctions.back().mExits[it.mExitIndex].mTargetState = targetState;
+    }
+
+    auto &exits = mFunctions.back().mExits;
+    exits.erase(std::remove_if(exits.begin(),
+                               exits.end(),
+                               [](const Exit &exit) { return (exit.mState == exit.mTargetState); }),
+                exits.end());
+}
+
+bool DeferAnalysis::isArmedAt(const uint32_t state, const size_t pos) const
+{
+    const auto &nodes = mStateNodes[state];
+    return (nodes.mScope->getStart() < pos) && (pos < nodes.mScope->getEnd()) && (nodes.mDefer->getSemEnd() <= pos);
+}
+
+uint32_t DeferAnalysis::getLine(const size_t pos) const
+{
+    const size_t end = std::min(pos, mSource.size());
+    return static_cast<uint32_t>(std::count(mSource.begin(), mSource.begin() + end, '\n')) + 1U;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace safec
+{
+
+// Finds, for each function, the defers armed at every return/break/continue/goto
+// and the defers the exit has to run, in one walk over the AST. The defer
+// lowering (and anything else interested in the defers) reads the result
+// instead of tracking the scopes by itself.
+class DeferAnalysis
+{
+public:
+    static constexpr uint32_t kNoState = UINT32_MAX;
+
+    // the values are also the exit codes in the generated C code
+    enum class ExitKind : uint32_t
+    {
+        Return = 1,
+        Break = 2,
+        Continue = 3,
+        Goto = 4
+    };
+
+    // Defers armed at some point of a function form a tree, each state
+    // is a defer with the link to the defers armed before it. A state
+    // is only made for the defers in a braced scope (a block that can
+    // have a cleanup part).
+    struct DeferState
+    {
+        uint32_t mDeferNodeId;
+        uint32_t mOwnerScopeId;
+        uint32_t mParent;
+    };
+
+    struct Defer
+    {
+        uint32_t mDeferNodeId;
+        uint32_t mOwnerScopeId;
+        bool mHasState;
+    };
+
+    // return/break/continue/goto leaving the scopes with armed defers
+    struct Exit
+    {
+        uint32_t mExitNodeId;
+        ExitKind mKind;
+        uint32_t mState;       // defers armed at the exit
+        uint32_t mTargetState; // defers still armed after the exit
+        std::string mLabel;    // of a goto
+    };
+
+    // defers and exits in the source order
+    struct FunctionDefers
+    {
+        uint32_t mFunctionId;
+        std::vector<Defer> mDefers;
+        std::vector<Exit> mExits;
+    };
+
+    DeferAnalysis();
+
+    // false if a defer can not be lowered (e.g. a goto jumps over it)
+    bool analyze(const SemNodeTranslationUnit &translationUnit);
+
+    const std::vector<FunctionDefers> &getFunctions() const;
+    const std::vector<DeferState> &getDeferStates() const;
+
+    // ids of the defers run by the exit, the last armed first
+    std::vector<uint32_t> getExitDefers(const Exit &exit) const;
+
+    static std::string_view getExitKeyword(const ExitKind kind);
+
+private:
+    struct ScopeFrame
+    {
+        const SemNode *mScope;
+        uint32_t mEntryState; // defers armed when the scope was entered
+    };
+
+    // the nodes of a defer state
+    struct StateNodes
+    {
+        const SemNode *mDefer;
+        const SemNodeScope *mScope;
+    };
+
+    static constexpr uint32_t kNoExit = UINT32_MAX;
+
+    // checked when the function is done, all of its defers are known
+    struct Goto
+    {
+        const SemNode *mNode;
+        uint32_t mState;     // defers armed at the goto
+        uint32_t mExitIndex; // in the exits of the function, if any
+    };
+
+    std::vector<FunctionDefers> mFunctions;
+    std::vector<DeferState> mDeferStates;
+    std::vector<StateNodes> mStateNodes;
+
+    std::vector<ScopeFrame> mScopes;
+    uint32_t mCurrentState;
+    uint32_t mErrors;
+
+    // read for the first goto leaving armed defers, to find the labels
+    std::string mSourcePath;
+    std::string mSource;
+    std::vector<Goto> mGotos;
+
+    void analyzeNode(const SemNode &node);
+
+    void deferAdd(const SemNode &deferNode);
+    void exitAdd(const SemNode &exitNode, const ExitKind kind);
+
+    // the defers run by a goto depend on where its label is
+    void gotoAdd(const SemNode &gotoNode);
+    void gotosCheck(const SemNode &function, const uint32_t firstState);
+
+    // the defer is armed where the label is, if the goto did not skip it
+    bool isArmedAt(const uint32_t state, const size_t pos) const;
+
+    uint32_t getLine(const size_t pos) const;
+};
+
+} // namespace safec
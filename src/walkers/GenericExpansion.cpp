@@ -0,0 +1,601 @@
+#include "GenericExpansion.hpp"
+
+#include "SourceText.hpp"
+#include "logger/Logger.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace safec;
+using namespace safec::source;
+
+namespace
+{
+
+// instances of instances of ..., stops the generics instantiating themselves
+// with ever growing types
+constexpr uint32_t kMaxInstanceDepth = 64;
+
+// source token in [mStart, mEnd), the literals are single tokens
+struct Token
+{
+    size_t mStart;
+    size_t mEnd;
+};
+
+Token nextToken(const std::string_view text, const size_t pos)
+{
+    const size_t start = skipBlank(text, pos);
+    if (start >= text.size())
+    {
+        return {text.size(), text.size()};
+    }
+
+    size_t end = start + 1;
+
+    const char c = text[start];
+    if (isIdentifierChar(c))
+    {
+        while ((end < text.size()) && isIdentifierChar(text[end]))
+        {
+            end++;
+        }
+    }
+    else if ((c == '"') || (c == '\''))
+    {
+        while ((end < text.size()) && (text[end] != c))
+        {
+            end += (text[end] == '\\') ? 2 : 1;
+        }
+
+        end = std::min(end + 1, text.size());
+    }
+
+    return {start, end};
+}
+
+std::string_view getTokenText(const std::string_view text, const Token &token)
+{
+    return text.substr(token.mStart, token.mEnd - token.mStart);
+}
+
+bool isNameStart(const char c)
+{
+    return (std::isalpha(static_cast<unsigned char>(c)) != 0) || (c == '_');
+}
+
+// part of the instance name for a type argument: "char *" is char_ptr,
+// empty for the types that do not fit into a name (e.g. arrays)
+std::string mangle(const std::string_view type)
+{
+    std::string mangled;
+
+    size_t pos = 0;
+    while (true)
+    {
+        const Token token = nextToken(type, pos);
+        if (token.mStart >= type.size())
+        {
+            break;
+        }
+
+        const std::string_view word = getTokenText(type, token);
+        if ((isNameStart(word.front()) == false) && (word != "*"))
+        {
+            return {};
+        }
+
+        mangled += mangled.empty() ? "" : "_";
+        mangled += (word == "*") ? std::string_view{"ptr"} : word;
+
+        pos = token.mEnd;
+    }
+
+    return mangled;
+}
+
+// after the preprocessor lines in front of a top level definition, the
+// includes it needs may be among them
+size_t getInsertPos(const std::string &source, const size_t pos)
+{
+    const size_t first = skipBlank(source, pos);
+
+    size_t insertPos = pos;
+    size_t it = pos;
+    while (it < first)
+    {
+        if ((source[it] == '#') && ((it == 0) || (source[it - 1] == '\n')))
+        {
+            it = std::min(source.find('\n', it), first);
+            insertPos = it;
+        }
+        else if (source.compare(it, 2, "/*") == 0)
+        {
+            it = std::min(source.find("*/", it + 2), first);
+        }
+        else if (source.compare(it, 2, "//") == 0)
+        {
+            it = std::min(source.find('\n', it), first);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    return insertPos;
+}
+
+} // namespace
+
+GenericExpansion::GenericExpansion(const std::filesystem::path &outputFile, Owners &owners)
+    : mOwners{owners}
+    , mOwner{outputFile.filename().string()}
+    , mSource{}
+    , mGenerics{}
+    , mInstances{}
+    , mFailed{false}
+    , mReport{}
+{
+}
+
+bool GenericExpansion::hasGenerics(const SemNode &node)
+{
+    if ((node.getType() == SemNode::Type::Generic) || (node.getType() == SemNode::Type::GenericInstance))
+    {
+        return true;
+    }
+
+    const auto &attached = node.getAttachedNodes();
+    return std::any_of(attached.begin(), attached.end(), [](const auto &it) { return hasGenerics(*it); });
+}
+
+bool GenericExpansion::expand(const SemNodeTranslationUnit &translationUnit, std::string &expanded)
+{
+    mSource = readSourceFile(translationUnit.getSourcePath());
+
+    collectGenerics(translationUnit);
+
+    // the top level definitions end with ';' or with the function body,
+    // the generic definitions are dropped
+    std::set<size_t> functionEnds;
+    std::map<size_t, size_t> genericRanges;
+    for (const auto &it : translationUnit.getAttachedNodes())
+    {
+        if (it->getType() == SemNode::Type::Function)
+        {
+            functionEnds.insert(it->getSemEnd());
+        }
+        else if (it->getType() == SemNode::Type::Generic)
+        {
+            genericRanges[it->getSemStart()] = it->getSemEnd();
+        }
+    }
+
+    expanded.clear();
+
+    size_t definitionStart = 0;
+    const auto addDefinition = [&](const size_t definitionEnd) {
+        const size_t insertPos = getInsertPos(mSource, definitionStart);
+
+        std::vector<std::string> uses;
+        const std::string code = rewrite(insertPos, definitionEnd, {}, uses);
+
+        expanded.append(mSource, definitionStart, insertPos - definitionStart);
+
+        // no empty lines at the start of the file
+        const std::string instances = emitInstances(uses);
+        const size_t instancesStart = expanded.empty() ? instances.find_first_not_of('\n') : 0;
+        expanded.append(instances, std::min(instancesStart, instances.size()));
+
+        expanded.append(code);
+
+        definitionStart = definitionEnd;
+    };
+
+    size_t pos = 0;
+    int32_t depth = 0;
+    while (true)
+    {
+        const Token token = nextToken(mSource, pos);
+        if (token.mStart >= mSource.size())
+        {
+            break;
+        }
+
+        const auto generic = genericRanges.find(token.mStart);
+        if (generic != genericRanges.end())
+        {
+            // the empty lines in front go away with the generic
+            size_t blankStart = token.mStart;
+            while ((blankStart > definitionStart) && isBlank(mSource[blankStart - 1]))
+            {
+                blankStart--;
+            }
+
+            addDefinition(blankStart);
+            definitionStart = generic->second;
+            pos = generic->second;
+            continue;
+        }
+
+        const char c = mSource[token.mStart];
+        if ((c == '{') || (c == '(') || (c == '['))
+        {
+            depth++;
+        }
+        else if ((c == '}') || (c == ')') || (c == ']'))
+        {
+            depth--;
+        }
+
+        pos = token.mEnd;
+
+        const bool isFunctionEnd = (c == '}') && (functionEnds.count(token.mEnd) != 0);
+        if ((depth == 0) && ((c == ';') || isFunctionEnd))
+        {
+            addDefinition(token.mEnd);
+        }
+    }
+
+    addDefinition(mSource.size());
+
+    return (mFailed == false);
+}
+
+const GenericExpansion::Report &GenericExpansion::getReport() const
+{
+    return mReport;
+}
+
+void GenericExpansion::collectGenerics(const SemNodeTranslationUnit &translationUnit)
+{
+    for (const auto &it : translationUnit.getAttachedNodes())
+    {
+        if (it->getType() != SemNode::Type::Generic)
+        {
+            continue;
+        }
+
+        const auto &node = static_cast<const SemNodeGeneric &>(*it);
+
+        Generic generic{&node, {}, false, false, 0, 0, std::string::npos};
+
+        const auto &attached = node.getAttachedNodes();
+        const auto function = std::find_if(attached.begin(), attached.end(), [](const auto &child) {
+            return (child->getType() == SemNode::Type::Function);
+        });
+
+        const bool found = (function != attached.end())
+                               ? findFunctionName(generic, static_cast<const SemNodeFunction &>(**function))
+                               : findStructName(generic);
+        if (found == false)
+        {
+            error(node.getHeaderEnd(), "a generic has to be a function or a struct/union definition");
+            continue;
+        }
+
+        if (mGenerics.emplace(generic.mName, generic).second == false)
+        {
+            error(node.getSemStart(), "generic '" + generic.mName + "' defined twice");
+        }
+    }
+}
+
+bool GenericExpansion::findFunctionName(Generic &generic, const SemNodeFunction &function) const
+{
+    const std::string name = function.getName();
+    const size_t end = generic.mNode->getEnd();
+
+    size_t pos = generic.mNode->getHeaderEnd();
+    while (generic.mNameEnd == 0)
+    {
+        const Token token = nextToken(mSource, pos);
+        if (token.mStart >= end)
+        {
+            return false;
+        }
+
+        const std::string_view word = getTokenText(mSource, token);
+        if (word == "static")
+        {
+            generic.mIsStatic = true;
+        }
+        else if (word == name)
+        {
+            generic.mNameStart = token.mStart;
+            generic.mNameEnd = token.mEnd;
+        }
+
+        pos = token.mEnd;
+    }
+
+    while (generic.mBodyStart == std::string::npos)
+    {
+        const Token token = nextToken(mSource, pos);
+        if (token.mStart >= end)
+        {
+            return false;
+        }
+
+        if (mSource[token.mStart] == '{')
+        {
+            generic.mBodyStart = token.mStart;
+        }
+
+        pos = token.mEnd;
+    }
+
+    generic.mName = name;
+    generic.mIsFunction = true;
+
+    return true;
+}
+
+bool GenericExpansion::findStructName(Generic &generic) const
+{
+    const Token keyword = nextToken(mSource, generic.mNode->getHeaderEnd());
+    const std::string_view keywordText = getTokenText(mSource, keyword);
+    if ((keywordText != "struct") && (keywordText != "union"))
+    {
+        return false;
+    }
+
+    const Token name = nextToken(mSource, keyword.mEnd);
+    if ((name.mStart >= generic.mNode->getEnd()) || (isNameStart(mSource[name.mStart]) == false))
+    {
+        return false;
+    }
+
+    generic.mName = getTokenText(mSource, name);
+    generic.mNameStart = name.mStart;
+    generic.mNameEnd = name.mEnd;
+
+    return true;
+}
+
+std::string GenericExpansion::rewrite( //
+    const size_t begin,
+    const size_t end,
+    const Substitution &substitution,
+    std::vector<std::string> &uses)
+{
+    const std::string_view text = std::string_view{mSource}.substr(0, end);
+
+    std::string result;
+
+    size_t pos = begin;
+    while (true)
+    {
+        const Token token = nextToken(text, pos);
+        result.append(text.substr(pos, token.mStart - pos));
+        if (token.mStart >= text.size())
+        {
+            break;
+        }
+
+        pos = token.mEnd;
+
+        const std::string_view word = getTokenText(text, token);
+        if (isNameStart(word.front()) == false)
+        {
+            result.append(word);
+            continue;
+        }
+
+        // Name::<type, ...>, the lexer takes "Name::" as a single token
+        const Token open = nextToken(text, pos + 2);
+        if ((text.compare(pos, 2, "::") == 0) && (text.compare(open.mStart, 1, "<") == 0))
+        {
+            std::vector<std::string> args;
+
+            size_t argStart = open.mEnd;
+            size_t argsEnd = argStart;
+            int32_t depth = 1;
+            while (depth > 0)
+            {
+                const Token argToken = nextToken(text, argsEnd);
+                if (argToken.mStart >= text.size())
+                {
+                    break;
+                }
+
+                argsEnd = argToken.mEnd;
+
+                const char c = text[argToken.mStart];
+                depth += (c == '<') ? 1 : ((c == '>') ? -1 : 0);
+                if ((depth == 0) || ((depth == 1) && (c == ',')))
+                {
+                    args.push_back(rewriteType(argStart, argToken.mStart, substitution, uses));
+                    argStart = argToken.mEnd;
+                }
+            }
+
+            const std::string instanceName =
+                (depth == 0) ? useInstance(word, args, token.mStart, uses) : std::string{};
+            if (instanceName.empty() == false)
+            {
+                result.append(instanceName);
+                pos = argsEnd;
+                continue;
+            }
+        }
+
+        const auto param = substitution.find(word);
+        result.append((param != substitution.end()) ? std::string_view{param->second} : word);
+    }
+
+    return result;
+}
+
+std::string GenericExpansion::rewriteType( //
+    const size_t begin,
+    const size_t end,
+    const Substitution &substitution,
+    std::vector<std::string> &uses)
+{
+    const std::string type = rewrite(begin, end, substitution, uses);
+
+    std::string canonical;
+
+    size_t pos = 0;
+    while (true)
+    {
+        const Token token = nextToken(type, pos);
+        if (token.mStart >= type.size())
+        {
+            break;
+        }
+
+        canonical += canonical.empty() ? "" : " ";
+        canonical += getTokenText(type, token);
+
+        pos = token.mEnd;
+    }
+
+    return canonical;
+}
+
+std::string GenericExpansion::useInstance( //
+    const std::string_view name,
+    const std::vector<std::string> &args,
+    const size_t pos,
+    std::vector<std::string> &uses)
+{
+    const auto generic = mGenerics.find(name);
+    if (generic == mGenerics.end())
+    {
+        error(pos, "unknown generic '" + std::string{name} + "'");
+        return {};
+    }
+
+    const auto &params = generic->second.mNode->getParams();
+    if (args.size() != params.size())
+    {
+        const std::string count = std::to_string(params.size());
+        error(pos, "generic '" + generic->second.mName + "' takes " + count + " type argument(s)");
+        return {};
+    }
+
+    std::string instanceName = generic->second.mName;
+    for (const auto &it : args)
+    {
+        const std::string mangled = mangle(it);
+        if (mangled.empty())
+        {
+            error(pos, "type '" + it + "' can not be a generic argument, use a typedef");
+            return {};
+        }
+
+        instanceName += "_" + mangled;
+    }
+
+    mInstances.try_emplace(instanceName, Instance{&generic->second, args, false, {}, {}});
+    uses.push_back(instanceName);
+
+    return instanceName;
+}
+
+std::string GenericExpansion::emitInstances(const std::vector<std::string> &uses)
+{
+    std::vector<std::string> order;
+    for (const auto &it : uses)
+    {
+        visitInstance(it, order, 0);
+    }
+
+    // the structs first, the function prototypes and definitions may need
+    // them - the prototypes let the functions use each other in any order
+    std::string structs;
+    std::string prototypes;
+    std::string definitions;
+
+    for (const auto &it : order)
+    {
+        const Instance &instance = mInstances.at(it);
+        const Generic &generic = *instance.mGeneric;
+
+        if (generic.mIsFunction == false)
+        {
+            structs += "\n\n" + instance.mDefinition;
+            mReport.mInstances++;
+            continue;
+        }
+
+        prototypes += (prototypes.empty() ? "\n\n" : "\n") + instance.mPrototype;
+
+        if (generic.mIsStatic == false)
+        {
+            const auto owner = mOwners.try_emplace(it, mOwner).first;
+            if (owner->second != mOwner)
+            {
+                mReport.mDeclared++;
+                continue;
+            }
+        }
+
+        definitions += "\n\n" + instance.mDefinition;
+        mReport.mInstances++;
+    }
+
+    return structs + prototypes + definitions;
+}
+
+void GenericExpansion::visitInstance(const std::string &name, std::vector<std::string> &order, const uint32_t depth)
+{
+    Instance &instance = mInstances.at(name);
+    if (instance.mVisited)
+    {
+        return;
+    }
+
+    instance.mVisited = true;
+
+    if (depth >= kMaxInstanceDepth)
+    {
+        error(instance.mGeneric->mNode->getSemStart(), "instance '" + name + "' nested too deep");
+        return;
+    }
+
+    std::vector<std::string> uses;
+    instantiate(name, instance, uses);
+
+    // dependencies first
+    for (const auto &it : uses)
+    {
+        visitInstance(it, order, depth + 1);
+    }
+
+    order.push_back(name);
+}
+
+void GenericExpansion::instantiate(const std::string &name, Instance &instance, std::vector<std::string> &uses)
+{
+    const Generic &generic = *instance.mGeneric;
+    const auto &params = generic.mNode->getParams();
+
+    Substitution substitution;
+    for (size_t i = 0; i < params.size(); i++)
+    {
+        substitution[params[i]] = instance.mArgs[i];
+    }
+
+    const std::string head = rewrite(generic.mNode->getHeaderEnd(), generic.mNameStart, substitution, uses) + name;
+
+    const std::string definition = head + rewrite(generic.mNameEnd, generic.mNode->getEnd(), substitution, uses);
+    instance.mDefinition = trim(definition);
+
+    if (generic.mIsFunction)
+    {
+        const std::string prototype = head + rewrite(generic.mNameEnd, generic.mBodyStart, substitution, uses);
+        instance.mPrototype = std::string{generic.mIsStatic ? "" : "extern "} + std::string{trim(prototype)} + ";";
+    }
+}
+
+void GenericExpansion::error(const size_t pos, const std::string &message)
+{
+    const auto line = std::count(mSource.begin(), mSource.begin() + std::min(pos, mSource.size()), '\n') + 1;
+    log("ERROR: line %: %", Color::Red, line, message);
+
+    mFailed = true;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace safec
+{
+
+// Monomorphization of the generics. Each "Name::<type, ...>" use gets its
+// own copy of the generic with the params replaced by the types, named after
+// them (Max::<int> is Max_int, Pair::<char *> is Pair_char_ptr). The copies
+// are placed before the top level definition with the first use, the generic
+// definitions are dropped.
+//
+// The result is SafeC source without generics, the generator parses it again
+// so the other passes also apply to the instances.
+//
+// A function instance is defined by a single file of the invocation, the
+// first one generated with it, the other files only declare it. Nothing is
+// kept between the invocations, the output depends only on the files given.
+// The struct instances and the instances of static functions are emitted in
+// every file using them.
+class GenericExpansion final
+{
+public:
+    struct Report
+    {
+        uint32_t mInstances = 0; // emitted instances
+        uint32_t mDeclared = 0;  // function instances defined by other files
+    };
+
+    // instance -> file defining it, shared by the files of one invocation
+    using Owners = std::map<std::string, std::string>;
+
+    // the output file defines the instances not in owners yet
+    GenericExpansion(const std::filesystem::path &outputFile, Owners &owners);
+
+    // true if there are generic definitions or uses below the node
+    static bool hasGenerics(const SemNode &node);
+
+    // false on errors (already logged), the uses that could not be
+    // expanded are left in the source
+    bool expand(const SemNodeTranslationUnit &translationUnit, std::string &expanded);
+
+    const Report &getReport() const;
+
+private:
+    struct Generic
+    {
+        const SemNodeGeneric *mNode;
+        std::string mName;
+        bool mIsFunction;
+        bool mIsStatic;
+        size_t mNameStart;
+        size_t mNameEnd;
+        size_t mBodyStart; // of the function body, the prototype ends there
+    };
+
+    struct Instance
+    {
+        const Generic *mGeneric;
+        std::vector<std::string> mArgs;
+        bool mVisited;
+        std::string mDefinition;
+        std::string mPrototype;
+    };
+
+    using Substitution = std::map<std::string_view, std::string>;
+
+    Owners &mOwners;
+    std::string mOwner;
+
+    std::string mSource;
+    std::map<std::string, Generic, std::less<>> mGenerics;
+    std::map<std::string, Instance> mInstances;
+
+    bool mFailed;
+    Report mReport;
+
+    void collectGenerics(const SemNodeTranslationUnit &translationUnit);
+    bool findFunctionName(Generic &generic, const SemNodeFunction &function) const;
+    bool findStructName(Generic &generic) const;
+
+    // source in [begin, end) with the instance names in place of the uses and
+    // the types in place of the params, the instances used are added to uses
+    std::string rewrite( //
+        const size_t begin,
+        const size_t end,
+        const Substitution &substitution,
+        std::vector<std::string> &uses);
+
+    // canonical text of a type argument, the tokens separated by single spaces
+    std::string rewriteType( //
+        const size_t begin,
+        const size_t end,
+        const Substitution &substitution,
+        std::vector<std::string> &uses);
+
+    // name of the instance, empty on errors
+    std::string useInstance( //
+        const std::string_view name,
+        const std::vector<std::string> &args,
+        const size_t pos,
+        std::vector<std::string> &uses);
+
+    // instances used from a top level definition with all of their
+    // dependencies not emitted yet, as code to be placed before it
+    std::string emitInstances(const std::vector<std::string> &uses);
+    void visitInstance(const std::string &name, std::vector<std::string> &order, const uint32_t depth);
+    void instantiate(const std::string &name, Instance &instance, std::vector<std::string> &uses);
+
+    void error(const size_t pos, const std::string &message);
+};
+
+} // namespace safec
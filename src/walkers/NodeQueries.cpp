@@ -0,0 +1,213 @@
+#include "NodeQueries.hpp"
+
+#include "ConstantEvaluation.hpp"
+
+#include <cctype>
+#include <cstdlib>
+
+namespace safec
+{
+
+namespace nodes
+{
+
+bool isAssignment(const std::string &op)
+{
+    // clang-format off
+    static const std::set<std::string> kAssignments = {
+        "=", "+=", "-=", "*=", "/=", "%=", "<<=", ">>=", "&=", "|=", "^="};
+    // clang-format on
+
+    return (kAssignments.count(op) != 0);
+}
+
+const SemNodeDeclaration *getDeclaration(const SemNode &statement)
+{
+    if (statement.getType() == SemNode::Type::Declaration)
+    {
+        return &static_cast<const SemNodeDeclaration &>(statement);
+    }
+
+    // declaration with an initializer
+    if (statement.getType() == SemNode::Type::BinaryOp)
+    {
+        const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(statement);
+        const auto lhs = binaryOp.getLhs();
+        if ((binaryOp.getOp() == "=") && (lhs != nullptr) && (lhs->getType() == SemNode::Type::Declaration))
+        {
+            return static_cast<const SemNodeDeclaration *>(lhs.get());
+        }
+    }
+
+    return nullptr;
+}
+
+std::optional<std::string> getVariableName(const SemNode *node)
+{
+    if ((node == nullptr) || (node->getType() != SemNode::Type::Identifier) ||
+        (node->getAttachedNodes().empty() == false))
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<const SemNodeIdentifier *>(node)->getName();
+}
+
+std::optional<int64_t> getIntegerValue(const SemNode &node)
+{
+    // constant expressions of int type, the long constants are parsed below
+    std::string error;
+    const auto constant = constants::evaluate(node, error);
+    if (constant.has_value())
+    {
+        return constant->mValue;
+    }
+
+    if (node.getType() == SemNode::Type::UnaryOp)
+    {
+        const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(node);
+        const auto rhs = unaryOp.getRhs();
+        const auto value = (rhs != nullptr) ? getIntegerValue(*rhs) : std::nullopt;
+        if ((value.has_value() == false) || ((unaryOp.getOp() != "-") && (unaryOp.getOp() != "+")))
+        {
+            return std::nullopt;
+        }
+
+        return (unaryOp.getOp() == "-") ? -*value : *value;
+    }
+
+    if (node.getType() != SemNode::Type::Constant)
+    {
+        return std::nullopt;
+    }
+
+    std::string text = static_cast<const SemNodeConstant &>(node).getName();
+    while ((text.empty() == false) && (std::string{"uUlL"}.find(text.back()) != std::string::npos))
+    {
+        text.pop_back();
+    }
+
+    if (text.empty() || (std::isdigit(static_cast<unsigned char>(text.front())) == 0))
+    {
+        return std::nullopt;
+    }
+
+    char *end = nullptr;
+    const long long value = std::strtoll(text.c_str(), &end, 0);
+    if (*end != '\0')
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<int64_t>(value);
+}
+
+void collectNames(const SemNode &node, std::set<std::string> &names)
+{
+    if (node.getType() == SemNode::Type::Identifier)
+    {
+        names.insert(static_cast<const SemNodeIdentifier &>(node).getName());
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        collectNames(*it, names);
+    }
+}
+
+void collectWrites(const SemNode &node, Writes &writes)
+{
+    switch (node.getType())
+    {
+        case SemNode::Type::BinaryOp:
+        {
+            const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(node);
+            const auto name = getVariableName(binaryOp.getLhs().get());
+            if (isAssignment(binaryOp.getOp()) && name.has_value())
+            {
+                writes.mNames.insert(*name);
+            }
+        }
+        break;
+
+        case SemNode::Type::UnaryOp:
+        {
+            const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(node);
+            const auto name = getVariableName(unaryOp.getRhs().get());
+            const std::string op = unaryOp.getOp();
+            if (((op == "++") || (op == "--") || (op == "&")) && name.has_value())
+            {
+                writes.mNames.insert(*name);
+            }
+        }
+        break;
+
+        case SemNode::Type::PostfixExpression:
+        {
+            const auto &postfix = static_cast<const SemNodePostfixExpression &>(node);
+            const auto name = getVariableName(postfix.getLhs().get());
+            const std::string op = postfix.getOperator();
+            if (((op == "++") || (op == "--")) && name.has_value())
+            {
+                writes.mNames.insert(*name);
+            }
+            else if ((op == "()") || (op == "(...)"))
+            {
+                writes.mCall = true;
+            }
+        }
+        break;
+
+        case SemNode::Type::Declaration:
+            writes.mNames.insert(static_cast<const SemNodeDeclaration &>(node).getLhsIdentifier());
+            break;
+
+        default:
+            break;
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        collectWrites(*it, writes);
+    }
+}
+
+void collectAddressTaken(const SemNode &node, std::set<std::string> &names)
+{
+    if (node.getType() == SemNode::Type::UnaryOp)
+    {
+        const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(node);
+        const auto name = getVariableName(unaryOp.getRhs().get());
+        if ((unaryOp.getOp() == "&") && name.has_value())
+        {
+            names.insert(*name);
+        }
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        collectAddressTaken(*it, names);
+    }
+}
+
+bool containsExit(const SemNode &node)
+{
+    if ((node.getType() == SemNode::Type::Return) || (node.getType() == SemNode::Type::JumpStatement))
+    {
+        return true;
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        if (containsExit(*it))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace nodes
+
+} // namespace safec
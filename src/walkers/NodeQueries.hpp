@@ -0,0 +1,48 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+
+namespace safec
+{
+
+// Questions about the AST shared by the passes that analyze the code.
+namespace nodes
+{
+
+// variables that can change in a node (assigned, incremented, address
+// taken or declared again) and if there is a call that can change globals
+struct Writes
+{
+    std::set<std::string> mNames;
+    bool mCall = false;
+};
+
+bool isAssignment(const std::string &op);
+
+// the declaration of a statement, also one with an initializer
+const SemNodeDeclaration *getDeclaration(const SemNode &statement);
+
+// the name of a plain identifier, not an array or a function call
+std::optional<std::string> getVariableName(const SemNode *node);
+
+// value of an integer constant, optionally negated, or of an
+// integer constant expression
+std::optional<int64_t> getIntegerValue(const SemNode &node);
+
+void collectNames(const SemNode &node, std::set<std::string> &names);
+void collectWrites(const SemNode &node, Writes &writes);
+
+// variables used with "&", they can change through the pointers
+void collectAddressTaken(const SemNode &node, std::set<std::string> &names);
+
+// return, break or continue anywhere in the node
+bool containsExit(const SemNode &node);
+
+} // namespace nodes
+
+} // namespace safec
@@ -0,0 +1,340 @@
+#include "SourceText.hpp"
+
+#include "logger/Logger.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace safec
+{
+
+namespace source
+{
+
+std::string readSourceFile(const std::filesystem::path &path)
+{
+    std::string source;
+
+    FILE *fp = fopen(path.c_str(), "r");
+    if (fp == nullptr)
+    {
+        log("failed to open file %, error: %", //
+            Color::Red,
+            path.c_str(),
+            strerror(errno));
+        return source;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    const long fileSize = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    source.resize((fileSize > 0) ? static_cast<size_t>(fileSize) : 0U);
+    source.resize(fread(source.data(), 1, source.size(), fp));
+
+    fclose(fp);
+    return source;
+}
+
+bool isBlank(const char c)
+{
+    return (std::isspace(static_cast<unsigned char>(c)) != 0);
+}
+
+bool isIdentifierChar(const char c)
+{
+    return (std::isalnum(static_cast<unsigned char>(c)) != 0) || (c == '_');
+}
+
+size_t skipBlank(const std::string_view text, size_t pos)
+{
+    while (pos < text.size())
+    {
+        if (isBlank(text[pos]))
+        {
+            pos++;
+        }
+        else if ((text[pos] == '#') && ((pos == 0) || (text[pos - 1] == '\n')))
+        {
+            pos = text.find('\n', pos);
+        }
+        else if (text.compare(pos, 2, "//") == 0)
+        {
+            pos = text.find('\n', pos);
+        }
+        else if (text.compare(pos, 2, "/*") == 0)
+        {
+            const size_t commentEnd = text.find("*/", pos + 2);
+            pos = (commentEnd == std::string_view::npos) ? commentEnd : (commentEnd + 2);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return std::min(pos, text.size());
+}
+
+std::string_view trim(std::string_view text)
+{
+    while ((text.empty() == false) && isBlank(text.front()))
+    {
+        text.remove_prefix(1);
+    }
+
+    while ((text.empty() == false) && isBlank(text.back()))
+    {
+        text.remove_suffix(1);
+    }
+
+    return text;
+}
+
+
+std::string_view getNodeSource(const std::string &source, const SemNode &node)
+{
+    const uint32_t start = node.getSemStart();
+    const uint32_t end = node.getSemEnd();
+
+    if ((start >= end) || (end > source.size()))
+    {
+        return std::string_view{};
+    }
+
+    return std::string_view{source}.substr(start, end - start);
+}
+
+bool hasPreprocessorLine(const std::string_view text)
+{
+    for (size_t pos = text.find('#'); pos != std::string_view::npos; pos = text.find('#', pos + 1))
+    {
+        size_t lineStart = pos;
+        while ((lineStart > 0) && ((text[lineStart - 1] == ' ') || (text[lineStart - 1] == '\t')))
+        {
+            lineStart--;
+        }
+
+        // the text starts after the previous statement, not at a line start
+        if ((lineStart > 0) && (text[lineStart - 1] == '\n'))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+size_t findLabel(const std::string_view text, const std::string_view name)
+{
+    char prev = ';';
+    std::string_view prevWord;
+    for (size_t pos = 0; pos < text.size();)
+    {
+        const char c = text[pos];
+        if ((c == '"') || (c == '\''))
+        {
+            // skip the literal, the quote can be escaped
+            while ((++pos < text.size()) && (text[pos] != c))
+            {
+                pos += (text[pos] == '\\') ? 1U : 0U;
+            }
+
+            pos++;
+            prev = c;
+            prevWord = {};
+        }
+        else if (isBlank(c) || (c == '#') || (text.compare(pos, 2, "//") == 0) || (text.compare(pos, 2, "/*") == 0))
+        {
+            const size_t next = skipBlank(text, pos);
+            pos = (next > pos) ? next : (pos + 1);
+        }
+        else if (isIdentifierChar(c))
+        {
+            size_t wordEnd = pos;
+            while ((wordEnd < text.size()) && isIdentifierChar(text[wordEnd]))
+            {
+                wordEnd++;
+            }
+
+            const std::string_view word = text.substr(pos, wordEnd - pos);
+            const size_t colon = skipBlank(text, wordEnd);
+            if ((colon < text.size()) && (text[colon] == ':') && (text.compare(colon, 2, "::") != 0) &&
+                (std::isdigit(static_cast<unsigned char>(c)) == 0) && (word != "default") &&
+                ((std::string_view{";{}:)"}.find(prev) != std::string_view::npos) || (prevWord == "else")) &&
+                (name.empty() || (word == name)))
+            {
+                return pos;
+            }
+
+            pos = wordEnd;
+            prev = 'a';
+            prevWord = word;
+        }
+        else
+        {
+            pos++;
+            prev = c;
+            prevWord = {};
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+std::optional<std::string> getLineIndent(const std::string &source, const size_t pos)
+{
+    size_t lineStart = pos;
+    while ((lineStart > 0) && ((source[lineStart - 1] == ' ') || (source[lineStart - 1] == '\t')))
+    {
+        lineStart--;
+    }
+
+    if ((lineStart > 0) && (source[lineStart - 1] != '\n'))
+    {
+        return std::nullopt;
+    }
+
+    return source.substr(lineStart, pos - lineStart);
+}
+
+std::optional<std::string> getExpressionText(const SemNode &node)
+{
+    switch (node.getType())
+    {
+        case SemNode::Type::Identifier:
+        {
+            // an identifier with children is the callee or the array of
+            // a postfix expression, handled there
+            if (node.getAttachedNodes().empty() == false)
+            {
+                return std::nullopt;
+            }
+
+            return static_cast<const SemNodeIdentifier &>(node).getName();
+        }
+
+        case SemNode::Type::Constant:
+            return static_cast<const SemNodeConstant &>(node).getName();
+
+        case SemNode::Type::BinaryOp:
+        {
+            const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(node);
+
+            // clang-format off
+            static constexpr std::string_view kOperators[] = {
+                "+", "-", "*", "/", "%", "<<", ">>", "&", "|", "^",
+                "<", ">", "<=", ">=", "==", "!=", "&&", "||"};
+            // clang-format on
+
+            const std::string op = binaryOp.getOp();
+            if (std::find(std::begin(kOperators), std::end(kOperators), op) == std::end(kOperators))
+            {
+                return std::nullopt;
+            }
+
+            if ((binaryOp.getLhs() == nullptr) || (binaryOp.getRhs() == nullptr))
+            {
+                return std::nullopt;
+            }
+
+            const auto lhs = getExpressionText(*binaryOp.getLhs());
+            const auto rhs = getExpressionText(*binaryOp.getRhs());
+            if ((lhs.has_value() == false) || (rhs.has_value() == false))
+            {
+                return std::nullopt;
+            }
+
+            return "(" + *lhs + " " + op + " " + *rhs + ")";
+        }
+
+        case SemNode::Type::UnaryOp:
+        {
+            const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(node);
+
+            const std::string op = unaryOp.getOp();
+            if (((op != "-") && (op != "+") && (op != "~") && (op != "!")) || (unaryOp.getRhs() == nullptr))
+            {
+                return std::nullopt;
+            }
+
+            const auto rhs = getExpressionText(*unaryOp.getRhs());
+            if (rhs.has_value() == false)
+            {
+                return std::nullopt;
+            }
+
+            return op + *rhs;
+        }
+
+        case SemNode::Type::PostfixExpression:
+        {
+            const auto &postfix = static_cast<const SemNodePostfixExpression &>(node);
+            if (postfix.getOperator() != "[]")
+            {
+                return std::nullopt;
+            }
+
+            // the index is attached to the array expression
+            const auto &array = *postfix.getLhs();
+            const auto &arrayChildren = array.getAttachedNodes();
+            if (arrayChildren.empty())
+            {
+                return std::nullopt;
+            }
+
+            std::optional<std::string> arrayText;
+            if (array.getType() == SemNode::Type::Identifier)
+            {
+                if (arrayChildren.size() == 1)
+                {
+                    arrayText = static_cast<const SemNodeIdentifier &>(array).getName();
+                }
+            }
+            else
+            {
+                arrayText = getExpressionText(array);
+            }
+
+            const auto index = getExpressionText(*arrayChildren.back());
+            if ((arrayText.has_value() == false) || (index.has_value() == false))
+            {
+                return std::nullopt;
+            }
+
+            return *arrayText + "[" + *index + "]";
+        }
+
+        default:
+            return std::nullopt;
+    }
+}
+
+void insertBeforeStatement( //
+    SemNodeTranslationUnit &translationUnit,
+    const std::string &source,
+    SemNode &statement,
+    const std::vector<std::string> &code)
+{
+    // the sem range starts with the whitespace before the statement
+    const size_t pos = skipBlank(source, statement.getSemStart());
+    const auto indent = getLineIndent(source, pos);
+
+    std::string text;
+    for (const auto &it : code)
+    {
+        text += indent.has_value() ? (it + "\n" + *indent) : (it + " ");
+    }
+
+    auto generatedCode = std::make_shared<SemNodeGeneratedCode>(static_cast<uint32_t>(pos), text);
+    statement.getParent()->setDirty(SemNode::DirtyType::Modified);
+    statement.insertBefore(generatedCode);
+    translationUnit.registerNode(generatedCode);
+}
+
+} // namespace source
+
+} // namespace safec
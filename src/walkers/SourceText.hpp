@@ -0,0 +1,60 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace safec
+{
+
+// Helpers for the passes that generate C code from the original source.
+namespace source
+{
+
+std::string readSourceFile(const std::filesystem::path &path);
+
+bool isBlank(const char c);
+bool isIdentifierChar(const char c);
+
+// position of the first character after the whitespace, comments
+// and preprocessor lines from pos
+size_t skipBlank(const std::string_view text, size_t pos);
+
+std::string_view trim(std::string_view text);
+
+// source in the sem range of the node, empty if it has no range
+std::string_view getNodeSource(const std::string &source, const SemNode &node);
+
+// a preprocessor line starts in the text, the text itself starts after
+// the previous statement - the "#" at its start is not at a line start
+bool hasPreprocessorLine(const std::string_view text);
+
+// position of the label "name:" in the text, of any label if the name
+// is empty - a name after a statement, a brace, a condition or another
+// label, the names before ":" in a "?:" or after "case" do not follow
+// any of them
+size_t findLabel(const std::string_view text, const std::string_view name = {});
+
+// indentation of the line with pos, if there is nothing else before pos
+std::optional<std::string> getLineIndent(const std::string &source, const size_t pos);
+
+// C code of a side effect free expression (identifiers, constants,
+// arithmetic and array subscripts), rebuilt from the AST - the
+// expression nodes have no source range
+std::optional<std::string> getExpressionText(const SemNode &node);
+
+// inserts the lines of code before the statement, on their own lines
+// if the statement starts its line
+void insertBeforeStatement( //
+    SemNodeTranslationUnit &translationUnit,
+    const std::string &source,
+    SemNode &statement,
+    const std::vector<std::string> &code);
+
+} // namespace source
+
+} // namespace safec
@@ -0,0 +1,815 @@
+#include "WalkerBoundsCheck.hpp"
+
+#include "NodeQueries.hpp"
+#include "SourceText.hpp"
+#include "logger/Logger.hpp"
+
+#include <algorithm>
+
+using namespace safec;
+using namespace safec::nodes;
+using namespace safec::source;
+
+namespace
+{
+
+// the checks can be redefined before the generated file is compiled
+constexpr const char *kCheckDefinitions = //
+    "#ifndef SAFEC_BOUNDS_CHECK\n"
+    "#include <assert.h>\n"
+    "#define SAFEC_BOUNDS_CHECK(index, size) assert(((index) >= 0) && ((index) < (size)))\n"
+    "#define SAFEC_BOUNDS_CHECK_RANGE(first, end, size) \\\n"
+    "    assert(((first) >= (end)) || (((first) >= 0) && ((end) <= (size))))\n"
+    "#endif\n"
+    "\n";
+
+bool isSkipped(const SemNode &node)
+{
+    return (node.getDirty() == SemNode::DirtyType::Removed) || //
+           (node.getDirty() == SemNode::DirtyType::Added) ||   //
+           (node.getType() == SemNode::Type::GeneratedCode);
+}
+
+// statements that are not made of other statements
+bool isSimpleStatement(const SemNode &node)
+{
+    switch (node.getType())
+    {
+        case SemNode::Type::Scope:
+        case SemNode::Type::Loop:
+        case SemNode::Type::If:
+        case SemNode::Type::SwitchCase:
+        case SemNode::Type::SwitchCaseLabel:
+        case SemNode::Type::Defer:
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+// return, goto or a break of the loop (not of a nested loop or switch)
+bool leavesLoop(const SemNode &node, const bool breakLeaves)
+{
+    for (const auto &it : node.getAttachedNodes())
+    {
+        if (it->getType() == SemNode::Type::Return)
+        {
+            return true;
+        }
+
+        if (it->getType() == SemNode::Type::JumpStatement)
+        {
+            const std::string name = static_cast<const SemNodeJumpStatement &>(*it).getName();
+            if ((name == "goto") || ((name == "break") && breakLeaves))
+            {
+                return true;
+            }
+        }
+
+        const bool isBreakTarget =
+            (it->getType() == SemNode::Type::Loop) || (it->getType() == SemNode::Type::SwitchCase);
+        if (leavesLoop(*it, breakLeaves && (isBreakTarget == false)))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// "a" with its index of "a[i][j]", nullptr if the node is not a subscript
+const SemNodeIdentifier *getFirstSubscript(const SemNode &node)
+{
+    if ((node.getType() == SemNode::Type::Identifier) && (node.getAttachedNodes().empty() == false))
+    {
+        return &static_cast<const SemNodeIdentifier &>(node);
+    }
+
+    if (node.getType() != SemNode::Type::PostfixExpression)
+    {
+        return nullptr;
+    }
+
+    const auto &postfix = static_cast<const SemNodePostfixExpression &>(node);
+    if ((postfix.getOperator() != "[]") || (postfix.getLhs() == nullptr))
+    {
+        return nullptr;
+    }
+
+    return getFirstSubscript(*postfix.getLhs());
+}
+
+// c for the index "v + c", "c + v" or "v - c" of the induction variable v
+std::optional<int64_t> getInductionOffset(const SemNode &index, const std::string &variable)
+{
+    if (getVariableName(&index) == variable)
+    {
+        return 0;
+    }
+
+    if (index.getType() != SemNode::Type::BinaryOp)
+    {
+        return std::nullopt;
+    }
+
+    const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(index);
+    if ((binaryOp.getLhs() == nullptr) || (binaryOp.getRhs() == nullptr))
+    {
+        return std::nullopt;
+    }
+
+    const auto lhsValue = getIntegerValue(*binaryOp.getLhs());
+    const auto rhsValue = getIntegerValue(*binaryOp.getRhs());
+    const bool lhsIsVariable = (getVariableName(binaryOp.getLhs().get()) == variable);
+    const bool rhsIsVariable = (getVariableName(binaryOp.getRhs().get()) == variable);
+
+    if (binaryOp.getOp() == "+")
+    {
+        if (lhsIsVariable && rhsValue.has_value())
+        {
+            return *rhsValue;
+        }
+
+        if (rhsIsVariable && lhsValue.has_value())
+        {
+            return *lhsValue;
+        }
+    }
+    else if ((binaryOp.getOp() == "-") && lhsIsVariable && rhsValue.has_value())
+    {
+        return -*rhsValue;
+    }
+
+    return std::nullopt;
+}
+
+std::string addOffset(const std::string &text, const int64_t offset)
+{
+    if (offset == 0)
+    {
+        return text;
+    }
+
+    const std::string sign = (offset > 0) ? " + " : " - ";
+    return "(" + text + sign + std::to_string((offset > 0) ? offset : -offset) + ")";
+}
+
+std::optional<int64_t> addOffset(const std::optional<int64_t> value, const int64_t offset)
+{
+    if (value.has_value() == false)
+    {
+        return std::nullopt;
+    }
+
+    return *value + offset;
+}
+
+} // namespace
+
+WalkerBoundsCheck::WalkerBoundsCheck()
+    : mTranslationUnit{nullptr}
+{
+}
+
+bool WalkerBoundsCheck::commit(SemNodeTranslationUnit &translationUnit)
+{
+    mTranslationUnit = &translationUnit;
+    mSource = readSourceFile(translationUnit.getSourcePath());
+
+    mSymbols.clear();
+    mSymbols.emplace_back();
+
+    mGlobalAddressTaken.clear();
+    collectAddressTaken(translationUnit, mGlobalAddressTaken);
+
+    for (const auto &it : translationUnit.getAttachedNodes())
+    {
+        if (isSkipped(*it))
+        {
+            continue;
+        }
+
+        if (it->getType() != SemNode::Type::Function)
+        {
+            declare(*it);
+            continue;
+        }
+
+        const auto &function = static_cast<const SemNodeFunction &>(*it);
+
+        mAddressTaken.clear();
+        collectAddressTaken(function, mAddressTaken);
+
+        // the array parameters are pointers, only hide the outer arrays
+        mSymbols.emplace_back();
+        for (const auto &param : function.getParams())
+        {
+            mSymbols.back()[param.mName] = std::nullopt;
+        }
+
+        for (const auto &body : it->getAttachedNodes())
+        {
+            if (body->getType() == SemNode::Type::Scope)
+            {
+                visitBlock(*body);
+            }
+        }
+
+        mSymbols.pop_back();
+    }
+
+    // an access out of the range is an error, nothing is generated
+    if (mReport.mOutOfRange != 0)
+    {
+        return false;
+    }
+
+    if (mChecks.empty() == false)
+    {
+        insertChecks();
+    }
+
+    return true;
+}
+
+const WalkerBoundsCheck::Report &WalkerBoundsCheck::getReport() const
+{
+    return mReport;
+}
+
+void WalkerBoundsCheck::visitBlock(SemNode &block)
+{
+    mSymbols.emplace_back();
+
+    for (const auto &it : block.getAttachedNodes())
+    {
+        visitStatement(*it, true);
+    }
+
+    mSymbols.pop_back();
+}
+
+void WalkerBoundsCheck::visitStatement(SemNode &statement, const bool canInsert)
+{
+    // removed by the defer lowering, its copies are not visited - the
+    // statement runs at the exits, there is no place for the checks
+    if (statement.getType() == SemNode::Type::Defer)
+    {
+        checkAccesses(statement, nullptr);
+        return;
+    }
+
+    if (isSkipped(statement))
+    {
+        return;
+    }
+
+    switch (statement.getType())
+    {
+        case SemNode::Type::Scope:
+            visitBlock(statement);
+            break;
+
+        case SemNode::Type::If:
+            visitIf(statement, canInsert);
+            break;
+
+        case SemNode::Type::SwitchCase:
+            visitSwitch(statement, canInsert);
+            break;
+
+        case SemNode::Type::SwitchCaseLabel:
+        {
+            // the first node is the case label
+            const auto &attachedNodes = statement.getAttachedNodes();
+            for (size_t i = 1; i < attachedNodes.size(); i++)
+            {
+                visitStatement(*attachedNodes[i], canInsert);
+            }
+        }
+        break;
+
+        case SemNode::Type::Loop:
+            visitLoop(static_cast<SemNodeLoop &>(statement), canInsert);
+            break;
+
+        default:
+        {
+            // C89 - no statement can be placed before a declaration
+            const bool isDeclaration = (getDeclaration(statement) != nullptr);
+            checkAccesses(statement, (canInsert && (isDeclaration == false)) ? &statement : nullptr);
+
+            if (isDeclaration)
+            {
+                declare(statement);
+            }
+        }
+        break;
+    }
+}
+
+void WalkerBoundsCheck::visitIf(SemNode &ifNode, const bool canInsert)
+{
+    for (const auto &it : ifNode.getAttachedNodes())
+    {
+        if (it->getType() == SemNode::Type::Group)
+        {
+            // the condition runs once, before the body
+            checkAccesses(*it, canInsert ? &ifNode : nullptr);
+        }
+        else
+        {
+            visitStatement(*it, (it->getType() == SemNode::Type::Scope));
+        }
+    }
+}
+
+void WalkerBoundsCheck::visitSwitch(SemNode &switchNode, const bool canInsert)
+{
+    for (const auto &it : switchNode.getAttachedNodes())
+    {
+        if (it->getType() == SemNode::Type::Scope)
+        {
+            visitBlock(*it);
+        }
+        else
+        {
+            checkAccesses(*it, canInsert ? &switchNode : nullptr);
+        }
+    }
+}
+
+void WalkerBoundsCheck::visitLoop(SemNodeLoop &loop, const bool canInsert)
+{
+    // the init runs once before the loop, the condition and the change
+    // on each iteration, there is no place for their checks
+    if (loop.getIteratorInit() != nullptr)
+    {
+        checkAccesses(*loop.getIteratorInit(), canInsert ? &loop : nullptr);
+    }
+
+    if (loop.getIteratorCondition() != nullptr)
+    {
+        checkAccesses(*loop.getIteratorCondition(), nullptr);
+    }
+
+    if (loop.getIteratorChange() != nullptr)
+    {
+        checkAccesses(*loop.getIteratorChange(), nullptr);
+    }
+
+    for (const auto &it : loop.getAttachedNodes())
+    {
+        if (it->getType() == SemNode::Type::Group)
+        {
+            continue;
+        }
+
+        // the loop can stop before the end of its range, a check of the
+        // whole range would fail for the iterations that never run
+        const auto induction = canInsert ? findInduction(loop) : std::nullopt;
+        if (induction.has_value() && (it->getType() == SemNode::Type::Scope) && (isSkipped(*it) == false) &&
+            (leavesLoop(*it, true) == false))
+        {
+            visitLoopBody(*it, loop, *induction);
+        }
+        else
+        {
+            visitStatement(*it, (it->getType() == SemNode::Type::Scope));
+        }
+    }
+}
+
+void WalkerBoundsCheck::visitLoopBody(SemNode &body, SemNodeLoop &loop, const Induction &induction)
+{
+    // accesses indexed by the induction variable (plus a constant), checked
+    // together before the loop
+    struct Range
+    {
+        std::string mArrayName;
+        ArrayInfo mArray;
+        int64_t mOffset;
+        uint32_t mAccesses;
+    };
+
+    std::vector<Range> ranges;
+
+    mSymbols.emplace_back();
+
+    // an access is hoisted only if it runs on every iteration - not
+    // after an exit and not in a nested statement
+    bool exitSeen = false;
+    for (const auto &it : body.getAttachedNodes())
+    {
+        if (isSkipped(*it) && (it->getType() != SemNode::Type::Defer))
+        {
+            continue;
+        }
+
+        if ((isSimpleStatement(*it) == false) || exitSeen)
+        {
+            visitStatement(*it, true);
+            exitSeen = exitSeen || containsExit(*it);
+            continue;
+        }
+
+        std::vector<Access> accesses;
+        collectAccesses(*it, accesses);
+
+        Writes writes;
+        collectWrites(*it, writes);
+
+        const bool isDeclaration = (getDeclaration(*it) != nullptr);
+
+        for (const auto &access : accesses)
+        {
+            const auto offset = getInductionOffset(*access.mIndex, induction.mVariable);
+
+            // an array declared in the body does not exist before the loop
+            if (offset.has_value() && (access.mConditional == false) &&
+                (mSymbols.back().count(access.mArrayName) == 0))
+            {
+                auto range = ranges.begin();
+                while ((range != ranges.end()) &&
+                       ((range->mArrayName != access.mArrayName) || (range->mOffset != *offset)))
+                {
+                    range++;
+                }
+
+                if (range == ranges.end())
+                {
+                    ranges.push_back(Range{access.mArrayName, access.mArray, *offset, 0});
+                    range = ranges.end() - 1;
+                }
+
+                range->mAccesses++;
+                continue;
+            }
+
+            checkAccess(access, isDeclaration ? nullptr : it.get(), writes.mNames);
+        }
+
+        if (isDeclaration)
+        {
+            declare(*it);
+        }
+
+        exitSeen = exitSeen || containsExit(*it);
+    }
+
+    mSymbols.pop_back();
+
+    for (const auto &range : ranges)
+    {
+        const auto first = addOffset(induction.mFirst, range.mOffset);
+        const auto end = addOffset(induction.mEnd, range.mOffset);
+        const auto size = range.mArray.mSize;
+
+        if (first.has_value() && end.has_value() && size.has_value())
+        {
+            if ((*first >= *end) || ((*first >= 0) && (*end <= *size)))
+            {
+                mReport.mProven += range.mAccesses;
+                continue;
+            }
+
+            log("WARNING: line %: the loop accesses '%' out of its range [0, %)",
+                Color::Yellow,
+                getLine(skipBlank(mSource, loop.getSemStart())),
+                range.mArrayName,
+                *size);
+        }
+
+        const std::string firstText =
+            first.has_value() ? std::to_string(*first) : addOffset(induction.mFirstText, range.mOffset);
+        const std::string endText =
+            end.has_value() ? std::to_string(*end) : addOffset(induction.mEndText, range.mOffset);
+
+        addCheck(loop, "SAFEC_BOUNDS_CHECK_RANGE(" + firstText + ", " + endText + ", " + range.mArray.mSizeText + ");");
+
+        mReport.mHoisted += range.mAccesses;
+        mReport.mLoopChecks++;
+    }
+}
+
+void WalkerBoundsCheck::declare(const SemNode &statement)
+{
+    const auto declaration = getDeclaration(statement);
+    if (declaration == nullptr)
+    {
+        return;
+    }
+
+    auto &symbol = mSymbols.back()[declaration->getLhsIdentifier()];
+    symbol = std::nullopt;
+
+    const auto &dimensions = declaration->getArrayDimensions();
+    if (dimensions.empty())
+    {
+        return;
+    }
+
+    // only the first dimension is checked, an access to it is "a[i]"
+    const auto &size = dimensions.front();
+    if (size != nullptr)
+    {
+        const auto sizeText = getExpressionText(*size);
+        if (sizeText.has_value())
+        {
+            symbol = ArrayInfo{*sizeText, getIntegerValue(*size)};
+        }
+
+        return;
+    }
+
+    // "int a[] = { ... }" - the size is the initializer length
+    const auto &attachedNodes = statement.getAttachedNodes();
+    if ((dimensions.size() == 1) && (attachedNodes.size() == 2) &&
+        (attachedNodes[1]->getType() == SemNode::Type::InitializerList))
+    {
+        const int64_t length = static_cast<int64_t>(attachedNodes[1]->getAttachedNodes().size());
+        symbol = ArrayInfo{std::to_string(length), length};
+    }
+}
+
+std::optional<WalkerBoundsCheck::ArrayInfo> WalkerBoundsCheck::lookup(const std::string &name) const
+{
+    for (auto it = mSymbols.rbegin(); it != mSymbols.rend(); it++)
+    {
+        const auto symbol = it->find(name);
+        if (symbol != it->end())
+        {
+            return symbol->second;
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool WalkerBoundsCheck::isGlobal(const std::string &name) const
+{
+    for (auto it = mSymbols.rbegin(); it != mSymbols.rend(); it++)
+    {
+        if (it->count(name) != 0)
+        {
+            return (it == (mSymbols.rend() - 1));
+        }
+    }
+
+    return false;
+}
+
+std::optional<WalkerBoundsCheck::Induction> WalkerBoundsCheck::findInduction(SemNodeLoop &loop) const
+{
+    const auto init = loop.getIteratorInit();
+    const auto condition = loop.getIteratorCondition();
+    const auto change = loop.getIteratorChange();
+
+    if ((loop.getName() != "for") || (init == nullptr) || (condition == nullptr) || (change == nullptr) ||
+        (init->getType() != SemNode::Type::BinaryOp) || (condition->getType() != SemNode::Type::BinaryOp))
+    {
+        return std::nullopt;
+    }
+
+    // v = first
+    const auto &initOp = static_cast<const SemNodeBinaryOp &>(*init);
+    const auto variable = getVariableName(initOp.getLhs().get());
+    if ((initOp.getOp() != "=") || (variable.has_value() == false) || (initOp.getRhs() == nullptr))
+    {
+        return std::nullopt;
+    }
+
+    // v < end, v <= end, end > v, end >= v
+    const auto &conditionOp = static_cast<const SemNodeBinaryOp &>(*condition);
+    const std::string op = conditionOp.getOp();
+
+    std::shared_ptr<SemNode> end;
+    bool inclusive = false;
+    if (((op == "<") || (op == "<=")) && (getVariableName(conditionOp.getLhs().get()) == variable))
+    {
+        end = conditionOp.getRhs();
+        inclusive = (op == "<=");
+    }
+    else if (((op == ">") || (op == ">=")) && (getVariableName(conditionOp.getRhs().get()) == variable))
+    {
+        end = conditionOp.getLhs();
+        inclusive = (op == ">=");
+    }
+
+    if (end == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    // v++, ++v
+    std::optional<std::string> changed;
+    if (change->getType() == SemNode::Type::PostfixExpression)
+    {
+        const auto &postfix = static_cast<const SemNodePostfixExpression &>(*change);
+        if (postfix.getOperator() == "++")
+        {
+            changed = getVariableName(postfix.getLhs().get());
+        }
+    }
+    else if (change->getType() == SemNode::Type::UnaryOp)
+    {
+        const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(*change);
+        if (unaryOp.getOp() == "++")
+        {
+            changed = getVariableName(unaryOp.getRhs().get());
+        }
+    }
+
+    if (changed != variable)
+    {
+        return std::nullopt;
+    }
+
+    const auto firstText = getExpressionText(*initOp.getRhs());
+    const auto endText = getExpressionText(*end);
+    if ((firstText.has_value() == false) || (endText.has_value() == false))
+    {
+        return std::nullopt;
+    }
+
+    // neither v nor the end can change in the loop (also through a call,
+    // if they are globals, or through a pointer, if the address is taken)
+    Writes writes;
+    for (const auto &it : loop.getAttachedNodes())
+    {
+        if (it->getType() != SemNode::Type::Group)
+        {
+            collectWrites(*it, writes);
+        }
+    }
+
+    std::set<std::string> names;
+    collectNames(*end, names);
+    names.insert(*variable);
+
+    for (const auto &name : names)
+    {
+        const bool global = isGlobal(name);
+        if ((writes.mNames.count(name) != 0) || (writes.mCall && global) || (mAddressTaken.count(name) != 0) ||
+            (global && (mGlobalAddressTaken.count(name) != 0)))
+        {
+            return std::nullopt;
+        }
+    }
+
+    Induction induction;
+    induction.mVariable = *variable;
+    induction.mFirstText = *firstText;
+    induction.mFirst = getIntegerValue(*initOp.getRhs());
+    induction.mEndText = inclusive ? addOffset(*endText, 1) : *endText;
+    induction.mEnd = addOffset(getIntegerValue(*end), inclusive ? 1 : 0);
+
+    return induction;
+}
+
+void WalkerBoundsCheck::collectAccesses(const SemNode &node, std::vector<Access> &accesses)
+{
+    // the right side of "&&", "||" and "?" does not always run
+    bool conditional = false;
+    if (node.getType() == SemNode::Type::BinaryOp)
+    {
+        const std::string op = static_cast<const SemNodeBinaryOp &>(node).getOp();
+        conditional = ((op == "&&") || (op == "||") || (op == "?"));
+    }
+
+    const auto &attachedNodes = node.getAttachedNodes();
+    for (size_t i = 0; i < attachedNodes.size(); i++)
+    {
+        const size_t first = accesses.size();
+        collectAccesses(*attachedNodes[i], accesses);
+
+        for (size_t j = first; conditional && (i > 0) && (j < accesses.size()); j++)
+        {
+            accesses[j].mConditional = true;
+        }
+    }
+
+    // after the accesses in the index, "a[a[n]]" checks "n" first
+    if (node.getType() == SemNode::Type::PostfixExpression)
+    {
+        const auto &postfix = static_cast<const SemNodePostfixExpression &>(node);
+        const auto &array = *postfix.getLhs();
+
+        if ((postfix.getOperator() == "[]") && (array.getType() == SemNode::Type::Identifier) &&
+            (array.getAttachedNodes().empty() == false))
+        {
+            const auto &identifier = static_cast<const SemNodeIdentifier &>(array);
+            const std::string name = identifier.getName();
+            const auto arrayInfo = lookup(name);
+            if (arrayInfo.has_value())
+            {
+                accesses.push_back(
+                    Access{name, *arrayInfo, array.getAttachedNodes().back().get(), false, identifier.getPos()});
+            }
+        }
+
+        // the sizes past the first dimension are not kept, "j" of "a[i][j]"
+        // is only counted
+        const auto first = (array.getType() == SemNode::Type::PostfixExpression) ? getFirstSubscript(array) : nullptr;
+        if ((postfix.getOperator() == "[]") && (first != nullptr) && lookup(first->getName()).has_value())
+        {
+            mReport.mUnchecked++;
+        }
+    }
+}
+
+void WalkerBoundsCheck::checkAccesses(const SemNode &node, SemNode *statement)
+{
+    std::vector<Access> accesses;
+    collectAccesses(node, accesses);
+
+    Writes writes;
+    collectWrites(node, writes);
+
+    for (const auto &access : accesses)
+    {
+        checkAccess(access, statement, writes.mNames);
+    }
+}
+
+void WalkerBoundsCheck::checkAccess(const Access &access, SemNode *statement, const std::set<std::string> &written)
+{
+    const auto index = getIntegerValue(*access.mIndex);
+    const auto size = access.mArray.mSize;
+
+    if (index.has_value() && size.has_value())
+    {
+        if ((*index >= 0) && (*index < *size))
+        {
+            mReport.mProven++;
+            return;
+        }
+
+        log("ERROR: line %: index % is out of the range of '%' [0, %)",
+            Color::Red,
+            getLine(access.mPos),
+            *index,
+            access.mArrayName,
+            *size);
+        mReport.mOutOfRange++;
+        return;
+    }
+
+    // the check runs before the statement, the index can not depend on
+    // anything the statement changes, the access must always run
+    std::set<std::string> names;
+    collectNames(*access.mIndex, names);
+
+    bool indexChanged = false;
+    for (const auto &name : names)
+    {
+        indexChanged = indexChanged || (written.count(name) != 0);
+    }
+
+    const auto indexText = getExpressionText(*access.mIndex);
+    if ((statement == nullptr) || indexChanged || access.mConditional || (indexText.has_value() == false))
+    {
+        mReport.mUnchecked++;
+        return;
+    }
+
+    addCheck(*statement, "SAFEC_BOUNDS_CHECK(" + *indexText + ", " + access.mArray.mSizeText + ");");
+    mReport.mChecked++;
+}
+
+void WalkerBoundsCheck::addCheck(SemNode &statement, const std::string &code)
+{
+    const auto checks = mChecksIndex.find(&statement);
+    if (checks == mChecksIndex.end())
+    {
+        mChecksIndex.emplace(&statement, mChecks.size());
+        mChecks.push_back(Checks{&statement, {code}});
+        return;
+    }
+
+    // the same check before one statement is done once
+    auto &statementCode = mChecks[checks->second].mCode;
+    if (std::find(statementCode.begin(), statementCode.end(), code) == statementCode.end())
+    {
+        statementCode.push_back(code);
+    }
+}
+
+void WalkerBoundsCheck::insertChecks()
+{
+    for (const auto &checks : mChecks)
+    {
+        insertBeforeStatement(*mTranslationUnit, mSource, *checks.mStatement, checks.mCode);
+    }
+
+    auto definitions = std::make_shared<SemNodeGeneratedCode>(0U, kCheckDefinitions);
+    mTranslationUnit->insertChild(0, definitions);
+    mTranslationUnit->registerNode(definitions);
+}
+
+uint32_t WalkerBoundsCheck::getLine(const size_t pos) const
+{
+    const size_t end = std::min(pos, mSource.size());
+    return static_cast<uint32_t>(std::count(mSource.begin(), mSource.begin() + end, '\n')) + 1U;
+}
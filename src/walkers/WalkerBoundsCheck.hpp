@@ -0,0 +1,111 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace safec
+{
+
+// Checks the indexes of the ranged arrays (arrays with a known size).
+// A check is a SAFEC_BOUNDS_CHECK() statement placed before the statement
+// with the access. Accesses indexed by the induction variable of a simple
+// for loop are checked once before the loop instead, or not at all if the
+// range is known to be fine at transpile time.
+class WalkerBoundsCheck final
+{
+public:
+    // number of the array accesses by the way they were handled
+    struct Report
+    {
+        uint32_t mChecked = 0;    // checked before the statement
+        uint32_t mHoisted = 0;    // covered by a check before the loop
+        uint32_t mLoopChecks = 0; // checks placed before the loops
+        uint32_t mProven = 0;     // in range, known at transpile time
+        uint32_t mUnchecked = 0;  // no place for a check
+        uint32_t mOutOfRange = 0; // constant indexes out of the range, an error
+    };
+
+    WalkerBoundsCheck();
+
+    // false if a constant index is out of the range
+    bool commit(SemNodeTranslationUnit &translationUnit);
+
+    const Report &getReport() const;
+
+private:
+    struct ArrayInfo
+    {
+        std::string mSizeText;
+        std::optional<int64_t> mSize;
+    };
+
+    // nullopt for the names that are not ranged arrays, they hide the
+    // arrays with the same name from the outer scopes
+    using SymbolScope = std::map<std::string, std::optional<ArrayInfo>>;
+
+    struct Access
+    {
+        std::string mArrayName;
+        ArrayInfo mArray;
+        const SemNode *mIndex;
+        bool mConditional; // may not run, e.g. on the right of "&&"
+        uint32_t mPos;     // of the array name
+    };
+
+    // for (v = first; v < end; v++) with v not changed in the loop body
+    struct Induction
+    {
+        std::string mVariable;
+        std::string mFirstText;
+        std::string mEndText;
+        std::optional<int64_t> mFirst;
+        std::optional<int64_t> mEnd;
+    };
+
+    // checks to be placed before a statement
+    struct Checks
+    {
+        SemNode *mStatement;
+        std::vector<std::string> mCode;
+    };
+
+    SemNodeTranslationUnit *mTranslationUnit;
+    std::string mSource;
+    std::vector<SymbolScope> mSymbols;
+    std::set<std::string> mAddressTaken;       // in the current function
+    std::set<std::string> mGlobalAddressTaken; // anywhere in the file
+    std::vector<Checks> mChecks;
+    std::map<const SemNode *, size_t> mChecksIndex;
+    Report mReport;
+
+    void visitBlock(SemNode &block);
+    void visitStatement(SemNode &statement, const bool canInsert);
+    void visitIf(SemNode &ifNode, const bool canInsert);
+    void visitSwitch(SemNode &switchNode, const bool canInsert);
+    void visitLoop(SemNodeLoop &loop, const bool canInsert);
+    void visitLoopBody(SemNode &body, SemNodeLoop &loop, const Induction &induction);
+
+    void declare(const SemNode &statement);
+    std::optional<ArrayInfo> lookup(const std::string &name) const;
+    bool isGlobal(const std::string &name) const;
+
+    std::optional<Induction> findInduction(SemNodeLoop &loop) const;
+
+    // the indexes past the first dimension are counted as not checked
+    void collectAccesses(const SemNode &node, std::vector<Access> &accesses);
+    void checkAccesses(const SemNode &node, SemNode *statement);
+    void checkAccess(const Access &access, SemNode *statement, const std::set<std::string> &written);
+
+    void addCheck(SemNode &statement, const std::string &code);
+    void insertChecks();
+
+    uint32_t getLine(const size_t pos) const;
+};
+
+} // namespace safec
@@ -0,0 +1,272 @@
+#include "WalkerConstantFold.hpp"
+
+#include "SourceText.hpp"
+
+using namespace safec;
+using namespace safec::constants;
+using namespace safec::source;
+
+namespace
+{
+
+size_t skipBlankBackward(const std::string &text, size_t pos)
+{
+    while ((pos > 0) && isBlank(text[pos - 1]))
+    {
+        pos--;
+    }
+
+    return pos;
+}
+
+// "-1" is already a constant
+bool isLiteral(const SemNode &node)
+{
+    if (node.getType() != SemNode::Type::UnaryOp)
+    {
+        return false;
+    }
+
+    const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(node);
+    return ((unaryOp.getOp() == "-") || (unaryOp.getOp() == "+")) &&
+           (unaryOp.getRhs()->getType() == SemNode::Type::Constant);
+}
+
+// the folded value is written in hex if the expression used hex constants
+bool hasHexConstant(const SemNode &node)
+{
+    if (node.getType() == SemNode::Type::Constant)
+    {
+        const std::string name = static_cast<const SemNodeConstant &>(node).getName();
+        return (name.size() > 1) && (name[0] == '0') && ((name[1] == 'x') || (name[1] == 'X'));
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        if (hasHexConstant(*it))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint32_t countOperators(const SemNode &node)
+{
+    uint32_t count = 0;
+    if (node.getType() == SemNode::Type::UnaryOp)
+    {
+        count++;
+    }
+    else if (node.getType() == SemNode::Type::BinaryOp)
+    {
+        // the ":" is a part of the "?"
+        count += (static_cast<const SemNodeBinaryOp &>(node).getOp() != ":") ? 1U : 0U;
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        count += countOperators(*it);
+    }
+
+    return count;
+}
+
+} // namespace
+
+WalkerConstantFold::WalkerConstantFold()
+    : mTranslationUnit{nullptr}
+{
+}
+
+void WalkerConstantFold::commit(SemNodeTranslationUnit &translationUnit)
+{
+    mTranslationUnit = &translationUnit;
+    mSource = readSourceFile(translationUnit.getSourcePath());
+
+    auto &children = translationUnit.getAttachedNodes();
+    for (uint32_t i = 0; i < children.size(); i++)
+    {
+        visit(*children[i], false);
+    }
+}
+
+const WalkerConstantFold::Report &WalkerConstantFold::getReport() const
+{
+    return mReport;
+}
+
+void WalkerConstantFold::visit(SemNode &node, bool reported)
+{
+    // the removed, moved and deferred code is copied from the source as it is,
+    // the static assertions are already replaced (see WalkerStaticAssert)
+    const auto dirty = node.getDirty();
+    const auto type = node.getType();
+    if ((dirty == SemNode::DirtyType::Removed) || (dirty == SemNode::DirtyType::Added) || node.getIsShared() ||
+        (type == SemNode::Type::GeneratedCode) || (type == SemNode::Type::Defer) ||
+        (type == SemNode::Type::StaticAssert))
+    {
+        return;
+    }
+
+    if ((type == SemNode::Type::BinaryOp) || (type == SemNode::Type::UnaryOp))
+    {
+        std::string error;
+        const auto value = evaluate(node, error);
+        if (value.has_value() && (isLiteral(node) == false))
+        {
+            if ((fold(node, *value) == false) && (reported == false))
+            {
+                mReport.mUnfolded++;
+            }
+
+            return;
+        }
+
+        if ((error.empty() == false) && (reported == false))
+        {
+            mReport.mUnfolded++;
+            reported = true;
+        }
+    }
+
+    // a folded child is replaced in place
+    auto &children = node.getAttachedNodes();
+    for (uint32_t i = 0; i < children.size(); i++)
+    {
+        visit(*children[i], reported);
+    }
+}
+
+bool WalkerConstantFold::fold(SemNode &node, const Value &value)
+{
+    const auto span = getSpan(node, false);
+    if (span.has_value() == false)
+    {
+        return false;
+    }
+
+    const std::string text = toSource(value, hasHexConstant(node));
+
+    // keeps the range of a statement, if the expression is one
+    auto constant = std::make_shared<SemNodeConstant>(static_cast<uint32_t>(span->second), text);
+    constant->setSemStart(node.getSemStart());
+    constant->setSemEnd(node.getSemEnd());
+
+    // the code takes the place of the expression in the source
+    auto code = std::make_shared<SemNodeGeneratedCode>(static_cast<uint32_t>(span->first), text);
+    code->setSemStart(static_cast<uint32_t>(span->first));
+    code->setSemEnd(static_cast<uint32_t>(span->second));
+    code->setDirty(SemNode::DirtyType::Removed);
+    constant->attach(code);
+
+    mReport.mFolded++;
+    mReport.mOperators += countOperators(node);
+
+    node.getParent()->setDirty(SemNode::DirtyType::Modified);
+    node.replaceWith(constant);
+    mTranslationUnit->registerNode(constant);
+
+    return true;
+}
+
+std::optional<WalkerConstantFold::Span> WalkerConstantFold::getSpan(const SemNode &node, const bool isOperand) const
+{
+    std::optional<Span> span;
+
+    switch (node.getType())
+    {
+        case SemNode::Type::Constant:
+        {
+            // the position of a constant is the end of it
+            const auto &constant = static_cast<const SemNodeConstant &>(node);
+            const std::string name = constant.getName();
+            const size_t end = constant.getPos();
+            if ((end >= name.size()) && (end <= mSource.size()) &&
+                (mSource.compare(end - name.size(), name.size(), name) == 0))
+            {
+                span = Span{end - name.size(), end};
+            }
+            break;
+        }
+
+        case SemNode::Type::UnaryOp:
+        {
+            const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(node);
+            const std::string op = unaryOp.getOp();
+
+            const auto rhs = getSpan(*unaryOp.getRhs(), true);
+            if (rhs.has_value() == false)
+            {
+                break;
+            }
+
+            const size_t opEnd = skipBlankBackward(mSource, rhs->first);
+            if ((opEnd >= op.size()) && (mSource.compare(opEnd - op.size(), op.size(), op) == 0))
+            {
+                span = Span{opEnd - op.size(), rhs->second};
+            }
+            break;
+        }
+
+        case SemNode::Type::BinaryOp:
+        {
+            const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(node);
+            const std::string op = binaryOp.getOp();
+
+            const auto lhs = getSpan(*binaryOp.getLhs(), true);
+            const auto rhs = getSpan(*binaryOp.getRhs(), true);
+            if ((lhs.has_value() == false) || (rhs.has_value() == false))
+            {
+                break;
+            }
+
+            const size_t opStart = skipBlank(mSource, lhs->second);
+            if ((mSource.compare(opStart, op.size(), op) == 0) &&
+                (skipBlank(mSource, opStart + op.size()) == rhs->first))
+            {
+                span = Span{lhs->first, rhs->second};
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    if (span.has_value() == false)
+    {
+        return std::nullopt;
+    }
+
+    while (true)
+    {
+        const size_t open = skipBlankBackward(mSource, span->first);
+        const size_t close = skipBlank(mSource, span->second);
+        if ((open == 0) || (mSource[open - 1] != '(') || (close >= mSource.size()) || (mSource[close] != ')'))
+        {
+            break;
+        }
+
+        if (isOperand == false)
+        {
+            const size_t before = skipBlankBackward(mSource, open - 1);
+            if ((before > 0) &&
+                (isIdentifierChar(mSource[before - 1]) || (mSource[before - 1] == ')') || (mSource[before - 1] == ']')))
+            {
+                break;
+            }
+        }
+
+        span = Span{open - 1, close + 1};
+    }
+
+    // a preprocessor line in the expression would be dropped with it
+    if (mSource.find('#', span->first) < span->second)
+    {
+        return std::nullopt;
+    }
+
+    return span;
+}
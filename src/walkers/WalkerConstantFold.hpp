@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ConstantEvaluation.hpp"
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace safec
+{
+
+// Folds the integer constant expressions ("0x10 * 4", "-(3 - 5)") into a
+// single constant, in the AST and in the generated code, for the compilers
+// that do not fold them without optimizations. The values are the ones the
+// target would compute (see ConstantEvaluation), the expressions with values
+// not known here are left to the compiler.
+class WalkerConstantFold final
+{
+public:
+    struct Report
+    {
+        uint32_t mFolded = 0;    // expressions replaced with a constant
+        uint32_t mOperators = 0; // operators in the folded expressions
+        uint32_t mUnfolded = 0;  // constant expressions left to the compiler
+    };
+
+    WalkerConstantFold();
+
+    void commit(SemNodeTranslationUnit &translationUnit);
+
+    const Report &getReport() const;
+
+private:
+    // [start, end) in the source
+    using Span = std::pair<size_t, size_t>;
+
+    SemNodeTranslationUnit *mTranslationUnit;
+    std::string mSource;
+    Report mReport;
+
+    // reported - a constant expression around the node was already counted
+    void visit(SemNode &node, bool reported);
+    bool fold(SemNode &node, const constants::Value &value);
+
+    // the source of the expression, with the parentheses around it if they
+    // can not be a part of a call, a cast or a statement
+    std::optional<Span> getSpan(const SemNode &node, const bool isOperand) const;
+};
+
+} // namespace safec
@@ -0,0 +1,160 @@
+#include "WalkerDeadCode.hpp"
+
+#include "SourceText.hpp"
+
+#include <algorithm>
+
+using namespace safec;
+using namespace safec::source;
+
+namespace
+{
+
+bool isSkipped(const SemNode &node)
+{
+    return (node.getDirty() == SemNode::DirtyType::Removed) || //
+           (node.getDirty() == SemNode::DirtyType::Added) ||   //
+           (node.getType() == SemNode::Type::GeneratedCode);
+}
+
+// a case label of a switch outside of the node
+bool hasCaseLabel(const SemNode &node)
+{
+    if (node.getType() == SemNode::Type::SwitchCaseLabel)
+    {
+        return true;
+    }
+
+    // the labels of a nested switch belong to it
+    if (node.getType() == SemNode::Type::SwitchCase)
+    {
+        return false;
+    }
+
+    const auto &children = node.getAttachedNodes();
+    return std::any_of(children.begin(), children.end(), [](const auto &it) { return hasCaseLabel(*it); });
+}
+
+} // namespace
+
+void WalkerDeadCode::commit(SemNodeTranslationUnit &translationUnit)
+{
+    mSource = readSourceFile(translationUnit.getSourcePath());
+
+    visit(translationUnit);
+}
+
+const WalkerDeadCode::Report &WalkerDeadCode::getReport() const
+{
+    return mReport;
+}
+
+bool WalkerDeadCode::visit(SemNode &node)
+{
+    if (isSkipped(node))
+    {
+        return false;
+    }
+
+    switch (node.getType())
+    {
+        case SemNode::Type::Return:
+            return true;
+
+        case SemNode::Type::JumpStatement:
+        {
+            // a jump out of a loop or switch not in the AST can not be followed
+            const std::string name = static_cast<const SemNodeJumpStatement &>(node).getName();
+            return ((name == "break") && ((mLoops + mSwitches) > 0)) || ((name == "continue") && (mLoops > 0));
+        }
+
+        case SemNode::Type::Scope:
+        case SemNode::Type::SwitchCaseLabel:
+            return visitSequence(node);
+
+        default:
+            break;
+    }
+
+    const uint32_t isLoop = (node.getType() == SemNode::Type::Loop) ? 1U : 0U;
+    const uint32_t isSwitch = (node.getType() == SemNode::Type::SwitchCase) ? 1U : 0U;
+    mLoops += isLoop;
+    mSwitches += isSwitch;
+
+    // the other statements (if, loops, switch) can end in any of their parts
+    for (const auto &it : node.getAttachedNodes())
+    {
+        visit(*it);
+    }
+
+    mLoops -= isLoop;
+    mSwitches -= isSwitch;
+
+    return false;
+}
+
+bool WalkerDeadCode::visitSequence(SemNode &node)
+{
+    bool leaves = false;
+    bool tailStarted = false;
+    for (const auto &it : node.getAttachedNodes())
+    {
+        SemNode &statement = *it;
+        if (isSkipped(statement))
+        {
+            continue;
+        }
+
+        if (leaves)
+        {
+            if (isEntry(statement))
+            {
+                leaves = false;
+            }
+            else
+            {
+                if (tailStarted == false)
+                {
+                    mReport.mTails.push_back(Tail{getLine(skipBlank(mSource, statement.getSemStart())), 0});
+                    tailStarted = true;
+                }
+
+                mReport.mTails.back().mStatements++;
+                mReport.mRemoved++;
+
+                statement.setDirty(SemNode::DirtyType::Removed);
+                node.setDirty(SemNode::DirtyType::Modified);
+                continue;
+            }
+        }
+
+        leaves = visit(statement);
+        tailStarted = false;
+    }
+
+    return leaves;
+}
+
+bool WalkerDeadCode::isEntry(const SemNode &node)
+{
+    // the reachable code after a switch case is not counted
+    if (hasCaseLabel(node))
+    {
+        return true;
+    }
+
+    const auto text = getNodeSource(mSource, node);
+    if ((findLabel(text) != std::string_view::npos) || hasPreprocessorLine(text))
+    {
+        mReport.mKept++;
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t WalkerDeadCode::getLine(const size_t pos) const
+{
+    const size_t end = std::min(pos, mSource.size());
+    return static_cast<uint32_t>(std::count(mSource.begin(), mSource.begin() + end, '\n')) + 1U;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace safec
+{
+
+// Removes the statements that can not be reached, the ones following a
+// return, break or continue in the same block (also in a nested block or
+// a case that always leaves). A statement with a label or a case label
+// can be jumped to and is kept, and so is everything after it. The source
+// is not preprocessed, so a statement with a preprocessor line in its
+// source ends the unreachable part as well - the exit can be conditional.
+class WalkerDeadCode final
+{
+public:
+    // the unreachable statements following one exit
+    struct Tail
+    {
+        uint32_t mLine;
+        uint32_t mStatements;
+    };
+
+    struct Report
+    {
+        uint32_t mRemoved = 0; // statements removed
+        uint32_t mKept = 0;    // unreachable parts ended early, see above
+        std::vector<Tail> mTails;
+    };
+
+    void commit(SemNodeTranslationUnit &translationUnit);
+
+    const Report &getReport() const;
+
+private:
+    std::string mSource;
+    Report mReport;
+    uint32_t mLoops = 0;    // around the visited node
+    uint32_t mSwitches = 0; // around the visited node
+
+    // true if the end of the node can not be reached from its start
+    bool visit(SemNode &node);
+    bool visitSequence(SemNode &node);
+
+    // the node can be entered by a jump from outside of it
+    bool isEntry(const SemNode &node);
+
+    uint32_t getLine(const size_t pos) const;
+};
+
+} // namespace safec
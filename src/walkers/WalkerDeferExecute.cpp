@@ -1,256 +1,847 @@
 #include "WalkerDeferExecute.hpp"
 
-#include "SemNodeWalker.hpp"
-#include "WalkerFindById.hpp"
-#include "WalkerStrategy.hpp"
+#include "NodeQueries.hpp"
+#include "SourceText.hpp"
 #include "logger/Logger.hpp"
 #include "utils/Utils.hpp"
 
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <tuple>
+
 using namespace safec;
+using namespace safec::source;
 
 namespace
 {
 
-[[maybe_unused]] SemNode &findNodeById(SemNode &haystack, const uint32_t id)
+// names used in the generated C code
+constexpr std::string_view kExitVariable = "safec_defer_exit";
+constexpr std::string_view kReturnVariable = "safec_defer_ret";
+constexpr std::string_view kLabelPrefix = "safec_defer_";
+constexpr std::string_view kTailLabelPrefix = "safec_defer_tail_";
+
+SemNode &findNodeById(SemNodeTranslationUnit &translationUnit, const uint32_t id)
 {
-    WalkerFindById finder{id};
-    SemNodeWalker walker;
+    // ids are dense per translation unit, no need to walk the AST
+    auto node = translationUnit.getNodeById(id);
 
-    // TODO: instead of SemNodeWalker could write something like
-    //       SemNodeWalkerParallel to search the AST faster...
+    assert(node != nullptr);
+    return *node;
+}
 
-    walker.walk(haystack, finder);
+SemNodeFunction *findFunction(SemNode &node)
+{
+    for (SemNode *it = &node; it != nullptr; it = it->getParent())
+    {
+        if (it->getType() == SemNode::Type::Function)
+        {
+            return static_cast<SemNodeFunction *>(it);
+        }
+    }
 
-    assert(finder.getResult() != nullptr);
-    return *finder.getResult();
+    return nullptr;
 }
 
-} // namespace
-
-WalkerDeferExecute::WalkerDeferExecute()
-    : mAstLevelOfScopePrev{0}
+// Statement source split around its keyword, e.g. for "\n  return x + 1;":
+// leading "\n  " and operand "x + 1". The labels of the statement are
+// leading too.
+struct StatementText
 {
-}
+    std::string_view mLeading;
+    std::string_view mOperand;
+};
 
-void WalkerDeferExecute::peek(SemNode &node, const uint32_t astLevel)
+std::optional<StatementText> splitStatement(const std::string_view statement, const std::string_view keyword)
 {
-    scopeRemoveIfLeftScope(astLevel);
+    size_t keywordPos = skipBlank(statement, 0);
+    while (statement.compare(keywordPos, keyword.size(), keyword) != 0)
+    {
+        size_t labelEnd = keywordPos;
+        while ((labelEnd < statement.size()) && isIdentifierChar(statement[labelEnd]))
+        {
+            labelEnd++;
+        }
+
+        const size_t colon = skipBlank(statement, labelEnd);
+        if ((labelEnd == keywordPos) || (colon >= statement.size()) || (statement[colon] != ':'))
+        {
+            break;
+        }
+
+        keywordPos = skipBlank(statement, colon + 1);
+    }
+
+    const size_t operandPos = keywordPos + keyword.size();
+
+    if ((statement.compare(keywordPos, keyword.size(), keyword) != 0) || //
+        ((operandPos < statement.size()) && isIdentifierChar(statement[operandPos])))
+    {
+        return std::nullopt;
+    }
+
+    // the ';' is in the range of some statements only
+    std::string_view operand = trim(statement.substr(operandPos));
+    while ((operand.empty() == false) && (operand.back() == ';'))
+    {
+        operand.remove_suffix(1);
+        operand = trim(operand);
+    }
+
+    return StatementText{statement.substr(0, keywordPos), operand};
 }
 
-void WalkerDeferExecute::peek(SemNodeDefer &node, const uint32_t astLevel)
+// The return type spelled in the function header, without the storage
+// class (the one in SemNodeFunction does not keep all qualifiers).
+std::string getReturnType(const std::string &source, const SemNodeFunction &function)
 {
-    scopeRemoveIfLeftScope(astLevel);
+    const std::string_view header = std::string_view{source}.substr(0, function.getStart());
+    const std::string name = function.getName();
+
+    size_t namePos = header.find(name, function.getSemStart());
+    while (namePos != std::string_view::npos)
+    {
+        const bool nameStartOk = (namePos == 0) || (isIdentifierChar(header[namePos - 1]) == false);
+        const size_t afterName = skipBlank(header, namePos + name.size());
+        if (nameStartOk && (afterName < header.size()) && (header[afterName] == '('))
+        {
+            break;
+        }
+
+        namePos = header.find(name, namePos + 1);
+    }
 
-    deferArm(node, astLevel);
+    if (namePos == std::string_view::npos)
+    {
+        return function.getReturn();
+    }
 
-    // fire the defer in current scope
+    std::string returnType;
+    for (size_t pos = skipBlank(header, function.getSemStart()); pos < namePos; pos = skipBlank(header, pos))
+    {
+        size_t tokenEnd = pos + 1;
+        while ((tokenEnd < namePos) && isIdentifierChar(header[pos]) && isIdentifierChar(header[tokenEnd]))
+        {
+            tokenEnd++;
+        }
 
-    auto currentScope = scopeGetCurrent();
-    assert(currentScope != nullptr);
+        const std::string_view token = header.substr(pos, tokenEnd - pos);
+        pos = tokenEnd;
 
-    DeferApplyInfo deferApply;
-    deferApply.mDeferNodeId = node.getId();
-    deferApply.mDeferOwnerScopeId = scopeGetCurrent()->getId();
-    deferApply.mScopeToAttachDeferId = scopeGetCurrent()->getId();
-    deferApply.mNodeToPrefixWithDeferId = -1;
-    mDeferApplyInfo.push_back(deferApply);
+        if ((token == "static") || (token == "extern") || (token == "inline"))
+        {
+            continue;
+        }
+
+        if ((returnType.empty() == false) && isIdentifierChar(returnType.back()))
+        {
+            returnType += ' ';
+        }
+
+        returnType += token;
+    }
+
+    return returnType.empty() ? std::string{"int"} : returnType;
 }
 
-void WalkerDeferExecute::peek(SemNodeReturn &node, const uint32_t astLevel)
+uint32_t getLine(const std::string &source, const size_t pos)
 {
-    scopeRemoveIfLeftScope(astLevel);
+    const size_t end = std::min(pos, source.size());
+    return static_cast<uint32_t>(std::count(source.begin(), source.begin() + end, '\n')) + 1U;
+}
 
-    // TODO: fire ALL ARMED (return) defers before current node
+std::string getLabel(const uint32_t deferNodeId)
+{
+    return std::string{kLabelPrefix} + std::to_string(deferNodeId);
 }
 
-void WalkerDeferExecute::peek(SemNodeJumpStatement &node, const uint32_t astLevel)
+// code to be placed just before pos, one line per entry if pos
+// starts a line, otherwise all in the line
+std::string formatLines(const std::string &source, const uint32_t pos, const std::vector<std::string> &lines)
 {
-    scopeRemoveIfLeftScope(astLevel);
+    std::string code;
 
-    // TODO: fire armed defers from current scope
+    const auto indent = getLineIndent(source, pos);
+    for (const auto &it : lines)
+    {
+        if (indent.has_value())
+        {
+            code += "    " + it + "\n" + *indent;
+        }
+        else
+        {
+            code += " " + it;
+        }
+    }
+
+    if (indent.has_value() == false)
+    {
+        code += " ";
+    }
+
+    return code;
 }
 
-void WalkerDeferExecute::peek(SemNodeScope &node, const uint32_t astLevel)
+// the statement of a defer, terminated
+std::string getDeferredCode(const std::string &source, const SemNode &deferNode)
 {
-    scopeRemoveIfLeftScope(astLevel);
-    mAstLevelOfScopePrev = astLevel;
+    const auto deferStatement = splitStatement(getNodeSource(source, deferNode), "defer");
+    assert(deferStatement.has_value());
+
+    std::string deferredCode{deferStatement->mOperand};
+    if ((deferredCode.empty() == false) && (deferredCode.back() != '}'))
+    {
+        deferredCode += ";";
+    }
 
-    scopeAdd(node);
+    return deferredCode;
 }
 
-void WalkerDeferExecute::peek(SemNodeFunction &node, const uint32_t astLevel)
+// true if the last statement of the scope always leaves it
+bool endsWithExit(const SemNode &scope)
 {
-    mDefersArmed.clear(); // since this is a new function clear all previous defers
-    mScopes.clear();      // remove all scopes
+    const auto &attachedNodes = scope.getAttachedNodes();
+    for (auto it = attachedNodes.rbegin(); it != attachedNodes.rend(); it++)
+    {
+        const auto type = (*it)->getType();
+        if ((type == SemNode::Type::Defer) || ((*it)->getDirty() == SemNode::DirtyType::Removed))
+        {
+            continue;
+        }
+
+        return (type == SemNode::Type::Return) || (type == SemNode::Type::JumpStatement);
+    }
 
-    scopeRemoveIfLeftScope(astLevel);
-    mAstLevelOfScopePrev = astLevel;
+    return false;
+}
 
-    scopeAdd(node);
+// the code takes the place of the removed node
+void replaceWithCode(SemNodeTranslationUnit &translationUnit, SemNode &node, const std::string &code)
+{
+    auto generatedCode = std::make_shared<SemNodeGeneratedCode>(node.getSemStart(), code);
+    node.getParent()->setDirty(SemNode::DirtyType::Modified);
+    node.setDirty(SemNode::DirtyType::Removed);
+    node.insertAfter(generatedCode);
+    translationUnit.registerNode(generatedCode);
 }
 
-void WalkerDeferExecute::peek(SemNodeLoop &node, const uint32_t astLevel)
+// C89 - the variables are declared at the start of the function body
+void declareAtFunctionStart( //
+    SemNodeTranslationUnit &translationUnit,
+    const std::string &source,
+    SemNodeFunction &function,
+    const std::vector<std::string> &declarations)
 {
-    scopeRemoveIfLeftScope(astLevel);
-    mAstLevelOfScopePrev = astLevel;
+    SemNodeScope *body = nullptr;
+    for (const auto &it : function.getAttachedNodes())
+    {
+        if (it->getType() == SemNode::Type::Scope)
+        {
+            body = static_cast<SemNodeScope *>(it.get());
+            break;
+        }
+    }
+
+    assert(body != nullptr);
+
+    const std::string indent = getLineIndent(source, body->getEnd() - 1U).value_or("") + "    ";
 
-    scopeAdd(node);
+    std::string code;
+    for (const auto &it : declarations)
+    {
+        code += "\n" + indent + it;
+    }
+
+    auto generatedCode = std::make_shared<SemNodeGeneratedCode>(body->getStart(), code);
+    body->setDirty(SemNode::DirtyType::Modified);
+    body->insertChild(0, generatedCode);
+    translationUnit.registerNode(generatedCode);
 }
 
-void WalkerDeferExecute::peek(SemNodeIf &node, const uint32_t astLevel)
+// the names declared before pos in the blocks from the scope up to the
+// owner scope (not in it)
+std::set<std::string> getDeclaredNames(const SemNode &scope, const uint32_t pos, const uint32_t ownerScopeId)
 {
-    scopeRemoveIfLeftScope(astLevel);
-    mAstLevelOfScopePrev = astLevel;
+    std::set<std::string> names;
+    for (const SemNode *it = &scope; (it != nullptr) && (it->getId() != ownerScopeId); it = it->getParent())
+    {
+        if (it->getType() != SemNode::Type::Scope)
+        {
+            continue;
+        }
 
-    scopeAdd(node);
+        for (const auto &child : it->getAttachedNodes())
+        {
+            const auto declaration = nodes::getDeclaration(*child);
+            if ((declaration != nullptr) && (child->getSemStart() < pos))
+            {
+                names.insert(declaration->getLhsIdentifier());
+            }
+        }
+    }
+
+    return names;
 }
 
-void WalkerDeferExecute::peek(SemNodeSwitchCaseLabel &node, const uint32_t astLevel)
+// break/continue or goto with its label
+std::string getJumpCode(const std::string_view keyword, const StatementText &statement)
 {
-    scopeRemoveIfLeftScope(astLevel);
-    mAstLevelOfScopePrev = astLevel;
+    std::string code{keyword};
+    if (statement.mOperand.empty() == false)
+    {
+        code += " " + std::string{statement.mOperand};
+    }
+
+    return code + ";";
+}
 
-    scopeAdd(node);
+std::string getReturnDeclaration(const std::string &source, const SemNodeFunction &function)
+{
+    return getReturnType(source, function) + " " + std::string{kReturnVariable} + ";";
 }
 
-void WalkerDeferExecute::peek(SemNodeTranslationUnit &node, const uint32_t astLevel)
+} // namespace
+
+WalkerDeferExecute::WalkerDeferExecute(const DeferLowering lowering)
+    : mLowering{lowering}
+    , mTranslationUnit{nullptr}
+    , mAnalysis{nullptr}
+    , mErrors{0}
 {
-    mTranslationUnit = &node;
 }
 
-void WalkerDeferExecute::commit()
+bool WalkerDeferExecute::commit(SemNodeTranslationUnit &translationUnit, const DeferAnalysis &analysis)
 {
-    scopeRemoveIfLeftScope(0);
+    mTranslationUnit = &translationUnit;
+    mAnalysis = &analysis;
 
-    // apply all deferred changes (in reverse order)
-    // defer a; defer b; defer c; --should result in--> c; b; a;
-    for (auto itReverse = mDeferApplyInfo.rbegin(); itReverse != mDeferApplyInfo.rend(); itReverse++)
+    if (mLowering == DeferLowering::Goto)
+    {
+        commitGoto();
+    }
+    else
     {
-        auto &it = *itReverse;
-        auto &deferNode = findNodeById(*mTranslationUnit, it.mDeferNodeId);
+        commitInline();
+    }
+
+    removeDefers();
 
-        auto &deferAttachedNodes = deferNode.getAttachedNodes();
-        assert(deferAttachedNodes.size() > 0);
+    return (mErrors == 0);
+}
 
-        auto deferredOperation = deferAttachedNodes[0];
+void WalkerDeferExecute::commitInline()
+{
+    bool hasExits = false;
 
-        auto &scopeToAttachDefer = findNodeById(*mTranslationUnit, it.mScopeToAttachDeferId);
+    for (const auto &function : mAnalysis->getFunctions())
+    {
+        // apply all deferred changes (in reverse order)
+        // defer a; defer b; defer c; --should result in--> c; b; a;
+        for (auto itReverse = function.mDefers.rbegin(); itReverse != function.mDefers.rend(); itReverse++)
+        {
+            // the copy after the final return/break/continue would never
+            // run, the exit runs the defers by itself
+            const auto &deferOwnerScope = findNodeById(*mTranslationUnit, itReverse->mOwnerScopeId);
+            if (itReverse->mHasState && endsWithExit(deferOwnerScope))
+            {
+                continue;
+            }
+
+            attachDeferClone(*itReverse);
+        }
 
-        auto deferredOperationClone = deferredOperation->clone();
-        deferredOperationClone->setDirty(SemNode::DirtyType::Added);
-        scopeToAttachDefer.attach(deferredOperationClone);
+        hasExits = hasExits || (function.mExits.empty() == false);
     }
 
-    // remove the defer nodes from AST
-    for (auto &it : mDeferApplyInfo)
+    if (hasExits == false)
     {
-        auto &deferOwnerScope = findNodeById(*mTranslationUnit, it.mDeferOwnerScopeId);
+        return;
+    }
+
+    const std::string source = readSourceFile(mTranslationUnit->getSourcePath());
+
+    // Exits running the same defers and jumping to the same place share
+    // one copy of the defers (a tail) - the first exit gets it, the
+    // others jump into it. The code grows with the distinct defer sets
+    // and not with the number of exits. An exit in a block declaring a
+    // name used by the defers would run them with the other variable,
+    // it jumps to a tail at the end of the scope with the last armed
+    // defer instead: "if (0) { label: defers; exit }".
+    using TailKey = std::tuple<ExitKind, uint32_t, uint32_t, std::string>;
 
-        auto &ownerScopeAttachedNodes = deferOwnerScope.getAttachedNodes();
-        auto ownerScopeNodeIt = ownerScopeAttachedNodes.begin();
-        while (ownerScopeNodeIt != ownerScopeAttachedNodes.end())
+    const auto &deferStates = mAnalysis->getDeferStates();
+
+    for (const auto &function : mAnalysis->getFunctions())
+    {
+        // the states are unique in the translation unit, the tails do
+        // not need to be keyed by the function
+        std::vector<bool> hidden;
+        std::map<TailKey, uint32_t> tailExitCounts;
+        for (const auto &exit : function.mExits)
         {
-            auto &nodeIt = *ownerScopeNodeIt;
-            auto &deferredNode = findNodeById(*mTranslationUnit, it.mDeferNodeId);
-            if (nodeIt->getId() == deferredNode.getId())
+            const auto &exitNode = findNodeById(*mTranslationUnit, exit.mExitNodeId);
+            hidden.push_back(isHidden(*exitNode.getParent(), exitNode.getSemStart(), exit));
+            if (hidden.back() == false)
             {
-                deferredNode.setDirty(SemNode::DirtyType::Removed);
-                deferOwnerScope.setDirty(SemNode::DirtyType::Modified);
-                // ownerScopeNodeIt = ownerScopeAttachedNodes.erase(ownerScopeNodeIt);
-                break;
+                tailExitCounts[TailKey{exit.mKind, exit.mState, exit.mTargetState, exit.mLabel}]++;
+            }
+        }
+
+        std::map<TailKey, std::string> tailLabels;
+        std::map<TailKey, std::string> scopeTailLabels;
+        bool returnsValue = false;
+
+        for (size_t exitIndex = 0; exitIndex < function.mExits.size(); exitIndex++)
+        {
+            const auto &exit = function.mExits[exitIndex];
+            auto &exitNode = findNodeById(*mTranslationUnit, exit.mExitNodeId);
+
+            const std::string_view keyword = DeferAnalysis::getExitKeyword(exit.mKind);
+            const auto statement = splitStatement(getNodeSource(source, exitNode), keyword);
+            if (statement.has_value() == false)
+            {
+                log("ERROR: line %: can't lower the '%' with defer",
+                    Color::Red,
+                    getLine(source, skipBlank(source, exitNode.getSemStart())),
+                    keyword);
+                mErrors++;
+                continue;
+            }
+
+            // the return value is computed before the defers are run
+            const bool exitReturnsValue =
+                (exit.mKind == ExitKind::Return) && (statement->mOperand.empty() == false);
+
+            std::string code{statement->mLeading};
+            code += "{ ";
+            if (exitReturnsValue)
+            {
+                code += std::string{kReturnVariable} + " = " + std::string{statement->mOperand} + "; ";
+                returnsValue = true;
+            }
+
+            const TailKey tailKey{exit.mKind, exit.mState, exit.mTargetState, exit.mLabel};
+
+            std::string exitCode;
+            if (exitReturnsValue)
+            {
+                exitCode = "return " + std::string{kReturnVariable} + ";";
             }
             else
             {
-                ownerScopeNodeIt++;
+                exitCode = getJumpCode(keyword, *statement);
             }
+
+            if (hidden[exitIndex])
+            {
+                auto &scope = static_cast<SemNodeScope &>( //
+                    findNodeById(*mTranslationUnit, deferStates[exit.mState].mOwnerScopeId));
+
+                // the names of the outer defers can be declared in the scope as well
+                const uint32_t closingBracePos = scope.getEnd() - 1U;
+                if (isHidden(scope, closingBracePos, exit) || (closingBracePos >= source.size()) ||
+                    (source[closingBracePos] != '}'))
+                {
+                    log("ERROR: line %: a name used by the defers of the '%' is hidden by a declaration, use "
+                        "--defer-lowering=goto",
+                        Color::Red,
+                        getLine(source, skipBlank(source, exitNode.getSemStart())),
+                        keyword);
+                    mErrors++;
+                    continue;
+                }
+
+                auto scopeTailLabel = scopeTailLabels.find(tailKey);
+                if (scopeTailLabel == scopeTailLabels.end())
+                {
+                    const std::string label = std::string{kTailLabelPrefix} + std::to_string(exitNode.getId());
+                    scopeTailLabel = scopeTailLabels.emplace(tailKey, label).first;
+
+                    const std::string tail =
+                        "if (0) { " + label + ": " + getExitDefersCode(source, exit) + exitCode + " }";
+                    auto generatedCode = std::make_shared<SemNodeGeneratedCode>( //
+                        closingBracePos,
+                        formatLines(source, closingBracePos, {tail}));
+                    scope.setDirty(SemNode::DirtyType::Modified);
+                    scope.attach(generatedCode);
+                    mTranslationUnit->registerNode(generatedCode);
+                }
+
+                code += "goto " + scopeTailLabel->second + "; }";
+                replaceWithCode(*mTranslationUnit, exitNode, code);
+                continue;
+            }
+
+            const auto tailLabel = tailLabels.find(tailKey);
+            if (tailLabel != tailLabels.end())
+            {
+                code += "goto " + tailLabel->second + "; }";
+                replaceWithCode(*mTranslationUnit, exitNode, code);
+                continue;
+            }
+
+            if (tailExitCounts[tailKey] > 1)
+            {
+                const std::string label = std::string{kTailLabelPrefix} + std::to_string(exitNode.getId());
+                tailLabels.emplace(tailKey, label);
+                code += label + ": ";
+            }
+
+            code += getExitDefersCode(source, exit) + exitCode + " }";
+
+            replaceWithCode(*mTranslationUnit, exitNode, code);
+        }
+
+        if (returnsValue)
+        {
+            auto &functionNode = static_cast<SemNodeFunction &>(findNodeById(*mTranslationUnit, function.mFunctionId));
+            declareAtFunctionStart( //
+                *mTranslationUnit,
+                source,
+                functionNode,
+                {getReturnDeclaration(source, functionNode)});
         }
     }
 }
 
-WalkerDeferExecute::AstLevelEvent WalkerDeferExecute::getAstLevelEvent(const uint32_t currentAstLevel)
+void WalkerDeferExecute::commitGoto()
 {
-    if (currentAstLevel == mAstLevelOfScopePrev)
+    // a defer outside of a braced scope is the whole body of an if or a
+    // loop, there is no exit to handle - just copy it like when inlining
+    for (const auto &function : mAnalysis->getFunctions())
     {
-        return AstLevelEvent::Same;
+        for (auto itReverse = function.mDefers.rbegin(); itReverse != function.mDefers.rend(); itReverse++)
+        {
+            if (itReverse->mHasState == false)
+            {
+                attachDeferClone(*itReverse);
+            }
+        }
     }
-    else if (currentAstLevel > mAstLevelOfScopePrev)
+
+    const auto &deferStates = mAnalysis->getDeferStates();
+    if (deferStates.empty())
     {
-        return AstLevelEvent::Enter;
+        return;
     }
-    else
+
+    const std::string source = readSourceFile(mTranslationUnit->getSourcePath());
+
+    // the cleanup block at the end of a scope, the armed defers in reverse
+    // order, each labeled if some exit jumps to it, then the dispatch of
+    // the exits that leave the scope
+    struct ScopeCleanup
     {
-        return AstLevelEvent::Exit;
+        std::vector<uint32_t> mStates;
+        bool mExitKinds[4] = {false, false, false, false}; // by ExitKind
+        uint32_t mBreakTargetState = kNoState;
+        uint32_t mContinueTargetState = kNoState;
+    };
+
+    std::map<uint32_t, ScopeCleanup> cleanups;
+    for (uint32_t state = 0; state < deferStates.size(); state++)
+    {
+        cleanups[deferStates[state].mOwnerScopeId].mStates.push_back(state);
     }
-}
 
-void WalkerDeferExecute::scopeAdd(SemNode &node)
-{
-    mScopes.push_back(&node);
-}
+    // per function, the generated variables are only declared when used
+    struct FunctionLowering
+    {
+        bool mReturnsValue = false;
+        bool mExitVariableRead = false;
+    };
 
-SemNode *WalkerDeferExecute::scopeGetCurrent() const
-{
-    if (mScopes.size() == 0)
+    struct ExitLowering
     {
-        log("ERROR: scopeGetCurrent() called, but zero scopes", Color::Red);
-        return nullptr;
+        const DeferAnalysis::Exit *mExit;
+        uint32_t mFunctionId;
+        SemNode *mExitNode;
+        StatementText mStatement;
+    };
+
+    std::vector<bool> labelUsed(deferStates.size(), false);
+    std::map<uint32_t, FunctionLowering> functions;
+    std::vector<ExitLowering> exits;
+
+    for (const auto &functionDefers : mAnalysis->getFunctions())
+    {
+        for (const auto &exit : functionDefers.mExits)
+        {
+            auto &exitNode = findNodeById(*mTranslationUnit, exit.mExitNodeId);
+
+            const std::string_view keyword = DeferAnalysis::getExitKeyword(exit.mKind);
+            const auto statement = splitStatement(getNodeSource(source, exitNode), keyword);
+            if (statement.has_value() == false)
+            {
+                log("ERROR: line %: can't lower the '%' with defer",
+                    Color::Red,
+                    getLine(source, skipBlank(source, exitNode.getSemStart())),
+                    keyword);
+                mErrors++;
+                continue;
+            }
+
+            // the label of a goto can be between the defers of a cleanup
+            // block, the goto runs its own copy of the defers
+            if (exit.mKind == ExitKind::Goto)
+            {
+                const std::string code = std::string{statement->mLeading} + "{ " +
+                                         getExitDefersCode(source, exit) + getJumpCode(keyword, *statement) + " }";
+                replaceWithCode(*mTranslationUnit, exitNode, code);
+                continue;
+            }
+
+            auto &function = functions[functionDefers.mFunctionId];
+            if ((exit.mKind == ExitKind::Return) && (statement->mOperand.empty() == false))
+            {
+                function.mReturnsValue = true;
+            }
+
+            labelUsed[exit.mState] = true;
+
+            for (uint32_t state = exit.mState; state != exit.mTargetState; state = deferStates[state].mParent)
+            {
+                assert(state != kNoState);
+
+                auto &cleanup = cleanups[deferStates[state].mOwnerScopeId];
+                cleanup.mExitKinds[static_cast<uint32_t>(exit.mKind)] = true;
+
+                if (exit.mKind == ExitKind::Break)
+                {
+                    cleanup.mBreakTargetState = exit.mTargetState;
+                }
+                else if (exit.mKind == ExitKind::Continue)
+                {
+                    cleanup.mContinueTargetState = exit.mTargetState;
+                }
+            }
+
+            exits.push_back(ExitLowering{&exit, functionDefers.mFunctionId, &exitNode, *statement});
+        }
     }
 
-    return mScopes.back();
-}
+    // after the cleanup of a scope an exit continues with the cleanup of
+    // the outer scope, until all defers up to the exit target were run
+    std::map<uint32_t, std::vector<std::string>> dispatches;
+    for (auto &[scopeId, cleanup] : cleanups)
+    {
+        auto &scope = findNodeById(*mTranslationUnit, scopeId);
+        auto &dispatch = dispatches[scopeId];
 
-void WalkerDeferExecute::scopeRemove()
-{
-    if (mScopes.size() == 0)
+        auto *functionNode = findFunction(scope);
+        assert(functionNode != nullptr);
+
+        auto &function = functions[functionNode->getId()];
+        const uint32_t nextState = deferStates[cleanup.mStates.front()].mParent;
+
+        const auto addDispatch = [&](const ExitKind kind, const std::string &action) {
+            dispatch.push_back( //
+                "if (" + std::string{kExitVariable} + " == " + std::to_string(static_cast<uint32_t>(kind)) + ") " +
+                action);
+            function.mExitVariableRead = true;
+        };
+
+        const auto gotoNext = [&]() {
+            labelUsed[nextState] = true;
+            return "goto " + getLabel(deferStates[nextState].mDeferNodeId) + ";";
+        };
+
+        if (cleanup.mExitKinds[static_cast<uint32_t>(ExitKind::Return)])
+        {
+            const std::string returnStatement = //
+                function.mReturnsValue ? ("return " + std::string{kReturnVariable} + ";") : std::string{"return;"};
+
+            if (nextState != kNoState)
+            {
+                addDispatch(ExitKind::Return, gotoNext());
+            }
+            else if (scope.getParent() != functionNode)
+            {
+                addDispatch(ExitKind::Return, returnStatement);
+            }
+            else if (function.mReturnsValue)
+            {
+                // end of the function, only an exit or a missing return gets here
+                dispatch.push_back(returnStatement);
+            }
+        }
+
+        if (cleanup.mExitKinds[static_cast<uint32_t>(ExitKind::Break)])
+        {
+            addDispatch( //
+                ExitKind::Break,
+                (nextState != cleanup.mBreakTargetState)
+                    ? gotoNext()
+                    : ("{ " + std::string{kExitVariable} + " = 0; break; }"));
+        }
+
+        if (cleanup.mExitKinds[static_cast<uint32_t>(ExitKind::Continue)])
+        {
+            addDispatch( //
+                ExitKind::Continue,
+                (nextState != cleanup.mContinueTargetState)
+                    ? gotoNext()
+                    : ("{ " + std::string{kExitVariable} + " = 0; continue; }"));
+        }
+    }
+
+    // each exit is replaced with a jump to the cleanup of the last armed
+    // defer, the return value is computed before the defers are run
+    for (const auto &it : exits)
     {
-        return;
+        const auto &function = functions[it.mFunctionId];
+
+        std::string code{it.mStatement.mLeading};
+        code += "{ ";
+        if ((it.mExit->mKind == ExitKind::Return) && (it.mStatement.mOperand.empty() == false))
+        {
+            code += std::string{kReturnVariable} + " = " + std::string{it.mStatement.mOperand} + "; ";
+        }
+
+        if (function.mExitVariableRead)
+        {
+            code += std::string{kExitVariable} + " = " + std::to_string(static_cast<uint32_t>(it.mExit->mKind)) + "; ";
+        }
+
+        code += "goto " + getLabel(deferStates[it.mExit->mState].mDeferNodeId) + "; }";
+
+        replaceWithCode(*mTranslationUnit, *it.mExitNode, code);
     }
 
-    // remove all defers from the scope that we're leaving
-    for (auto it = mDefersArmed.begin(); it != mDefersArmed.end(); /*empty*/)
+    for (auto &[scopeId, cleanup] : cleanups)
     {
-        if (it->mAstLevel >= mAstLevelOfScopePrev)
+        auto &scope = static_cast<SemNodeScope &>(findNodeById(*mTranslationUnit, scopeId));
+
+        // the scope end is just after the closing brace
+        const uint32_t closingBracePos = scope.getEnd() - 1U;
+        if ((scope.getEnd() == 0) || (closingBracePos >= source.size()) || (source[closingBracePos] != '}'))
         {
-            it = mDefersArmed.erase(it);
+            log("ERROR: line %: no closing brace for the defer cleanup", Color::Red, getLine(source, scope.getEnd()));
+            mErrors++;
+            continue;
         }
-        else
+
+        std::vector<std::string> lines;
+        for (auto it = cleanup.mStates.rbegin(); it != cleanup.mStates.rend(); it++)
+        {
+            const auto &deferNode = findNodeById(*mTranslationUnit, deferStates[*it].mDeferNodeId);
+
+            if (labelUsed[*it])
+            {
+                lines.push_back(getLabel(deferNode.getId()) + ":");
+            }
+
+            lines.push_back(getDeferredCode(source, deferNode));
+        }
+
+        const auto &dispatch = dispatches[scopeId];
+        lines.insert(lines.end(), dispatch.begin(), dispatch.end());
+
+        auto generatedCode = std::make_shared<SemNodeGeneratedCode>( //
+            closingBracePos,
+            formatLines(source, closingBracePos, lines));
+        scope.setDirty(SemNode::DirtyType::Modified);
+        scope.attach(generatedCode);
+        mTranslationUnit->registerNode(generatedCode);
+    }
+
+    for (const auto &[functionId, function] : functions)
+    {
+        auto &functionNode = static_cast<SemNodeFunction &>(findNodeById(*mTranslationUnit, functionId));
+
+        std::vector<std::string> declarations;
+        if (function.mExitVariableRead)
+        {
+            declarations.push_back("int " + std::string{kExitVariable} + " = 0;");
+        }
+
+        if (function.mReturnsValue)
         {
-            it++;
+            declarations.push_back(getReturnDeclaration(source, functionNode));
+        }
+
+        if (declarations.empty() == false)
+        {
+            declareAtFunctionStart(*mTranslationUnit, source, functionNode, declarations);
         }
     }
+}
 
-    mScopes.pop_back();
-    mAstLevelOfScopePrev--;
+std::string WalkerDeferExecute::getExitDefersCode(const std::string &source, const DeferAnalysis::Exit &exit) const
+{
+    std::string code;
+    for (const auto deferNodeId : mAnalysis->getExitDefers(exit))
+    {
+        const auto &deferNode = findNodeById(*mTranslationUnit, deferNodeId);
+        code += getDeferredCode(source, deferNode) + " ";
+    }
+
+    return code;
 }
 
-void WalkerDeferExecute::scopeRemoveIfLeftScope(const uint32_t astLevel)
+bool WalkerDeferExecute::isHidden(const SemNode &scope, const uint32_t pos, const DeferAnalysis::Exit &exit) const
 {
-    bool removed = false;
-    do
+    for (const auto deferNodeId : mAnalysis->getExitDefers(exit))
     {
-        const AstLevelEvent ev = getAstLevelEvent(astLevel);
-        if (ev == AstLevelEvent::Exit)
+        const auto &deferNode = findNodeById(*mTranslationUnit, deferNodeId);
+        const auto declared = getDeclaredNames(scope, pos, deferNode.getParent()->getId());
+        if (declared.empty())
         {
-            scopeRemove();
-            removed = true;
+            continue;
         }
-        else if (ev == AstLevelEvent::Same)
-        {
-            scopeRemove();
-            break; // no further scopes to remove
-        }
-        else
+
+        std::set<std::string> used;
+        nodes::collectNames(deferNode, used);
+        if (std::any_of(used.begin(), used.end(), [&declared](const auto &it) { return (declared.count(it) != 0); }))
         {
-            removed = false;
+            return true;
         }
-    } while (removed == true && mScopes.size() != 0);
+    }
+
+    return false;
 }
 
-void WalkerDeferExecute::deferArm(SemNodeDefer &deferNode, const uint32_t astLevel)
+void WalkerDeferExecute::attachDeferClone(const DeferAnalysis::Defer &defer)
 {
-    DeferInfo defer;
-    defer.mAstLevel = astLevel;
-    defer.mDeferNode = &deferNode;
+    auto &deferNode = findNodeById(*mTranslationUnit, defer.mDeferNodeId);
+
+    auto &deferAttachedNodes = deferNode.getAttachedNodes();
+    assert(deferAttachedNodes.size() > 0);
+
+    auto deferredOperation = deferAttachedNodes[0];
+
+    auto &scopeToAttachDefer = findNodeById(*mTranslationUnit, defer.mOwnerScopeId);
 
-    mDefersArmed.push_back(defer);
+    auto deferredOperationClone = deferredOperation->clone();
+    mTranslationUnit->registerNode(deferredOperationClone);
+    deferredOperationClone->setDirty(SemNode::DirtyType::Added);
+    scopeToAttachDefer.attach(deferredOperationClone);
+}
+
+void WalkerDeferExecute::removeDefers()
+{
+    // remove the defer nodes from AST
+    for (const auto &function : mAnalysis->getFunctions())
+    {
+        for (const auto &it : function.mDefers)
+        {
+            auto &deferOwnerScope = findNodeById(*mTranslationUnit, it.mOwnerScopeId);
+
+            auto &deferredNode = findNodeById(*mTranslationUnit, it.mDeferNodeId);
+
+            // only a defer attached directly to its scope is removed
+            if (deferredNode.getParent() == &deferOwnerScope)
+            {
+                // children shared with the clones are copied when marked
+                deferredNode.setDirty(SemNode::DirtyType::Removed);
+                deferOwnerScope.setDirty(SemNode::DirtyType::Modified);
+
+                mTranslationUnit->registerSubtree(
+                    deferOwnerScope.getAttachedNodes()[deferredNode.getIndexInParent()]);
+            }
+        }
+    }
 }
@@ -1,74 +1,47 @@
 #pragma once
 
-#include "WalkerStrategy.hpp"
+#include "DeferAnalysis.hpp"
+#include "config/Config.hpp"
 
+#include <string>
 #include <vector>
 
 namespace safec
 {
 
-// Print the whole ast.
-class WalkerDeferExecute final : public WalkerStrategy
+// Lowers the defer keyword to plain C, see DeferLowering for the modes.
+// The defers and exits to handle are found by DeferAnalysis.
+class WalkerDeferExecute final
 {
 public:
-    WalkerDeferExecute();
+    WalkerDeferExecute(const DeferLowering lowering = DeferLowering::Inline);
 
-    void peek(SemNode &node, const uint32_t astLevel) override;
-
-    // the defer keyword
-    void peek(SemNodeDefer &node, const uint32_t astLevel) override;
-
-    // all nodes that have impact on defer keyword
-    void peek(SemNodeReturn &node, const uint32_t astLevel) override;
-    void peek(SemNodeJumpStatement &node, const uint32_t astLevel) override;
-
-    // all scopes
-    void peek(SemNodeScope &node, const uint32_t astLevel) override;
-    void peek(SemNodeFunction &node, const uint32_t astLevel) override;
-    void peek(SemNodeLoop &node, const uint32_t astLevel) override;
-    void peek(SemNodeIf &node, const uint32_t astLevel) override;
-    void peek(SemNodeSwitchCaseLabel &node, const uint32_t astLevel) override;
-
-    void peek(SemNodeTranslationUnit &node, const uint32_t astLevel) override;
-
-    void commit();
+    // false if an exit can not be lowered, nothing is generated then
+    bool commit(SemNodeTranslationUnit &translationUnit, const DeferAnalysis &analysis);
 
 private:
-    struct DeferInfo
-    {
-        uint32_t mAstLevel;
-        SemNodeDefer *mDeferNode;
-    };
+    using ExitKind = DeferAnalysis::ExitKind;
+
+    static constexpr uint32_t kNoState = DeferAnalysis::kNoState;
 
-    struct DeferApplyInfo
-    {
-        int32_t mDeferNodeId;
-        int32_t mDeferOwnerScopeId;
-        int32_t mScopeToAttachDeferId;
-        int32_t mNodeToPrefixWithDeferId;
-    };
+    DeferLowering mLowering;
 
-    uint32_t mAstLevelOfScopePrev;
-    std::vector<SemNode *> mScopes;
-    std::vector<DeferInfo> mDefersArmed;
-    std::vector<DeferApplyInfo> mDeferApplyInfo;
     SemNodeTranslationUnit *mTranslationUnit;
+    const DeferAnalysis *mAnalysis;
+    uint32_t mErrors;
 
-    enum class AstLevelEvent
-    {
-        Same,
-        Enter,
-        Exit
-    };
+    void commitInline();
+    void commitGoto();
 
-    AstLevelEvent getAstLevelEvent(const uint32_t currentAstLevel);
+    // the defers run by the exit, as C code
+    std::string getExitDefersCode(const std::string &source, const DeferAnalysis::Exit &exit) const;
 
-    void scopeAdd(SemNode &node);
-    SemNode *scopeGetCurrent() const;
-    void scopeRemove();
-    void scopeRemoveIfLeftScope(const uint32_t astLevel);
+    // a name used by the defers of the exit is declared again between
+    // the pos in the scope and the defer
+    bool isHidden(const SemNode &scope, const uint32_t pos, const DeferAnalysis::Exit &exit) const;
 
-    void deferArm(SemNodeDefer &deferNode, const uint32_t astLevel);
+    void attachDeferClone(const DeferAnalysis::Defer &defer);
+    void removeDefers();
 };
 
 } // namespace safec
@@ -0,0 +1,376 @@
+#include "WalkerJsonExport.hpp"
+
+#include "logger/Logger.hpp"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace safec
+{
+
+WalkerJsonExport::WalkerJsonExport(const std::filesystem::path &outputFile)
+    : mOutputFileFp{nullptr}
+    , mOpenNodes{}
+{
+    mOutputFileFp = fopen(outputFile.c_str(), "w");
+    if (mOutputFileFp == nullptr)
+    {
+        log("failed to open file %, error: %", //
+            Color::Red,
+            outputFile.c_str(),
+            strerror(errno));
+        return;
+    }
+
+    // writes are small and frequent, a larger buffer cuts down syscalls
+    setvbuf(mOutputFileFp, nullptr, _IOFBF, kWriteBufferSize);
+}
+
+WalkerJsonExport::~WalkerJsonExport()
+{
+    if (mOutputFileFp != nullptr)
+    {
+        finish();
+        fclose(mOutputFileFp);
+    }
+}
+
+void WalkerJsonExport::finish()
+{
+    if (mOpenNodes.empty())
+    {
+        return;
+    }
+
+    while (mOpenNodes.empty() == false)
+    {
+        closeNode();
+    }
+
+    writeRaw("\n");
+}
+
+void WalkerJsonExport::peek(SemNode &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+}
+
+void WalkerJsonExport::peek(SemNodePositional &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+}
+
+void WalkerJsonExport::peek(SemNodeScope &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writeScopeFields(node);
+}
+
+void WalkerJsonExport::peek(SemNodeTranslationUnit &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writeStringField("source", node.getSourcePath().string());
+}
+
+void WalkerJsonExport::peek(SemNodeFunction &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writeScopeFields(node);
+    writeStringField("name", node.getName());
+    writeStringField("return", node.getReturn());
+
+    writeRaw(",\"params\":[");
+    bool first = true;
+    for (const auto &it : node.getParams())
+    {
+        writeRaw(first ? "{\"type\":" : ",{\"type\":");
+        writeString(it.mType);
+        writeRaw(",\"name\":");
+        writeString(it.mName);
+        writeRaw("}");
+        first = false;
+    }
+    writeRaw("]");
+}
+
+void WalkerJsonExport::peek(SemNodeLoop &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writeScopeFields(node);
+    writeStringField("name", node.getName());
+}
+
+void WalkerJsonExport::peek(SemNodeIf &node, const uint32_t astLevel)
+{
+    peek(static_cast<SemNodeScope &>(node), astLevel);
+}
+
+void WalkerJsonExport::peek(SemNodeGroup &node, const uint32_t astLevel)
+{
+    peek(static_cast<SemNodePositional &>(node), astLevel);
+}
+
+void WalkerJsonExport::peek(SemNodeReturn &node, const uint32_t astLevel)
+{
+    peek(static_cast<SemNodePositional &>(node), astLevel);
+}
+
+void WalkerJsonExport::peek(SemNodeJumpStatement &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("name", node.getName());
+
+    if (node.getLabel().empty() == false)
+    {
+        writeStringField("label", node.getLabel());
+    }
+}
+
+void WalkerJsonExport::peek(SemNodeDeclaration &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("declType", node.getLhsType());
+    writeStringField("name", node.getLhsIdentifier());
+}
+
+void WalkerJsonExport::peek(SemNodePostfixExpression &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("op", node.getOperator());
+}
+
+void WalkerJsonExport::peek(SemNodeEmptyStatement &node, const uint32_t astLevel)
+{
+    peek(static_cast<SemNodePositional &>(node), astLevel);
+}
+
+void WalkerJsonExport::peek(SemNodeGeneratedCode &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("code", node.getCode());
+}
+
+void WalkerJsonExport::peek(SemNodeBinaryOp &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("op", node.getOp());
+}
+
+void WalkerJsonExport::peek(SemNodeIdentifier &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("name", node.getName());
+}
+
+void WalkerJsonExport::peek(SemNodeConstant &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("value", node.getName());
+}
+
+void WalkerJsonExport::peek(SemNodeUnaryOp &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("op", node.toStr());
+}
+
+void WalkerJsonExport::peek(SemNodeInitializerList &node, const uint32_t astLevel)
+{
+    peek(static_cast<SemNodePositional &>(node), astLevel);
+}
+
+void WalkerJsonExport::peek(SemNodeDefer &node, const uint32_t astLevel)
+{
+    peek(static_cast<SemNodePositional &>(node), astLevel);
+}
+
+void WalkerJsonExport::peek(SemNodeSwitchCase &node, const uint32_t astLevel)
+{
+    peek(static_cast<SemNodeScope &>(node), astLevel);
+}
+
+void WalkerJsonExport::peek(SemNodeSwitchCaseLabel &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writeScopeFields(node);
+    writeBoolField("fallthrough", node.getIsFallthrough());
+}
+
+void WalkerJsonExport::peek(SemNodeGeneric &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writeScopeFields(node);
+    writeStringField("generic", node.toStr());
+}
+
+void WalkerJsonExport::peek(SemNodeGenericInstance &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("name", node.getName());
+}
+
+void WalkerJsonExport::peek(SemNodeStaticAssert &node, const uint32_t astLevel)
+{
+    openNode(node, astLevel);
+    writePositionalFields(node);
+    writeStringField("message", node.getMessage());
+}
+
+void WalkerJsonExport::openNode(SemNode &node, const uint32_t astLevel)
+{
+    // walk is depth-first, leaving a level closes all nodes below it
+    while (mOpenNodes.size() > astLevel)
+    {
+        closeNode();
+    }
+
+    if (mOpenNodes.empty() == false)
+    {
+        writeRaw(mOpenNodes.back() ? ",\n" : ",\"children\":[\n");
+        mOpenNodes.back() = true;
+    }
+
+    mOpenNodes.push_back(false);
+
+    writeRaw("{\"type\":");
+    writeString(node.getTypeStr());
+    writeNumberField("id", node.getId());
+    writeNumberField("semStart", node.getSemStart());
+    writeNumberField("semEnd", node.getSemEnd());
+
+    switch (node.getDirty())
+    {
+        case SemNode::DirtyType::Removed:
+            writeStringField("dirty", "removed");
+            break;
+
+        case SemNode::DirtyType::Modified:
+            writeStringField("dirty", "modified");
+            break;
+
+        case SemNode::DirtyType::Added:
+            writeStringField("dirty", "added");
+            break;
+
+        case SemNode::DirtyType::Clean: // fallthrough
+        default:
+            // nothing
+            break;
+    }
+}
+
+void WalkerJsonExport::closeNode()
+{
+    assert(mOpenNodes.empty() == false);
+
+    writeRaw(mOpenNodes.back() ? "]}" : "}");
+    mOpenNodes.pop_back();
+}
+
+void WalkerJsonExport::writeScopeFields(SemNodeScope &node)
+{
+    writeNumberField("start", node.getStart());
+    writeNumberField("end", node.getEnd());
+}
+
+void WalkerJsonExport::writePositionalFields(SemNodePositional &node)
+{
+    writeNumberField("pos", node.getPos());
+}
+
+void WalkerJsonExport::writeStringField(const char *name, const std::string_view value)
+{
+    writeRaw(",\"");
+    writeRaw(name);
+    writeRaw("\":");
+    writeString(value);
+}
+
+void WalkerJsonExport::writeNumberField(const char *name, const uint32_t value)
+{
+    writeRaw(",\"");
+    writeRaw(name);
+    writeRaw("\":");
+    writeRaw(std::to_string(value));
+}
+
+void WalkerJsonExport::writeBoolField(const char *name, const bool value)
+{
+    writeRaw(",\"");
+    writeRaw(name);
+    writeRaw("\":");
+    writeRaw(value ? "true" : "false");
+}
+
+void WalkerJsonExport::writeRaw(const std::string_view str)
+{
+    if (mOutputFileFp == nullptr)
+    {
+        return;
+    }
+
+    fwrite(str.data(), 1, str.size(), mOutputFileFp);
+}
+
+void WalkerJsonExport::writeString(const std::string_view str)
+{
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+
+    writeRaw("\"");
+
+    // copy unescaped runs in one go
+    size_t runStart = 0;
+    for (size_t idx = 0; idx < str.size(); idx++)
+    {
+        const unsigned char c = static_cast<unsigned char>(str[idx]);
+        if ((c != '"') && (c != '\\') && (c >= 0x20))
+        {
+            continue;
+        }
+
+        writeRaw(str.substr(runStart, idx - runStart));
+        runStart = idx + 1;
+
+        switch (c)
+        {
+            case '"':
+                writeRaw("\\\"");
+                break;
+            case '\\':
+                writeRaw("\\\\");
+                break;
+            case '\n':
+                writeRaw("\\n");
+                break;
+            case '\r':
+                writeRaw("\\r");
+                break;
+            case '\t':
+                writeRaw("\\t");
+                break;
+            default:
+            {
+                const char escaped[] = {'\\', 'u', '0', '0', kHexDigits[c >> 4], kHexDigits[c & 0xF]};
+                writeRaw(std::string_view{escaped, sizeof(escaped)});
+            }
+            break;
+        }
+    }
+
+    writeRaw(str.substr(runStart));
+    writeRaw("\"");
+}
+
+} // namespace safec
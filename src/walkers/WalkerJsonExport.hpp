@@ -0,0 +1,77 @@
+#pragma once
+
+#include "WalkerStrategy.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace safec
+{
+
+// Streams the AST as JSON to a file while walking. Only the chain of
+// currently open nodes is kept, so memory use depends on the AST depth,
+// not on its size. Each node is an object with "type", "id", positions,
+// type-specific fields and "children" (omitted when empty).
+class WalkerJsonExport final : public WalkerStrategy
+{
+public:
+    WalkerJsonExport(const std::filesystem::path &outputFile);
+    ~WalkerJsonExport();
+
+    WalkerJsonExport(const WalkerJsonExport &) = delete;
+    WalkerJsonExport &operator=(const WalkerJsonExport &) = delete;
+
+    void peek(SemNode &node, const uint32_t astLevel) override;
+    void peek(SemNodePositional &node, const uint32_t astLevel) override;
+    void peek(SemNodeScope &node, const uint32_t astLevel) override;
+    void peek(SemNodeTranslationUnit &node, const uint32_t astLevel) override;
+    void peek(SemNodeFunction &node, const uint32_t astLevel) override;
+    void peek(SemNodeLoop &node, const uint32_t astLevel) override;
+    void peek(SemNodeIf &node, const uint32_t astLevel) override;
+    void peek(SemNodeGroup &node, const uint32_t astLevel) override;
+    void peek(SemNodeReturn &node, const uint32_t astLevel) override;
+    void peek(SemNodeJumpStatement &node, const uint32_t astLevel) override;
+    void peek(SemNodeDeclaration &node, const uint32_t astLevel) override;
+    void peek(SemNodePostfixExpression &node, const uint32_t astLevel) override;
+    void peek(SemNodeEmptyStatement &node, const uint32_t astLevel) override;
+    void peek(SemNodeBinaryOp &node, const uint32_t astLevel) override;
+    void peek(SemNodeIdentifier &node, const uint32_t astLevel) override;
+    void peek(SemNodeConstant &node, const uint32_t astLevel) override;
+    void peek(SemNodeUnaryOp &node, const uint32_t astLevel) override;
+    void peek(SemNodeInitializerList &node, const uint32_t astLevel) override;
+    void peek(SemNodeDefer &node, const uint32_t astLevel) override;
+    void peek(SemNodeSwitchCase &node, const uint32_t astLevel) override;
+    void peek(SemNodeSwitchCaseLabel &node, const uint32_t astLevel) override;
+    void peek(SemNodeGeneratedCode &node, const uint32_t astLevel) override;
+    void peek(SemNodeGeneric &node, const uint32_t astLevel) override;
+    void peek(SemNodeGenericInstance &node, const uint32_t astLevel) override;
+    void peek(SemNodeStaticAssert &node, const uint32_t astLevel) override;
+
+    // closes all open nodes, called by the destructor if not before
+    void finish();
+
+private:
+    static constexpr size_t kWriteBufferSize = 1U << 16;
+
+    FILE *mOutputFileFp;
+
+    // one entry per open node, true when its "children" array is open
+    std::vector<bool> mOpenNodes;
+
+    void openNode(SemNode &node, const uint32_t astLevel);
+    void closeNode();
+
+    void writeScopeFields(SemNodeScope &node);
+    void writePositionalFields(SemNodePositional &node);
+
+    void writeStringField(const char *name, const std::string_view value);
+    void writeNumberField(const char *name, const uint32_t value);
+    void writeBoolField(const char *name, const bool value);
+
+    void writeRaw(const std::string_view str);
+    void writeString(const std::string_view str);
+};
+
+} // namespace safec
@@ -0,0 +1,817 @@
+#include "WalkerNullCheck.hpp"
+
+#include "NodeQueries.hpp"
+#include "SourceText.hpp"
+
+#include <algorithm>
+
+using namespace safec;
+using namespace safec::nodes;
+using namespace safec::source;
+
+namespace
+{
+
+// the check can be redefined before the generated file is compiled
+constexpr const char *kCheckDefinitions = //
+    "#ifndef SAFEC_NULL_CHECK\n"
+    "#include <assert.h>\n"
+    "#define SAFEC_NULL_CHECK(pointer) assert((pointer) != 0)\n"
+    "#endif\n"
+    "\n";
+
+bool isNullConstant(const SemNode &node)
+{
+    if (node.getType() == SemNode::Type::Constant)
+    {
+        return (static_cast<const SemNodeConstant &>(node).getName() == "0");
+    }
+
+    return (getVariableName(&node) == "NULL");
+}
+
+// the pointer tested by a condition, "p" or "(p = ...)"
+std::optional<std::string> getTestedPointer(const SemNode &node)
+{
+    if (node.getType() == SemNode::Type::BinaryOp)
+    {
+        const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(node);
+        return (binaryOp.getOp() == "=") ? getVariableName(binaryOp.getLhs().get()) : std::nullopt;
+    }
+
+    return getVariableName(&node);
+}
+
+// break or continue of the loop, not of the nested loops or switches
+bool containsJump(const SemNode &node, const std::string &name)
+{
+    for (const auto &it : node.getAttachedNodes())
+    {
+        const auto type = it->getType();
+        if ((type == SemNode::Type::Loop) || ((type == SemNode::Type::SwitchCase) && (name == "break")))
+        {
+            continue;
+        }
+
+        if ((type == SemNode::Type::JumpStatement) &&
+            (static_cast<const SemNodeJumpStatement &>(*it).getName() == name))
+        {
+            return true;
+        }
+
+        if (containsJump(*it, name))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// the labels have no nodes in the AST, the jumps of goto (and of the
+// do-while loops, with the condition after the body) are not followed
+// by the dataflow
+bool hasHiddenJumps(const SemNode &node)
+{
+    if ((node.getType() == SemNode::Type::Loop) && (static_cast<const SemNodeLoop &>(node).getName() == "do"))
+    {
+        return true;
+    }
+
+    if ((node.getType() == SemNode::Type::JumpStatement) &&
+        (static_cast<const SemNodeJumpStatement &>(node).getName() == "goto"))
+    {
+        return true;
+    }
+
+    const auto &attached = node.getAttachedNodes();
+    return std::any_of(attached.begin(), attached.end(), [](const auto &it) { return hasHiddenJumps(*it); });
+}
+
+} // namespace
+
+WalkerNullCheck::WalkerNullCheck()
+    : mTranslationUnit{nullptr}
+    , mTrackFacts{true}
+{
+}
+
+void WalkerNullCheck::commit(SemNodeTranslationUnit &translationUnit)
+{
+    mTranslationUnit = &translationUnit;
+
+    const std::string source = readSourceFile(translationUnit.getSourcePath());
+
+    mSymbols.clear();
+    mSymbols.emplace_back();
+
+    for (const auto &it : translationUnit.getAttachedNodes())
+    {
+        if ((it->getDirty() == SemNode::DirtyType::Removed) || (it->getType() == SemNode::Type::GeneratedCode))
+        {
+            continue;
+        }
+
+        if (it->getType() == SemNode::Type::Function)
+        {
+            visitFunction(static_cast<SemNodeFunction &>(*it));
+        }
+        else
+        {
+            Facts globalFacts;
+            declare(*it, globalFacts);
+        }
+    }
+
+    if (mChecks.empty() == false)
+    {
+        insertChecks(source);
+    }
+}
+
+const WalkerNullCheck::Report &WalkerNullCheck::getReport() const
+{
+    return mReport;
+}
+
+void WalkerNullCheck::visitFunction(SemNodeFunction &function)
+{
+    mAddressTaken.clear();
+    collectAddressTaken(function, mAddressTaken);
+
+    // with hidden jumps only what is known within a statement is used
+    mTrackFacts = (hasHiddenJumps(function) == false);
+
+    mSymbols.emplace_back();
+    for (const auto &param : function.getParams())
+    {
+        mSymbols.back()[param.mName] = false;
+    }
+
+    // nothing is known about the params and the globals on entry
+    Facts facts;
+    for (const auto &it : function.getAttachedNodes())
+    {
+        if (it->getType() == SemNode::Type::Scope)
+        {
+            visitBlock(*it, facts);
+        }
+    }
+
+    mSymbols.pop_back();
+}
+
+void WalkerNullCheck::visitBlock(SemNode &block, Facts &facts)
+{
+    mSymbols.emplace_back();
+
+    for (const auto &it : block.getAttachedNodes())
+    {
+        visitStatement(*it, facts, true);
+    }
+
+    // the names declared here may mean other variables after the block
+    for (const auto &[name, array] : mSymbols.back())
+    {
+        facts.mNonNull.erase(name);
+    }
+
+    mSymbols.pop_back();
+}
+
+void WalkerNullCheck::visitStatement(SemNode &statement, Facts &facts, const bool canInsert)
+{
+    // removed by the defer lowering, its copies are not visited - the
+    // statement runs at the exits, the dereferences are only counted
+    if (statement.getType() == SemNode::Type::Defer)
+    {
+        Facts exitFacts;
+        Statement deferred{nullptr, {}};
+        for (const auto &it : statement.getAttachedNodes())
+        {
+            visitExpression(*it, exitFacts, deferred, false);
+        }
+
+        return;
+    }
+
+    if (statement.getDirty() == SemNode::DirtyType::Removed)
+    {
+        return;
+    }
+
+    if (mTrackFacts == false)
+    {
+        facts.mNonNull.clear();
+    }
+
+    // code of the other passes (e.g. the defer lowering), it can do anything
+    if (statement.getType() == SemNode::Type::GeneratedCode)
+    {
+        facts.mNonNull.clear();
+        return;
+    }
+
+    // deferred statements copied to the exits are not checked
+    if (statement.getDirty() == SemNode::DirtyType::Added)
+    {
+        killFacts(facts, statement);
+        return;
+    }
+
+    switch (statement.getType())
+    {
+        case SemNode::Type::Scope:
+            visitBlock(statement, facts);
+            break;
+
+        case SemNode::Type::If:
+            visitIf(statement, facts, canInsert);
+            break;
+
+        case SemNode::Type::SwitchCase:
+            visitSwitch(statement, facts, canInsert);
+            break;
+
+        case SemNode::Type::Loop:
+            visitLoop(static_cast<SemNodeLoop &>(statement), facts, canInsert);
+            break;
+
+        case SemNode::Type::Return:
+        case SemNode::Type::JumpStatement:
+        {
+            Statement exit{canInsert ? &statement : nullptr, {}};
+            for (const auto &it : statement.getAttachedNodes())
+            {
+                visitExpression(*it, facts, exit, false);
+            }
+
+            facts.mReachable = false;
+        }
+        break;
+
+        default:
+        {
+            // C89 - no statement can be placed before a declaration
+            const bool isDeclaration = (getDeclaration(statement) != nullptr);
+
+            Statement current{(canInsert && (isDeclaration == false)) ? &statement : nullptr, {}};
+            visitExpression(statement, facts, current, false);
+
+            if (isDeclaration)
+            {
+                declare(statement, facts);
+            }
+        }
+        break;
+    }
+}
+
+void WalkerNullCheck::visitIf(SemNode &ifNode, Facts &facts, const bool canInsert)
+{
+    const auto &group = *static_cast<SemNodeIf &>(ifNode).getGroup();
+
+    // the condition runs once, before the branches
+    Statement condition{canInsert ? &ifNode : nullptr, {}};
+    visitExpression(group, facts, condition, false);
+
+    Facts thenFacts = facts;
+    Facts elseFacts = facts;
+    if (group.getAttachedNodes().empty() == false)
+    {
+        addConditionFacts(*group.getAttachedNodes().front(), true, thenFacts);
+        addConditionFacts(*group.getAttachedNodes().front(), false, elseFacts);
+    }
+
+    bool isThen = true;
+    for (const auto &it : ifNode.getAttachedNodes())
+    {
+        if (it->getType() == SemNode::Type::Group)
+        {
+            continue;
+        }
+
+        visitStatement(*it, isThen ? thenFacts : elseFacts, (it->getType() == SemNode::Type::Scope));
+        isThen = false;
+    }
+
+    facts = thenFacts;
+    mergeFacts(facts, elseFacts);
+}
+
+void WalkerNullCheck::visitSwitch(SemNode &switchNode, Facts &facts, const bool canInsert)
+{
+    Statement expression{canInsert ? &switchNode : nullptr, {}};
+    for (const auto &it : switchNode.getAttachedNodes())
+    {
+        if (it->getType() != SemNode::Type::Scope)
+        {
+            visitExpression(*it, facts, expression, false);
+        }
+    }
+
+    // a label can be reached from the switch and from the code before it
+    Facts entry = facts;
+    killFacts(entry, switchNode);
+
+    Facts current;
+    current.mReachable = false;
+
+    for (const auto &body : switchNode.getAttachedNodes())
+    {
+        if (body->getType() != SemNode::Type::Scope)
+        {
+            continue;
+        }
+
+        mSymbols.emplace_back();
+
+        for (const auto &it : body->getAttachedNodes())
+        {
+            if (it->getType() != SemNode::Type::SwitchCaseLabel)
+            {
+                visitStatement(*it, current, true);
+                continue;
+            }
+
+            mergeFacts(current, entry);
+
+            // the first node is the case label
+            const auto &attachedNodes = it->getAttachedNodes();
+            for (size_t i = 1; i < attachedNodes.size(); i++)
+            {
+                visitStatement(*attachedNodes[i], current, true);
+            }
+        }
+
+        for (const auto &[name, array] : mSymbols.back())
+        {
+            current.mNonNull.erase(name);
+        }
+
+        mSymbols.pop_back();
+    }
+
+    // the breaks, the end of the body or no matching label
+    facts = entry;
+    mergeFacts(facts, current);
+}
+
+void WalkerNullCheck::visitLoop(SemNodeLoop &loop, Facts &facts, const bool canInsert)
+{
+    // the init runs once before the loop
+    if (loop.getIteratorInit() != nullptr)
+    {
+        Statement init{canInsert ? &loop : nullptr, {}};
+        visitExpression(*loop.getIteratorInit(), facts, init, false);
+    }
+
+    // what holds on every iteration, nothing the loop changes
+    Facts entry = facts;
+    for (const auto &it : {loop.getIteratorCondition(), loop.getIteratorChange()})
+    {
+        if (it != nullptr)
+        {
+            killFacts(entry, *it);
+        }
+    }
+
+    for (const auto &it : loop.getAttachedNodes())
+    {
+        if (it->getType() != SemNode::Type::Group)
+        {
+            killFacts(entry, *it);
+        }
+    }
+
+    // the condition and the change run on each iteration, there is no
+    // place for their checks
+    Facts bodyFacts = entry;
+    const auto condition = loop.getIteratorCondition();
+    if (condition != nullptr)
+    {
+        Statement conditionStatement{nullptr, {}};
+        visitExpression(*condition, bodyFacts, conditionStatement, false);
+        addConditionFacts(*condition, true, bodyFacts);
+    }
+
+    for (const auto &it : loop.getAttachedNodes())
+    {
+        if (it->getType() != SemNode::Type::Group)
+        {
+            visitStatement(*it, bodyFacts, (it->getType() == SemNode::Type::Scope));
+        }
+    }
+
+    const bool hasBreak = containsJump(loop, "break");
+    const bool hasContinue = containsJump(loop, "continue");
+
+    // the change runs after the body or a continue
+    if (loop.getIteratorChange() != nullptr)
+    {
+        Facts changeFacts = hasContinue ? entry : bodyFacts;
+        Statement changeStatement{nullptr, {}};
+        visitExpression(*loop.getIteratorChange(), changeFacts, changeStatement, false);
+    }
+
+    // without a break the loop ends only when the condition is false
+    facts = entry;
+    if ((condition != nullptr) && (hasBreak == false))
+    {
+        addConditionFacts(*condition, false, facts);
+    }
+}
+
+void WalkerNullCheck::visitExpression( //
+    const SemNode &node,
+    Facts &facts,
+    Statement &statement,
+    const bool conditional)
+{
+    switch (node.getType())
+    {
+        case SemNode::Type::BinaryOp:
+        {
+            const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(node);
+            const std::string op = binaryOp.getOp();
+            const auto lhs = binaryOp.getLhs();
+            const auto rhs = binaryOp.getRhs();
+
+            if ((lhs == nullptr) || (rhs == nullptr))
+            {
+                break;
+            }
+
+            // the right side of "&&", "||" and "?" does not always run
+            if ((op == "&&") || (op == "||") || (op == "?"))
+            {
+                visitExpression(*lhs, facts, statement, conditional);
+
+                Facts rhsFacts = facts;
+                if (op != "?")
+                {
+                    addConditionFacts(*lhs, (op == "&&"), rhsFacts);
+                }
+
+                visitExpression(*rhs, rhsFacts, statement, true);
+                mergeFacts(facts, rhsFacts);
+                return;
+            }
+
+            if (isAssignment(op))
+            {
+                visitExpression(*rhs, facts, statement, conditional);
+                visitExpression(*lhs, facts, statement, conditional);
+
+                const auto name = getVariableName(lhs.get());
+                if (name.has_value())
+                {
+                    const bool nonNull = (op == "=") && isNonNull(*rhs, facts);
+
+                    facts.mNonNull.erase(*name);
+                    statement.mWritten.insert(*name);
+
+                    if (nonNull)
+                    {
+                        addFact(facts, *name);
+                    }
+                }
+
+                return;
+            }
+        }
+        break;
+
+        case SemNode::Type::UnaryOp:
+        {
+            const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(node);
+            const std::string op = unaryOp.getOp();
+            const auto rhs = unaryOp.getRhs();
+
+            // the operand of sizeof is not evaluated
+            if ((op == "sizeof") || (rhs == nullptr))
+            {
+                return;
+            }
+
+            visitExpression(*rhs, facts, statement, conditional);
+
+            if (op == "*")
+            {
+                dereference(*rhs, facts, statement, conditional);
+            }
+            else if ((op == "++") || (op == "--"))
+            {
+                const auto name = getVariableName(rhs.get());
+                if (name.has_value())
+                {
+                    facts.mNonNull.erase(*name);
+                    statement.mWritten.insert(*name);
+                }
+            }
+
+            return;
+        }
+
+        case SemNode::Type::PostfixExpression:
+        {
+            const auto &postfix = static_cast<const SemNodePostfixExpression &>(node);
+            const std::string op = postfix.getOperator();
+            const auto lhs = postfix.getLhs();
+
+            // the call arguments and the indexes are attached to the lhs
+            visitExpression(*lhs, facts, statement, conditional);
+
+            if (op == "->")
+            {
+                dereference(*lhs, facts, statement, conditional);
+            }
+            else if ((op == "++") || (op == "--"))
+            {
+                const auto name = getVariableName(lhs.get());
+                if (name.has_value())
+                {
+                    facts.mNonNull.erase(*name);
+                    statement.mWritten.insert(*name);
+                }
+            }
+            else if ((op == "()") || (op == "(...)"))
+            {
+                // a call can change any global
+                for (auto it = facts.mNonNull.begin(); it != facts.mNonNull.end();)
+                {
+                    it = isLocal(*it) ? std::next(it) : facts.mNonNull.erase(it);
+                }
+            }
+
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        visitExpression(*it, facts, statement, conditional);
+    }
+}
+
+void WalkerNullCheck::dereference( //
+    const SemNode &pointer,
+    Facts &facts,
+    Statement &statement,
+    const bool conditional)
+{
+    // only the plain variables are tracked, not "*(p + 1)" or "p->next->x"
+    const auto name = getVariableName(&pointer);
+    if (name.has_value() == false)
+    {
+        mReport.mUnchecked++;
+        return;
+    }
+
+    if (isNonNull(pointer, facts))
+    {
+        mReport.mElided++;
+        return;
+    }
+
+    // the check runs before the statement, the pointer can not be changed
+    // by the statement before the dereference and it must always run
+    if ((statement.mAnchor == nullptr) || conditional || (statement.mWritten.count(*name) != 0))
+    {
+        mReport.mUnchecked++;
+        return;
+    }
+
+    addCheck(*statement.mAnchor, *name);
+    addFact(facts, *name);
+    mReport.mChecked++;
+}
+
+void WalkerNullCheck::declare(const SemNode &statement, Facts &facts)
+{
+    const auto declaration = getDeclaration(statement);
+    if (declaration == nullptr)
+    {
+        return;
+    }
+
+    // the initializer is evaluated before the name is declared
+    bool nonNull = false;
+    if (statement.getType() == SemNode::Type::BinaryOp)
+    {
+        const auto rhs = static_cast<const SemNodeBinaryOp &>(statement).getRhs();
+        nonNull = (rhs != nullptr) && isNonNull(*rhs, facts);
+    }
+
+    const std::string name = declaration->getLhsIdentifier();
+    mSymbols.back()[name] = (declaration->getArrayDimensions().empty() == false);
+
+    facts.mNonNull.erase(name);
+    if (nonNull)
+    {
+        addFact(facts, name);
+    }
+}
+
+bool WalkerNullCheck::isLocal(const std::string &name) const
+{
+    for (auto it = mSymbols.rbegin(); it != mSymbols.rend(); it++)
+    {
+        if (it->count(name) != 0)
+        {
+            return (it != (mSymbols.rend() - 1));
+        }
+    }
+
+    return false;
+}
+
+bool WalkerNullCheck::isArray(const std::string &name) const
+{
+    for (auto it = mSymbols.rbegin(); it != mSymbols.rend(); it++)
+    {
+        const auto symbol = it->find(name);
+        if (symbol != it->end())
+        {
+            return symbol->second;
+        }
+    }
+
+    return false;
+}
+
+bool WalkerNullCheck::isNonNull(const SemNode &node, const Facts &facts) const
+{
+    switch (node.getType())
+    {
+        case SemNode::Type::Identifier:
+        {
+            const auto name = getVariableName(&node);
+            return name.has_value() && (isArray(*name) || (facts.mNonNull.count(*name) != 0));
+        }
+
+        // a string literal
+        case SemNode::Type::Constant:
+            return (static_cast<const SemNodeConstant &>(node).getName().front() == '"');
+
+        case SemNode::Type::UnaryOp:
+            return (static_cast<const SemNodeUnaryOp &>(node).getOp() == "&");
+
+        case SemNode::Type::BinaryOp:
+        {
+            const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(node);
+            return (binaryOp.getOp() == "=") && (binaryOp.getRhs() != nullptr) &&
+                   isNonNull(*binaryOp.getRhs(), facts);
+        }
+
+        default:
+            return false;
+    }
+}
+
+void WalkerNullCheck::addFact(Facts &facts, const std::string &name) const
+{
+    // the pointers with the address taken can change anywhere
+    if (mAddressTaken.count(name) == 0)
+    {
+        facts.mNonNull.insert(name);
+    }
+}
+
+void WalkerNullCheck::addConditionFacts(const SemNode &condition, const bool value, Facts &facts) const
+{
+    const auto tested = getTestedPointer(condition);
+    if (tested.has_value())
+    {
+        if (value)
+        {
+            addFact(facts, *tested);
+        }
+
+        return;
+    }
+
+    if (condition.getType() == SemNode::Type::UnaryOp)
+    {
+        const auto &unaryOp = static_cast<const SemNodeUnaryOp &>(condition);
+        if ((unaryOp.getOp() == "!") && (unaryOp.getRhs() != nullptr))
+        {
+            addConditionFacts(*unaryOp.getRhs(), (value == false), facts);
+        }
+
+        return;
+    }
+
+    if (condition.getType() != SemNode::Type::BinaryOp)
+    {
+        return;
+    }
+
+    const auto &binaryOp = static_cast<const SemNodeBinaryOp &>(condition);
+    const std::string op = binaryOp.getOp();
+    const auto lhs = binaryOp.getLhs();
+    const auto rhs = binaryOp.getRhs();
+
+    if ((lhs == nullptr) || (rhs == nullptr))
+    {
+        return;
+    }
+
+    // both sides hold if "a && b" is true or "a || b" is false
+    if (((op == "&&") && value) || ((op == "||") && (value == false)))
+    {
+        addConditionFacts(*lhs, value, facts);
+        addConditionFacts(*rhs, value, facts);
+        return;
+    }
+
+    if ((op != "==") && (op != "!="))
+    {
+        return;
+    }
+
+    // "p != NULL", "NULL != p", "p == 0"...
+    std::optional<std::string> pointer;
+    if (isNullConstant(*rhs))
+    {
+        pointer = getTestedPointer(*lhs);
+    }
+    else if (isNullConstant(*lhs))
+    {
+        pointer = getTestedPointer(*rhs);
+    }
+
+    if (pointer.has_value() && ((op == "!=") == value))
+    {
+        addFact(facts, *pointer);
+    }
+}
+
+void WalkerNullCheck::killFacts(Facts &facts, const SemNode &node) const
+{
+    Writes writes;
+    collectWrites(node, writes);
+
+    for (const auto &it : writes.mNames)
+    {
+        facts.mNonNull.erase(it);
+    }
+
+    // a call can change any global
+    for (auto it = facts.mNonNull.begin(); writes.mCall && (it != facts.mNonNull.end());)
+    {
+        it = isLocal(*it) ? std::next(it) : facts.mNonNull.erase(it);
+    }
+}
+
+void WalkerNullCheck::mergeFacts(Facts &facts, const Facts &other)
+{
+    if (other.mReachable == false)
+    {
+        return;
+    }
+
+    if (facts.mReachable == false)
+    {
+        facts = other;
+        return;
+    }
+
+    for (auto it = facts.mNonNull.begin(); it != facts.mNonNull.end();)
+    {
+        it = (other.mNonNull.count(*it) != 0) ? std::next(it) : facts.mNonNull.erase(it);
+    }
+}
+
+void WalkerNullCheck::addCheck(SemNode &statement, const std::string &pointer)
+{
+    const std::string code = "SAFEC_NULL_CHECK(" + pointer + ");";
+
+    // the checks of a statement are added one after another
+    if (mChecks.empty() || (mChecks.back().mStatement != &statement))
+    {
+        mChecks.push_back(Checks{&statement, {code}});
+        return;
+    }
+
+    auto &statementCode = mChecks.back().mCode;
+    if (std::find(statementCode.begin(), statementCode.end(), code) == statementCode.end())
+    {
+        statementCode.push_back(code);
+    }
+}
+
+void WalkerNullCheck::insertChecks(const std::string &source)
+{
+    for (const auto &checks : mChecks)
+    {
+        insertBeforeStatement(*mTranslationUnit, source, *checks.mStatement, checks.mCode);
+    }
+
+    auto definitions = std::make_shared<SemNodeGeneratedCode>(0U, kCheckDefinitions);
+    mTranslationUnit->insertChild(0, definitions);
+    mTranslationUnit->registerNode(definitions);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace safec
+{
+
+// Checks the pointers for NULL before they are dereferenced ("*p", "p->x").
+// A check is a SAFEC_NULL_CHECK() statement placed before the statement
+// with the dereference. A forward dataflow pass over each function tracks
+// the pointers known not to be NULL (checked before, compared with NULL
+// or assigned an address) and drops the checks they make redundant.
+class WalkerNullCheck final
+{
+public:
+    // number of the dereferences by the way they were handled
+    struct Report
+    {
+        uint32_t mChecked = 0;   // checked before the statement
+        uint32_t mElided = 0;    // known not to be NULL, no check needed
+        uint32_t mUnchecked = 0; // no place for a check
+    };
+
+    WalkerNullCheck();
+
+    void commit(SemNodeTranslationUnit &translationUnit);
+
+    const Report &getReport() const;
+
+private:
+    // pointers known not to be NULL at a point of the function, the
+    // points after an exit are not reachable and know everything
+    struct Facts
+    {
+        bool mReachable = true;
+        std::set<std::string> mNonNull;
+    };
+
+    // true for the arrays, they are never NULL
+    using SymbolScope = std::map<std::string, bool>;
+
+    // the statement the dereferences are in
+    struct Statement
+    {
+        SemNode *mAnchor;               // the checks go before it, nullptr if they can not
+        std::set<std::string> mWritten; // changed so far, a check before the statement is stale
+    };
+
+    // checks to be placed before a statement
+    struct Checks
+    {
+        SemNode *mStatement;
+        std::vector<std::string> mCode;
+    };
+
+    SemNodeTranslationUnit *mTranslationUnit;
+    std::vector<SymbolScope> mSymbols;
+    std::set<std::string> mAddressTaken;
+    bool mTrackFacts;
+    std::vector<Checks> mChecks;
+    Report mReport;
+
+    void visitFunction(SemNodeFunction &function);
+    void visitBlock(SemNode &block, Facts &facts);
+    void visitStatement(SemNode &statement, Facts &facts, const bool canInsert);
+    void visitIf(SemNode &ifNode, Facts &facts, const bool canInsert);
+    void visitSwitch(SemNode &switchNode, Facts &facts, const bool canInsert);
+    void visitLoop(SemNodeLoop &loop, Facts &facts, const bool canInsert);
+
+    void visitExpression(const SemNode &node, Facts &facts, Statement &statement, const bool conditional);
+    void dereference(const SemNode &pointer, Facts &facts, Statement &statement, const bool conditional);
+
+    void declare(const SemNode &statement, Facts &facts);
+    bool isLocal(const std::string &name) const;
+    bool isArray(const std::string &name) const;
+
+    bool isNonNull(const SemNode &node, const Facts &facts) const;
+    void addFact(Facts &facts, const std::string &name) const;
+    void addConditionFacts(const SemNode &condition, const bool value, Facts &facts) const;
+    void killFacts(Facts &facts, const SemNode &node) const;
+
+    static void mergeFacts(Facts &facts, const Facts &other);
+
+    void addCheck(SemNode &statement, const std::string &pointer);
+    void insertChecks(const std::string &source);
+};
+
+} // namespace safec
@@ -185,6 +185,43 @@ void WalkerPrint::peek(SemNodeGroup &node, const uint32_t astLevel)
         getPos(node));
 }
 
+void WalkerPrint::peek(SemNodeGeneratedCode &node, const uint32_t astLevel)
+{
+    // only the position, the code spans multiple lines
+    log("% at %", //
+        Color::Blue,
+        getPrefix(node, astLevel),
+        node.getPos());
+}
+
+void WalkerPrint::peek(SemNodeGeneric &node, const uint32_t astLevel)
+{
+    log("% '%' { % }",
+        Color::Black,
+        Color::BgYellow, //
+        getPrefix(node, astLevel),
+        node.toStr(),
+        getPos(node));
+}
+
+void WalkerPrint::peek(SemNodeGenericInstance &node, const uint32_t astLevel)
+{
+    log("% '%' { % }",
+        Color::Green, //
+        getPrefix(node, astLevel),
+        node.toStr(),
+        getPos(node));
+}
+
+void WalkerPrint::peek(SemNodeStaticAssert &node, const uint32_t astLevel)
+{
+    log("% '%' { % }",
+        Color::Magenta, //
+        getPrefix(node, astLevel),
+        node.toStr(),
+        getPos(node));
+}
+
 std::string WalkerPrint::getPrefix(SemNode &node, const uint32_t astLevel)
 {
     std::string prefix{};
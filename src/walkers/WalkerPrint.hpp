@@ -29,6 +29,10 @@ public:
     void peek(SemNodeSwitchCase &node, const uint32_t astLevel) override;
     void peek(SemNodeSwitchCaseLabel &node, const uint32_t astLevel) override;
     void peek(SemNodeGroup &node, const uint32_t astLevel) override;
+    void peek(SemNodeGeneratedCode &node, const uint32_t astLevel) override;
+    void peek(SemNodeGeneric &node, const uint32_t astLevel) override;
+    void peek(SemNodeGenericInstance &node, const uint32_t astLevel) override;
+    void peek(SemNodeStaticAssert &node, const uint32_t astLevel) override;
 
 private:
     std::string getPrefix(SemNode &node, const uint32_t astLevel);
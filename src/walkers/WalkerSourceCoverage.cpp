@@ -2,6 +2,7 @@
 
 #include "logger/Logger.hpp"
 #include "semantic_nodes/SemNode.hpp"
+#include "semantic_nodes/SemNodeFlat.hpp"
 
 #include <algorithm>
 
@@ -49,44 +50,14 @@ void WalkerSourceCoverage::peek( //
     SemNodePositional &node,
     const uint32_t astLevel)
 {
-    if (node.getSemStart() == 0 && node.getSemEnd() == 0)
-    {
-        // ignore if no semantic pos info
-        return;
-    }
-
-    updateMinMax(node.getSemStart());
-    updateMinMax(node.getSemEnd());
-
-    PosInfo posInfo;
-    posInfo.mStart = node.getSemStart();
-    posInfo.mEnd = node.getSemEnd();
-    posInfo.mAstLevel = astLevel;
-    posInfo.mNode = &node;
-
-    mScopesInfo.push_back(posInfo);
+    addPosInfo(node.getSemStart(), node.getSemEnd(), astLevel, node.getType());
 }
 
 void WalkerSourceCoverage::peek( //
     SemNodeScope &node,
     const uint32_t astLevel)
 {
-    if (node.getSemStart() == 0 && node.getSemEnd() == 0)
-    {
-        // ignore if no semantic pos info
-        return;
-    }
-
-    updateMinMax(node.getSemStart());
-    updateMinMax(node.getSemEnd());
-
-    PosInfo scopeInfo;
-    scopeInfo.mStart = node.getSemStart();
-    scopeInfo.mEnd = node.getSemEnd();
-    scopeInfo.mAstLevel = astLevel;
-    scopeInfo.mNode = &node;
-
-    mScopesInfo.push_back(scopeInfo);
+    addPosInfo(node.getSemStart(), node.getSemEnd(), astLevel, node.getType());
 }
 
 void WalkerSourceCoverage::peek(SemNodeGroup &node, const uint32_t astLevel)
@@ -94,6 +65,27 @@ void WalkerSourceCoverage::peek(SemNodeGroup &node, const uint32_t astLevel)
     // ignore
 }
 
+void WalkerSourceCoverage::collect(const SemNodeFlat &ast)
+{
+    const auto &types = ast.getTypes();
+    const auto &semStarts = ast.getSemStarts();
+    const auto &semEnds = ast.getSemEnds();
+    const auto &levels = ast.getLevels();
+
+    for (uint32_t i = 0; i < ast.getNodeCount(); i++)
+    {
+        const auto type = types[i];
+        if ((type == SemNode::Type::TranslationUnit) || (type == SemNode::Type::Group))
+        {
+            // ignore, like the walk
+            continue;
+        }
+
+        assert(type != SemNode::Type::Undefined);
+        addPosInfo(semStarts[i], semEnds[i], levels[i], type);
+    }
+}
+
 void WalkerSourceCoverage::printReport()
 {
     log("Coverage info:");
@@ -149,10 +141,10 @@ void WalkerSourceCoverage::checkScopes()
             Color::Red,
             scopePrev.mEnd,
             scopeCur.mStart,
-            scopePrev.mNode->getTypeStr(),
+            SemNode::typeToStr(scopePrev.mType),
             scopePrev.mStart,
             scopePrev.mEnd,
-            scopeCur.mNode->getTypeStr(),
+            SemNode::typeToStr(scopeCur.mType),
             scopeCur.mStart,
             scopeCur.mEnd);
     }
@@ -163,6 +155,30 @@ void WalkerSourceCoverage::checkScopes()
     }
 }
 
+void WalkerSourceCoverage::addPosInfo( //
+    const uint32_t start,
+    const uint32_t end,
+    const uint32_t astLevel,
+    const SemNode::Type type)
+{
+    if (start == 0 && end == 0)
+    {
+        // ignore if no semantic pos info
+        return;
+    }
+
+    updateMinMax(start);
+    updateMinMax(end);
+
+    PosInfo posInfo;
+    posInfo.mStart = start;
+    posInfo.mEnd = end;
+    posInfo.mAstLevel = astLevel;
+    posInfo.mType = type;
+
+    mScopesInfo.push_back(posInfo);
+}
+
 void WalkerSourceCoverage::updateMinMax(const uint32_t pos)
 {
     if (pos > mMaxIndex)
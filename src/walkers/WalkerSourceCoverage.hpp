@@ -8,6 +8,8 @@
 namespace safec
 {
 
+class SemNodeFlat;
+
 // verify the AST corresponds directly to the source file
 class WalkerSourceCoverage final : public WalkerStrategy
 {
@@ -20,6 +22,9 @@ public:
 
     void peek(SemNodeGroup &node, const uint32_t astLevel) override;
 
+    // gathers the positions from a flat AST instead of walking the nodes
+    void collect(const SemNodeFlat &ast);
+
     void printReport();
 
 private:
@@ -28,7 +33,7 @@ private:
         uint32_t mStart;
         uint32_t mEnd;
         uint32_t mAstLevel;
-        SemNode *mNode; // TODO: add NonOwningPtr<> / NonNullPtr<>
+        SemNode::Type mType;
     };
 
     std::vector<PosInfo> mScopesInfo;
@@ -38,6 +43,12 @@ private:
 
     void checkScopes();
 
+    void addPosInfo( //
+        const uint32_t start,
+        const uint32_t end,
+        const uint32_t astLevel,
+        const SemNode::Type type);
+
     void updateMinMax(const uint32_t pos);
 };
 
@@ -1,7 +1,10 @@
 #include "WalkerSourceGen.hpp"
 
 #include "logger/Logger.hpp"
+#include "semantic_nodes/SemNodeFlat.hpp"
+#include "utils/Timings.hpp"
 
+#include <algorithm>
 #include <cerrno>
 
 using namespace safec;
@@ -42,6 +45,55 @@ WalkerSourceGen::~WalkerSourceGen()
 }
 
 void WalkerSourceGen::peek(SemNode &node, const uint32_t)
+{
+    addRange(node.getSemStart(), node.getSemEnd(), node.getType(), node.getDirty());
+}
+
+void WalkerSourceGen::peek(SemNodeTranslationUnit &node, const uint32_t)
+{
+    openSourceFile(node.getSourcePath());
+}
+
+void WalkerSourceGen::peek(SemNodeGeneratedCode &node, const uint32_t)
+{
+    // the source the code replaces, if any
+    addRange(node.getSemStart(), node.getSemEnd(), node.getType(), node.getDirty());
+    addCode(node.getPos(), node.getCode());
+}
+
+void WalkerSourceGen::collect(const SemNodeFlat &ast)
+{
+    openSourceFile(ast.getSourcePath());
+
+    const auto &types = ast.getTypes();
+    const auto &dirty = ast.getDirty();
+    const auto &semStarts = ast.getSemStarts();
+    const auto &semEnds = ast.getSemEnds();
+
+    // the root is the translation unit, handled above like in the walk
+    for (uint32_t i = 1; i < ast.getNodeCount(); i++)
+    {
+        addRange(semStarts[i], semEnds[i], types[i], dirty[i]);
+    }
+
+    for (const auto &it : ast.getGeneratedCode())
+    {
+        addCode(it.mPos, it.mCode);
+    }
+}
+
+void WalkerSourceGen::openSourceFile(const fs::path &sourceFile)
+{
+    mSourceFile = sourceFile;
+    mSourceFileFp = fopen(mSourceFile.c_str(), "r");
+    assert(mSourceFileFp != nullptr);
+}
+
+void WalkerSourceGen::addRange( //
+    const uint32_t startPos,
+    const uint32_t endPos,
+    const SemNode::Type type,
+    const SemNode::DirtyType dirty)
 {
     assert(mOutputFileFp != nullptr);
     assert(mSourceFileFp != nullptr);
@@ -50,9 +102,6 @@ void WalkerSourceGen::peek(SemNode &node, const uint32_t)
     //  - if node deleted - ignore the range
     //  - if node added - check start/end pos, if 0 - toStr(), else just add
 
-    const int32_t startPos = node.getSemStart();
-    const int32_t endPos = node.getSemEnd();
-
     if ((startPos == 0) && (endPos == 0))
     {
         // skip node with no sem pos info
@@ -62,16 +111,16 @@ void WalkerSourceGen::peek(SemNode &node, const uint32_t)
     SourceRange sourceRange;
     sourceRange.mStartPos = startPos;
     sourceRange.mEndPos = endPos;
-    sourceRange.mNodeType = node.getTypeStr();
+    sourceRange.mNodeType = SemNode::typeToStr(type);
 
-    if (node.getDirty() == SemNode::DirtyType::Removed)
+    if (dirty == SemNode::DirtyType::Removed)
     {
         // skip removed nodes, but save them for later
         mRemovedRanges.push_back(sourceRange);
         return;
     }
 
-    if (node.getDirty() == SemNode::DirtyType::Added)
+    if (dirty == SemNode::DirtyType::Added)
     {
         // prepend newline before defer since otherwise this
         // will be in the exact same line as previous node
@@ -84,46 +133,61 @@ void WalkerSourceGen::peek(SemNode &node, const uint32_t)
         sourceRange.mAdded = true;
     }
 
-    //    log("adding range: (%-%) % (added: %)", startPos, endPos, node.getTypeStr(), sourceRange.mAdded ? "true" :
-    //    "false");
-
     mSourceRanges.push_back(sourceRange);
 }
 
-void WalkerSourceGen::peek(SemNodeTranslationUnit &node, const uint32_t)
+void WalkerSourceGen::addCode(const uint32_t pos, const std::string &code)
 {
-    mSourceFile = node.getSourcePath();
-    mSourceFileFp = fopen(mSourceFile.c_str(), "r");
-    assert(mSourceFileFp != nullptr);
+    CodeInsertion codeInsertion;
+    codeInsertion.mPos = pos;
+    codeInsertion.mCode = code;
+
+    mCodeInsertions.push_back(codeInsertion);
 }
 
 void WalkerSourceGen::generate()
 {
-    squashRanges();
-    applyNodeRemoves();
-
     {
-        // write the first range, since iteration starts from "1"
-        uint32_t chunkStartPos = mSourceRanges[0].mStartPos;
-        uint32_t chunkEndPos = mSourceRanges[0].mEndPos;
+        utils::ScopedTiming timing{"sourcegen_ranges"};
+        prepareRanges();
+    }
 
-        auto sourceChunk = getStrFromSource(chunkStartPos, chunkEndPos);
-        const uint32_t sourceChunkLen = chunkEndPos - chunkStartPos;
+    utils::ScopedTiming timing{"sourcegen_write"};
 
-        writeChunkToOutputFile(sourceChunk, sourceChunkLen);
-    }
+    // the code at the same position keeps the order it was added in
+    std::stable_sort( //
+        mCodeInsertions.begin(),
+        mCodeInsertions.end(),
+        [](const CodeInsertion &lhs, const CodeInsertion &rhs) { return lhs.mPos < rhs.mPos; });
 
-    for (uint32_t i = 1; i < mSourceRanges.size(); i++)
+    size_t nextCodeInsertion = 0;
+    for (uint32_t i = 0; i < mSourceRanges.size(); i++)
     {
-        auto &it = mSourceRanges[i];
+        writeRange(mSourceRanges[i], (i == 0), nextCodeInsertion);
+    }
 
-        uint32_t chunkStartPos = it.mStartPos;
-        uint32_t chunkEndPos = it.mEndPos;
+    // code past the last range (e.g. at the end of the file)
+    for (; nextCodeInsertion < mCodeInsertions.size(); nextCodeInsertion++)
+    {
+        const auto &code = mCodeInsertions[nextCodeInsertion].mCode;
+        writeChunkToOutputFile(code, code.size());
+    }
+}
 
-        const auto sourceChunk = getStrFromSource(chunkStartPos, chunkEndPos);
-        const uint32_t sourceChunkLen = chunkEndPos - chunkStartPos;
+void WalkerSourceGen::writeRange( //
+    const SourceRange &range,
+    const bool isFirst,
+    size_t &nextCodeInsertion)
+{
+    // the added ranges are copies of the source from elsewhere,
+    // the positions of the code are always in the original ranges
+    if (range.mAdded)
+    {
+        const auto sourceChunk = getStrFromSource(range.mStartPos, range.mEndPos);
+        const uint32_t sourceChunkLen = range.mEndPos - range.mStartPos;
 
-        if (isActionRequested(it.mSpecialAction, SpecialAction::PrependNewline))
+        // no special actions for the first range
+        if ((isFirst == false) && isActionRequested(range.mSpecialAction, SpecialAction::PrependNewline))
         {
             std::string s = "\r\n";
             writeChunkToOutputFile(s, s.size());
@@ -131,12 +195,40 @@ void WalkerSourceGen::generate()
 
         writeChunkToOutputFile(sourceChunk, sourceChunkLen);
 
-        if (isActionRequested(it.mSpecialAction, SpecialAction::AppendSemicolon))
+        if ((isFirst == false) && isActionRequested(range.mSpecialAction, SpecialAction::AppendSemicolon))
         {
             std::string s = ";";
             writeChunkToOutputFile(s, s.size());
         }
+
+        return;
     }
+
+    // split the range on each code position inside of it, the code
+    // placed in a removed range goes just before the next written one
+    uint32_t chunkStartPos = range.mStartPos;
+    while ((nextCodeInsertion < mCodeInsertions.size()) && //
+           (mCodeInsertions[nextCodeInsertion].mPos < range.mEndPos))
+    {
+        const auto &codeInsertion = mCodeInsertions[nextCodeInsertion];
+        const uint32_t chunkEndPos = std::max(codeInsertion.mPos, chunkStartPos);
+
+        const auto sourceChunk = getStrFromSource(chunkStartPos, chunkEndPos);
+        writeChunkToOutputFile(sourceChunk, chunkEndPos - chunkStartPos);
+        writeChunkToOutputFile(codeInsertion.mCode, codeInsertion.mCode.size());
+
+        chunkStartPos = chunkEndPos;
+        nextCodeInsertion++;
+    }
+
+    const auto sourceChunk = getStrFromSource(chunkStartPos, range.mEndPos);
+    writeChunkToOutputFile(sourceChunk, range.mEndPos - chunkStartPos);
+}
+
+void WalkerSourceGen::prepareRanges()
+{
+    squashRanges();
+    applyNodeRemoves();
 }
 
 std::string WalkerSourceGen::getStrFromSource( //
@@ -163,7 +255,7 @@ std::string WalkerSourceGen::getStrFromSource( //
     const int32_t nodeStringLen = endPos - startPos;
 
     std::string buffer;
-    buffer.reserve(nodeStringLen + 1);
+    buffer.resize(nodeStringLen);
 
     const int freadRes = fread(buffer.data(), 1, nodeStringLen, mSourceFileFp);
     if (freadRes != nodeStringLen)
@@ -352,6 +444,7 @@ void WalkerSourceGen::applyNodeRemoves()
                         // whole range removed
                         shouldAdvance = false;
                         mSourceRanges.erase(mSourceRanges.begin() + sourceRangeIdx);
+                        break;
                     }
                     else
                     {
@@ -364,15 +457,16 @@ void WalkerSourceGen::applyNodeRemoves()
                         // remove the range from current
                         sourceRange.mEndPos = removedRange.mStartPos;
 
-                        // insert new range only if size non-zero
+                        // insert new range (after the current one) only if size non-zero
                         if (newRange.mStartPos != newRange.mEndPos)
                         {
-                            mSourceRanges.insert(mSourceRanges.begin() + sourceRangeIdx, newRange);
+                            mSourceRanges.insert(mSourceRanges.begin() + sourceRangeIdx + 1, newRange);
                         }
 
-                        // restart since we modified the currently iterated vector...
+                        // check the rest of the current range again, the vector was modified
+                        // (the ranges before it have nothing left to remove)
                         shouldAdvance = false;
-                        sourceRangeIdx = 0;
+                        break;
                     }
                 }
                 else if ((sourceRange.mStartPos >= removedRange.mStartPos) && //
@@ -388,7 +482,6 @@ void WalkerSourceGen::applyNodeRemoves()
                     // whole current range fits into removed range
                     mSourceRanges.erase(mSourceRanges.begin() + sourceRangeIdx);
                     shouldAdvance = false;
-                    sourceRangeIdx = 0;
                     break;
                 }
             }
@@ -3,12 +3,17 @@
 #include "WalkerStrategy.hpp"
 
 #include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace fs = std::filesystem;
 
 namespace safec
 {
 
+class SemNodeFlat;
+
 enum class SpecialAction : uint32_t
 {
     Nothing = 0,
@@ -30,9 +35,18 @@ public:
 
     void peek(SemNode &node, const uint32_t astLevel) override;
     void peek(SemNodeTranslationUnit &node, const uint32_t astLevel) override;
+    void peek(SemNodeGeneratedCode &node, const uint32_t astLevel) override;
+
+    // gathers the ranges from a flat AST instead of walking the nodes,
+    // same result as walking the AST the flat copy was made from
+    void collect(const SemNodeFlat &ast);
 
     void generate();
 
+    // squashes the gathered ranges and cuts out the removed nodes,
+    // first step of generate(), exposed so it can be measured alone
+    void prepareRanges();
+
 private:
     struct SourceRange
     {
@@ -44,11 +58,17 @@ private:
 
         uint32_t mStartPos;
         uint32_t mEndPos;
-        std::string mNodeType;
+        std::string_view mNodeType; // static type name, see SemNode::typeToStr()
         SpecialAction mSpecialAction;
         bool mAdded;
     };
 
+    struct CodeInsertion
+    {
+        uint32_t mPos;
+        std::string mCode;
+    };
+
     [[maybe_unused]] const fs::path &mOutputFile;
     FILE *mOutputFileFp;
 
@@ -57,6 +77,20 @@ private:
 
     std::vector<SourceRange> mSourceRanges;
     std::vector<SourceRange> mRemovedRanges;
+    std::vector<CodeInsertion> mCodeInsertions;
+
+    void openSourceFile(const fs::path &sourceFile);
+
+    void addRange( //
+        const uint32_t startPos,
+        const uint32_t endPos,
+        const SemNode::Type type,
+        const SemNode::DirtyType dirty);
+
+    void addCode(const uint32_t pos, const std::string &code);
+
+    // writes the source range, with the code inserted in it (if any)
+    void writeRange(const SourceRange &range, const bool isFirst, size_t &nextCodeInsertion);
 
     std::string getStrFromSource( //
         const uint32_t startPos,
@@ -0,0 +1,184 @@
+#include "WalkerStaticAssert.hpp"
+
+#include "ConstantEvaluation.hpp"
+#include "SourceText.hpp"
+#include "logger/Logger.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+
+using namespace safec;
+using namespace safec::source;
+
+namespace
+{
+
+constexpr std::string_view kKeyword = "static_assert";
+constexpr std::string_view kTypedefPrefix = "safec_static_assert_";
+
+} // namespace
+
+WalkerStaticAssert::WalkerStaticAssert()
+    : mTranslationUnit{nullptr}
+{
+}
+
+bool WalkerStaticAssert::commit(SemNodeTranslationUnit &translationUnit)
+{
+    mTranslationUnit = &translationUnit;
+    mSource = readSourceFile(translationUnit.getSourcePath());
+    const constants::MacroConstants macros{mSource};
+
+    // the code is attached to the nodes below, collect them first
+    std::vector<SemNodeStaticAssert *> staticAsserts;
+    collect(translationUnit, staticAsserts);
+
+    for (auto *it : staticAsserts)
+    {
+        const auto cond = it->getCond();
+        assert(cond);
+
+        // in a conditional block the assertion may not be compiled at
+        // all (the source is not preprocessed), the compiler checks it
+        std::string error;
+        const auto symbols = macros.getSymbols(it->getPos());
+        const auto value =
+            macros.isConditional(it->getPos()) ? std::nullopt : constants::evaluate(*cond, error, &symbols);
+        if (value.has_value() == false)
+        {
+            const auto condSource = getCondSource(*it);
+            if (condSource.has_value() == false)
+            {
+                log("ERROR: line %: can not find the static assertion condition", //
+                    Color::Red,
+                    getLine(it->getPos()));
+                mReport.mFailed++;
+                continue;
+            }
+
+            leaveToCompiler(*it, *condSource);
+            mReport.mUnproven++;
+        }
+        else if (value->mValue != 0)
+        {
+            remove(*it);
+            mReport.mProven++;
+        }
+        else
+        {
+            const std::string message = it->getMessage().empty() ? getCondSource(*it).value_or("") : it->getMessage();
+            log("ERROR: line %: static assertion failed: %", Color::Red, getLine(it->getPos()), message);
+            mReport.mFailed++;
+        }
+    }
+
+    return (mReport.mFailed == 0);
+}
+
+const WalkerStaticAssert::Report &WalkerStaticAssert::getReport() const
+{
+    return mReport;
+}
+
+void WalkerStaticAssert::collect(SemNode &node, std::vector<SemNodeStaticAssert *> &staticAsserts) const
+{
+    if (node.getType() == SemNode::Type::StaticAssert)
+    {
+        staticAsserts.push_back(static_cast<SemNodeStaticAssert *>(&node));
+        return;
+    }
+
+    for (const auto &it : node.getAttachedNodes())
+    {
+        collect(*it, staticAsserts);
+    }
+}
+
+void WalkerStaticAssert::remove(SemNodeStaticAssert &node) const
+{
+    // an assertion on its own line goes with the line
+    uint32_t start = node.getPos();
+    const auto indent = getLineIndent(mSource, start);
+    if (indent.has_value())
+    {
+        start -= static_cast<uint32_t>(indent->size());
+        start -= (start > node.getSemStart()) ? 1U : 0U;
+    }
+
+    replaceSource(node, start, "");
+}
+
+void WalkerStaticAssert::leaveToCompiler(SemNodeStaticAssert &node, const std::string &cond) const
+{
+    // the array size is negative if the condition does not hold, a declaration
+    // like the assertion - it is parsed as one, before the block statements
+    const std::string code = "typedef char " + std::string{kTypedefPrefix} + std::to_string(node.getId()) + "[(" +
+                             cond + ") ? 1 : -1];";
+
+    replaceSource(node, node.getPos(), code);
+}
+
+void WalkerStaticAssert::replaceSource(SemNodeStaticAssert &node, const uint32_t start, const std::string &code) const
+{
+    // the range of the node starts where the previous statement ended, only
+    // the assertion is replaced, the comments and preprocessor lines stay
+    auto generatedCode = std::make_shared<SemNodeGeneratedCode>(start, code);
+    generatedCode->setSemStart(start);
+    generatedCode->setSemEnd(node.getSemEnd());
+    generatedCode->setDirty(SemNode::DirtyType::Removed);
+    node.attach(generatedCode);
+    mTranslationUnit->registerNode(generatedCode);
+
+    node.getParent()->setDirty(SemNode::DirtyType::Modified);
+    node.setDirty(SemNode::DirtyType::Modified);
+}
+
+std::optional<std::string> WalkerStaticAssert::getCondSource(const SemNodeStaticAssert &node) const
+{
+    const size_t keywordStart = node.getPos();
+    if (mSource.compare(keywordStart, kKeyword.size(), kKeyword) != 0)
+    {
+        return std::nullopt;
+    }
+
+    const size_t open = skipBlank(mSource, keywordStart + kKeyword.size());
+    if ((open >= mSource.size()) || (mSource[open] != '('))
+    {
+        return std::nullopt;
+    }
+
+    uint32_t depth = 0;
+    for (size_t i = open + 1; i < mSource.size(); i++)
+    {
+        const char c = mSource[i];
+        if ((c == '"') || (c == '\''))
+        {
+            // skip the literal, the quote can be escaped
+            while ((++i < mSource.size()) && (mSource[i] != c))
+            {
+                i += (mSource[i] == '\\') ? 1U : 0U;
+            }
+        }
+        else if ((c == '(') || (c == '['))
+        {
+            depth++;
+        }
+        else if (((c == ')') || (c == ']')) && (depth > 0))
+        {
+            depth--;
+        }
+        else if (((c == ',') || (c == ')')) && (depth == 0))
+        {
+            return std::string{trim(std::string_view{mSource}.substr(open + 1, i - open - 1))};
+        }
+    }
+
+    return std::nullopt;
+}
+
+uint32_t WalkerStaticAssert::getLine(const uint32_t pos) const
+{
+    const size_t end = std::min(static_cast<size_t>(pos), mSource.size());
+    return static_cast<uint32_t>(std::count(mSource.begin(), mSource.begin() + end, '\n')) + 1U;
+}
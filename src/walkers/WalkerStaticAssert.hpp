@@ -0,0 +1,54 @@
+#pragma once
+
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace safec
+{
+
+// Evaluates the "static_assert" declarations with the constant expression
+// evaluator (see ConstantEvaluation). The assertions that hold are dropped
+// from the output, a failed one is an error. The conditions not known here
+// ("sizeof", enumerators) are left to the compiler as a negative array size.
+// The source is not preprocessed, the macros are known as described in
+// constants::MacroConstants.
+class WalkerStaticAssert final
+{
+public:
+    struct Report
+    {
+        uint32_t mProven = 0;   // assertions that hold, not emitted
+        uint32_t mUnproven = 0; // assertions left to the compiler
+        uint32_t mFailed = 0;   // assertions that do not hold
+    };
+
+    WalkerStaticAssert();
+
+    // false if an assertion does not hold
+    bool commit(SemNodeTranslationUnit &translationUnit);
+
+    const Report &getReport() const;
+
+private:
+    SemNodeTranslationUnit *mTranslationUnit;
+    std::string mSource;
+    Report mReport;
+
+    void collect(SemNode &node, std::vector<SemNodeStaticAssert *> &staticAsserts) const;
+
+    void remove(SemNodeStaticAssert &node) const;
+    void leaveToCompiler(SemNodeStaticAssert &node, const std::string &cond) const;
+    void replaceSource(SemNodeStaticAssert &node, const uint32_t start, const std::string &code) const;
+
+    // the condition as written in the source, between the "(" and
+    // the "," before the message or the closing ")"
+    std::optional<std::string> getCondSource(const SemNodeStaticAssert &node) const;
+
+    uint32_t getLine(const uint32_t pos) const;
+};
+
+} // namespace safec
@@ -0,0 +1,281 @@
+#include "WalkerSwitchSort.hpp"
+
+#include "SourceText.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+using namespace safec;
+using namespace safec::source;
+
+namespace
+{
+
+// changed by the passes before, the source does not match the AST
+bool hasChanges(const SemNode &node)
+{
+    if ((node.getDirty() != SemNode::DirtyType::Clean) || (node.getType() == SemNode::Type::GeneratedCode))
+    {
+        return true;
+    }
+
+    const auto &children = node.getAttachedNodes();
+    return std::any_of(children.begin(), children.end(), [](const auto &it) { return hasChanges(*it); });
+}
+
+} // namespace
+
+WalkerSwitchSort::WalkerSwitchSort()
+    : mTranslationUnit{nullptr}
+{
+}
+
+void WalkerSwitchSort::commit(SemNodeTranslationUnit &translationUnit)
+{
+    mTranslationUnit = &translationUnit;
+    mSource = readSourceFile(translationUnit.getSourcePath());
+    const constants::MacroConstants macros{mSource};
+
+    // the code is attached to the nodes below, collect them first
+    std::vector<SemNodeSwitchCase *> switches;
+    collect(translationUnit, switches);
+
+    for (auto *it : switches)
+    {
+        sort(*it, macros);
+    }
+}
+
+const WalkerSwitchSort::Report &WalkerSwitchSort::getReport() const
+{
+    return mReport;
+}
+
+bool WalkerSwitchSort::isDense(const Switch &info)
+{
+    const uint64_t range = static_cast<uint64_t>(info.mMax - info.mMin) + 1U;
+    return (range <= (2U * static_cast<uint64_t>(info.mCases)));
+}
+
+void WalkerSwitchSort::collect(SemNode &node, std::vector<SemNodeSwitchCase *> &switches) const
+{
+    for (const auto &it : node.getAttachedNodes())
+    {
+        collect(*it, switches);
+    }
+
+    // a switch sorted here is a change in the switches around it
+    if (node.getType() == SemNode::Type::SwitchCase)
+    {
+        switches.push_back(static_cast<SemNodeSwitchCase *>(&node));
+    }
+}
+
+void WalkerSwitchSort::sort(SemNodeSwitchCase &node, const constants::MacroConstants &macros)
+{
+    // the body is the last node, after the switch expression
+    const auto &children = node.getAttachedNodes();
+    if (hasChanges(node) || children.empty() || (children.back()->getType() != SemNode::Type::Scope))
+    {
+        mReport.mSkipped++;
+        return;
+    }
+
+    SemNode &body = *children.back();
+
+    std::vector<Block> blocks;
+    std::vector<int64_t> values;
+    if (getBlocks(body, macros.getSymbols(node.getSemStart()), blocks, values) == false)
+    {
+        mReport.mSkipped++;
+        return;
+    }
+
+    // stable, the duplicate labels are an error left to the compiler
+    std::vector<size_t> order(blocks.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&blocks](const size_t lhs, const size_t rhs) {
+        // a block with "default" goes last, whatever its other labels
+        if (blocks[lhs].mHasDefault || blocks[rhs].mHasDefault)
+        {
+            return (blocks[lhs].mHasDefault == false) && blocks[rhs].mHasDefault;
+        }
+
+        return (*blocks[lhs].mKey < *blocks[rhs].mKey);
+    });
+
+    // the last block can fall out of the switch, if it stays the last one
+    if ((blocks.back().mLeaves == false) && (order.back() != (blocks.size() - 1U)))
+    {
+        mReport.mSkipped++;
+        return;
+    }
+
+    const auto minMax = std::minmax_element(values.begin(), values.end());
+    Switch info{getLine(skipBlank(mSource, node.getSemStart())),
+                static_cast<uint32_t>(values.size()),
+                values.empty() ? 0 : *minMax.first,
+                values.empty() ? 0 : *minMax.second,
+                false};
+
+    if (std::is_sorted(order.begin(), order.end()))
+    {
+        mReport.mInOrder++;
+        mReport.mSwitches.push_back(info);
+        return;
+    }
+
+    std::string code;
+    for (const size_t it : order)
+    {
+        code += mSource.substr(blocks[it].mStart, blocks[it].mEnd - blocks[it].mStart);
+    }
+
+    // the blocks are moved as a whole, the AST keeps the source order
+    const uint32_t start = blocks.front().mStart;
+    auto generatedCode = std::make_shared<SemNodeGeneratedCode>(start, code);
+    generatedCode->setSemStart(start);
+    generatedCode->setSemEnd(blocks.back().mEnd);
+    generatedCode->setDirty(SemNode::DirtyType::Removed);
+    body.attach(generatedCode);
+    mTranslationUnit->registerNode(generatedCode);
+
+    body.setDirty(SemNode::DirtyType::Modified);
+    node.setDirty(SemNode::DirtyType::Modified);
+
+    info.mReordered = true;
+    mReport.mSorted++;
+    mReport.mSwitches.push_back(info);
+}
+
+bool WalkerSwitchSort::getBlocks( //
+    const SemNode &body,
+    const constants::Symbols &symbols,
+    std::vector<Block> &blocks,
+    std::vector<int64_t> &values) const
+{
+    const SemNode *last = nullptr;
+    uint32_t prevEnd = 0;
+    for (const auto &it : body.getAttachedNodes())
+    {
+        const SemNode &statement = *it;
+
+        // the text between the nodes is not emitted, nothing to move
+        if ((blocks.empty() == false) && (statement.getSemStart() != prevEnd))
+        {
+            return false;
+        }
+
+        prevEnd = statement.getSemEnd();
+
+        if (statement.getType() != SemNode::Type::SwitchCaseLabel)
+        {
+            // the statements before the first label can not be reached
+            if (blocks.empty())
+            {
+                return false;
+            }
+
+            blocks.back().mEnd = statement.getSemEnd();
+            last = &statement;
+            continue;
+        }
+
+        // a label after the statements starts the next block, the
+        // stacked labels (with no statement) share one
+        if (blocks.empty() || (last != nullptr))
+        {
+            // a block falling through to the next one has to stay before it
+            if ((blocks.empty() == false) && (leaves(*last) == false))
+            {
+                return false;
+            }
+
+            blocks.push_back(Block{});
+            blocks.back().mStart = statement.getSemStart();
+            last = nullptr;
+        }
+
+        Block &block = blocks.back();
+        block.mEnd = statement.getSemEnd();
+
+        const auto &label = static_cast<const SemNodeSwitchCaseLabel &>(statement);
+        const auto caseLabel = label.getCaseLabel();
+        assert(caseLabel);
+
+        // "default" has an empty statement as the label
+        if (caseLabel->getType() != SemNode::Type::EmptyStatement)
+        {
+            std::string error;
+            const auto value = constants::evaluate(*caseLabel, error, &symbols);
+            if (value.has_value() == false)
+            {
+                return false;
+            }
+
+            if ((block.mKey.has_value() == false) || (value->mValue < *block.mKey))
+            {
+                block.mKey = value->mValue;
+            }
+
+            values.push_back(value->mValue);
+        }
+        else
+        {
+            block.mHasDefault = true;
+        }
+
+        // the first statement is the child of the label
+        const auto &labelChildren = label.getAttachedNodes();
+        if (labelChildren.size() > 1U)
+        {
+            last = labelChildren.back().get();
+        }
+    }
+
+    if (blocks.empty())
+    {
+        return false;
+    }
+
+    blocks.back().mLeaves = (last != nullptr) && leaves(*last);
+
+    // the blocks are moved as written, a conditional line would move as well
+    return std::none_of(blocks.begin(), blocks.end(), [this](const Block &it) {
+        return hasPreprocessorLine(std::string_view{mSource}.substr(it.mStart, it.mEnd - it.mStart));
+    });
+}
+
+bool WalkerSwitchSort::leaves(const SemNode &node) const
+{
+    switch (node.getType())
+    {
+        case SemNode::Type::Return:
+            return true;
+
+        case SemNode::Type::JumpStatement:
+        {
+            const std::string name = static_cast<const SemNodeJumpStatement &>(node).getName();
+            return (name == "break") || (name == "continue");
+        }
+
+        // a plain block, a break in it still targets this switch
+        case SemNode::Type::Scope:
+        {
+            const auto &children = node.getAttachedNodes();
+            return (children.empty() == false) && leaves(*children.back());
+        }
+
+        // not followed into the loops (also do-while) and the nested switches,
+        // their break does not leave this switch
+        default:
+            return false;
+    }
+}
+
+uint32_t WalkerSwitchSort::getLine(const size_t pos) const
+{
+    const size_t end = std::min(pos, mSource.size());
+    return static_cast<uint32_t>(std::count(mSource.begin(), mSource.begin() + end, '\n')) + 1U;
+}
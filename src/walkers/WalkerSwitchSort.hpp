@@ -0,0 +1,84 @@
+#pragma once
+
+#include "ConstantEvaluation.hpp"
+#include "semantic_nodes/SemNode.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace safec
+{
+
+// Orders the case blocks of a switch by their constant labels, ascending,
+// with "default" last - some compilers build a jump table only for sorted
+// labels. A block is reordered with its stacked labels and is moved as
+// written in the source. Only the switches with every block leaving the
+// switch (no fallthrough) and every label known here are sorted, the
+// source is not preprocessed, the macros are known as described in
+// constants::MacroConstants. The switches changed by the other passes
+// and the blocks with a preprocessor line are left as they are.
+class WalkerSwitchSort final
+{
+public:
+    // a switch with all labels known
+    struct Switch
+    {
+        uint32_t mLine;
+        uint32_t mCases; // labels, without "default"
+        int64_t mMin;
+        int64_t mMax;
+        bool mReordered;
+    };
+
+    struct Report
+    {
+        uint32_t mSorted = 0;  // switches reordered here
+        uint32_t mInOrder = 0; // switches already sorted
+        uint32_t mSkipped = 0; // switches with a fallthrough, unknown labels, ...
+        std::vector<Switch> mSwitches;
+    };
+
+    WalkerSwitchSort();
+
+    void commit(SemNodeTranslationUnit &translationUnit);
+
+    const Report &getReport() const;
+
+    // at least half of the values in the labels range have a case
+    static bool isDense(const Switch &info);
+
+private:
+    // the labels stacked over the statements up to the next label
+    struct Block
+    {
+        uint32_t mStart = 0;
+        uint32_t mEnd = 0;
+        std::optional<int64_t> mKey; // smallest label
+        bool mHasDefault = false;
+        bool mLeaves = true; // the other blocks do, see getBlocks
+    };
+
+    SemNodeTranslationUnit *mTranslationUnit;
+    std::string mSource;
+    Report mReport;
+
+    // the nested switches first
+    void collect(SemNode &node, std::vector<SemNodeSwitchCase *> &switches) const;
+
+    void sort(SemNodeSwitchCase &node, const constants::MacroConstants &macros);
+
+    // false if the switch can not be sorted
+    bool getBlocks(const SemNode &body,
+                   const constants::Symbols &symbols,
+                   std::vector<Block> &blocks,
+                   std::vector<int64_t> &values) const;
+
+    // true if the end of the node can not be reached from its start
+    bool leaves(const SemNode &node) const;
+
+    uint32_t getLine(const size_t pos) const;
+};
+
+} // namespace safec